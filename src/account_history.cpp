@@ -0,0 +1,107 @@
+#include "account_history.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+size_t AccountHistory::KeyHash::operator()(const Key& key) const {
+    // Account ids are uniformly distributed already.
+    uint64_t h = 0;
+    memcpy(&h, key.data(), sizeof(h));
+    return static_cast<size_t>(h);
+}
+
+AccountHistory::Key AccountHistory::makeKey(const FfiBytes32& id) {
+    Key key{};
+    memcpy(key.data(), id.data, 32);
+    return key;
+}
+
+void AccountHistory::setEnabled(const bool enabled) {
+    on = enabled;
+}
+
+void AccountHistory::recordSubmission(
+        const std::string& method,
+        const std::vector<FfiBytes32>& accounts,
+        const uint8_t* amount,
+        const FfiBytes32& txHash,
+        const uint64_t block,
+        const int64_t timeMs
+) {
+    std::lock_guard lock(mutex);
+    if (!on)
+        return;
+    Record record;
+    record.kind = Kind::Submission;
+    record.block = block;
+    record.timeMs = timeMs;
+    record.method = &*methods.insert(method).first;
+    record.hasAmount = amount != nullptr;
+    if (amount)
+        memcpy(record.amount.data(), amount, 16);
+    record.txHash = txHash;
+
+    // One id for the transaction, listed once under each distinct account.
+    record.id = nextId++;
+    std::vector<Key> seen;
+    for (const FfiBytes32& account : accounts) {
+        const Key key = makeKey(account);
+        if (std::find(seen.begin(), seen.end(), key) != seen.end())
+            continue;
+        seen.push_back(key);
+        appendLocked(key, record);
+    }
+}
+
+void AccountHistory::recordChange(
+        const FfiBytes32& account,
+        const uint64_t block,
+        const std::array<uint8_t, 16>& previousBalance,
+        const std::array<uint8_t, 16>& balance,
+        const std::array<uint8_t, 16>& nonce
+) {
+    std::lock_guard lock(mutex);
+    if (!on)
+        return;
+    Record record;
+    record.id = nextId++;
+    record.kind = Kind::BalanceChange;
+    record.block = block;
+    record.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    record.previousBalance = previousBalance;
+    record.balance = balance;
+    record.nonce = nonce;
+    appendLocked(makeKey(account), record);
+}
+
+AccountHistory::Page AccountHistory::query(const FfiBytes32& account, const uint64_t cursor, const size_t limit) const {
+    std::lock_guard lock(mutex);
+    Page page;
+    const auto it = records.find(makeKey(account));
+    if (it == records.end())
+        return page;
+
+    const std::deque<Record>& list = it->second;
+    auto end = list.end();
+    if (cursor != 0)
+        end = std::lower_bound(list.begin(), list.end(), cursor, [](const Record& record, const uint64_t id) { return record.id < id; });
+    auto begin = end - static_cast<std::ptrdiff_t>(std::min<size_t>(limit, end - list.begin()));
+    page.records.assign(std::make_reverse_iterator(end), std::make_reverse_iterator(begin));
+    if (begin != list.begin() && !page.records.empty())
+        page.nextCursor = page.records.back().id;
+    return page;
+}
+
+void AccountHistory::clear() {
+    std::lock_guard lock(mutex);
+    records.clear();
+}
+
+void AccountHistory::appendLocked(const Key& account, Record record) {
+    std::deque<Record>& list = records[account];
+    list.push_back(std::move(record));
+    if (list.size() > MaxRecordsPerAccount)
+        list.pop_front();
+}
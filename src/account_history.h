@@ -0,0 +1,89 @@
+#ifndef ACCOUNT_HISTORY_H
+#define ACCOUNT_HISTORY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Per-account activity index, newest first, paged with a cursor. Two sources feed it: the
+// transactions the module submits (one record under every account involved) and the balance
+// / nonce changes the BalanceTracker finds across syncs.
+//
+// Records are fixed-size and ids grow monotonically across accounts, so a cursor is just the
+// id of the last record a page returned: the next page starts with a binary search in that
+// account's records and costs O(log n + page) whatever the total activity. Each account
+// keeps its newest MaxRecordsPerAccount records.
+class AccountHistory {
+public:
+    static constexpr size_t MaxRecordsPerAccount = 4096;
+
+    enum class Kind : uint8_t { Submission, BalanceChange };
+
+    struct Record {
+        uint64_t id = 0;
+        Kind kind = Kind::Submission;
+        // Last synced block at submission, or the block synced to for a change.
+        uint64_t block = 0;
+        // Milliseconds since the Unix epoch.
+        int64_t timeMs = 0;
+        // Submission: interned method name, amount if any and tx hash.
+        const std::string* method = nullptr;
+        bool hasAmount = false;
+        std::array<uint8_t, 16> amount{};
+        FfiBytes32 txHash{};
+        // Change: balance before and after, nonce after.
+        std::array<uint8_t, 16> previousBalance{};
+        std::array<uint8_t, 16> balance{};
+        std::array<uint8_t, 16> nonce{};
+    };
+
+    struct Page {
+        std::vector<Record> records;
+        // Cursor for the next (older) page; 0 when this page reached the oldest record.
+        uint64_t nextCursor = 0;
+    };
+
+    // Off by default; while off nothing is recorded.
+    void setEnabled(bool enabled);
+    bool enabled() const { return on; }
+
+    void recordSubmission(const std::string& method, const std::vector<FfiBytes32>& accounts, const uint8_t* amount, const FfiBytes32& txHash, uint64_t block, int64_t timeMs);
+
+    void recordChange(const FfiBytes32& account, uint64_t block, const std::array<uint8_t, 16>& previousBalance, const std::array<uint8_t, 16>& balance, const std::array<uint8_t, 16>& nonce);
+
+    // Records of `account` older than `cursor` (0: from the newest), at most `limit`.
+    Page query(const FfiBytes32& account, uint64_t cursor, size_t limit) const;
+
+    // Forgets every record. Ids keep growing, so old cursors stay harmless.
+    void clear();
+
+private:
+    using Key = std::array<uint8_t, 32>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key makeKey(const FfiBytes32& id);
+    void appendLocked(const Key& account, Record record);
+
+    std::atomic<bool> on{false};
+    mutable std::mutex mutex;
+    uint64_t nextId = 1;
+    std::unordered_map<Key, std::deque<Record>, KeyHash> records;
+    // Never cleared: records handed out keep pointing into it.
+    std::unordered_set<std::string> methods;
+};
+
+#endif // ACCOUNT_HISTORY_H
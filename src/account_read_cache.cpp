@@ -0,0 +1,67 @@
+#include "account_read_cache.h"
+
+#include <cstring>
+
+size_t AccountReadCache::KeyHash::operator()(const Key& key) const {
+    // Account ids are hashes already; the first 8 bytes are as good a hash as any.
+    uint64_t h = 0;
+    memcpy(&h, key.id.data(), sizeof(h));
+    return static_cast<size_t>(h ^ static_cast<uint64_t>(key.isPrivate));
+}
+
+AccountReadCache::Key AccountReadCache::makeKey(const FfiBytes32& id, const bool isPrivate) {
+    Key key{};
+    memcpy(key.id.data(), id.data, 32);
+    key.isPrivate = isPrivate;
+    return key;
+}
+
+std::optional<std::string>& AccountReadCache::slot(Entry& entry, const Field field) {
+    switch (field) {
+    case Field::Balance:
+        return entry.balance;
+    case Field::Account:
+        return entry.account;
+    case Field::BalanceLe16:
+        return entry.balanceLe16;
+    case Field::AccountRecord:
+        return entry.accountRecord;
+    case Field::VaultBalance:
+    default:
+        return entry.vaultBalance;
+    }
+}
+
+std::optional<std::string> AccountReadCache::get(const FfiBytes32& id, const bool isPrivate, const Field field) const {
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(makeKey(id, isPrivate));
+    if (it == entries.end())
+        return std::nullopt;
+    return slot(const_cast<Entry&>(it->second), field);
+}
+
+void AccountReadCache::put(const FfiBytes32& id, const bool isPrivate, const Field field, const std::string& value) {
+    std::lock_guard lock(mutex);
+    const Key key = makeKey(id, isPrivate);
+    if (entries.size() >= MaxEntries && entries.find(key) == entries.end())
+        entries.clear();
+    slot(entries[key], field) = value;
+}
+
+void AccountReadCache::invalidate(const FfiBytes32& id) {
+    std::lock_guard lock(mutex);
+    entries.erase(makeKey(id, false));
+    entries.erase(makeKey(id, true));
+}
+
+void AccountReadCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+}
+
+void AccountReadCache::observeSyncedBlock(const uint64_t block) {
+    std::lock_guard lock(mutex);
+    if (syncedBlock && *syncedBlock != block)
+        entries.clear();
+    syncedBlock = block;
+}
@@ -0,0 +1,70 @@
+#ifndef ACCOUNT_READ_CACHE_H
+#define ACCOUNT_READ_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Module-level cache for the read-only account queries (balance, account record, vault
+// balance). Their answers can only change when the wallet syncs further or when this
+// module submits something touching the account, so entries stay valid until either:
+//   - the last-synced block moves (observeSyncedBlock / clear drop everything), or
+//   - a mutating call invalidates the accounts it touched (invalidate).
+// Only successful lookups are stored, as the already-formatted string returned to callers.
+class AccountReadCache {
+public:
+    // BalanceLe16 / AccountRecord hold the binary API's raw forms of Balance / Account.
+    enum class Field { Balance, Account, VaultBalance, BalanceLe16, AccountRecord };
+
+    // Upper bound on distinct (account id, privacy) keys; callers may query arbitrary ids,
+    // so the cache is simply dropped when it grows past this instead of tracking recency.
+    static constexpr size_t MaxEntries = 4096;
+
+    std::optional<std::string> get(const FfiBytes32& id, bool isPrivate, Field field) const;
+    void put(const FfiBytes32& id, bool isPrivate, Field field, const std::string& value);
+
+    // Drops both the public and private entries of `id`.
+    void invalidate(const FfiBytes32& id);
+    void clear();
+
+    // Records the wallet's last-synced block; a change from the previously observed
+    // value means every cached answer may be stale, so the cache is cleared.
+    void observeSyncedBlock(uint64_t block);
+
+private:
+    struct Key {
+        std::array<uint8_t, 32> id;
+        bool isPrivate;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::optional<std::string> balance;
+        std::optional<std::string> account;
+        std::optional<std::string> vaultBalance;
+        std::optional<std::string> balanceLe16;
+        std::optional<std::string> accountRecord;
+    };
+
+    static Key makeKey(const FfiBytes32& id, bool isPrivate);
+    static std::optional<std::string>& slot(Entry& entry, Field field);
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::optional<uint64_t> syncedBlock;
+};
+
+#endif // ACCOUNT_READ_CACHE_H
@@ -0,0 +1,121 @@
+#include "async_requests.h"
+
+namespace {
+
+thread_local bool inJob = false;
+
+} // namespace
+
+AsyncRequests::AsyncRequests(const size_t workerCount, const size_t maxFinished, const std::chrono::milliseconds finishedTtl)
+    : maxFinished(maxFinished), finishedTtl(finishedTtl), pool(workerCount) {}
+
+bool AsyncRequests::runningJob() {
+    return inJob;
+}
+
+int64_t AsyncRequests::submit(const std::string& method, std::function<std::string()> job) {
+    int64_t ticket = 0;
+    {
+        std::lock_guard lock(mutex);
+        ticket = nextTicket++;
+        requests[ticket].method = method;
+    }
+
+    const bool queued = pool.post([this, ticket, job = std::move(job)] {
+        inJob = true;
+        std::string result = job();
+        inJob = false;
+        {
+            std::lock_guard lock(mutex);
+            const auto it = requests.find(ticket);
+            if (it != requests.end()) {
+                it->second.done = true;
+                it->second.result = std::move(result);
+                const Clock::time_point now = Clock::now();
+                finished.push_back(Finished{ticket, now});
+                ++uncollected;
+                expireLocked(now);
+            }
+        }
+        completed.notify_all();
+    });
+
+    if (!queued) {
+        std::lock_guard lock(mutex);
+        requests.erase(ticket);
+        return 0;
+    }
+    return ticket;
+}
+
+AsyncRequests::Status AsyncRequests::takeLocked(const int64_t ticket) {
+    Status status;
+    const auto it = requests.find(ticket);
+    if (it == requests.end())
+        return status;
+
+    status.method = it->second.method;
+    if (!it->second.done) {
+        status.state = State::Pending;
+        return status;
+    }
+    status.state = State::Done;
+    status.result = std::move(it->second.result);
+    requests.erase(it);
+    --uncollected;
+    // Collected tickets linger in `finished` until reached; compact once they dominate it.
+    if (finished.size() > 2 * uncollected + 64) {
+        std::erase_if(finished, [this](const Finished& entry) { return !requests.contains(entry.ticket); });
+    }
+    return status;
+}
+
+// Drops the oldest uncollected results beyond maxFinished, and any older than finishedTtl.
+void AsyncRequests::expireLocked(const Clock::time_point now) {
+    while (!finished.empty()) {
+        const Finished& oldest = finished.front();
+        const auto it = requests.find(oldest.ticket);
+        if (it != requests.end()) {
+            if (uncollected <= maxFinished && now - oldest.at < finishedTtl)
+                break;
+            requests.erase(it);
+            --uncollected;
+        }
+        finished.pop_front();
+    }
+}
+
+AsyncRequests::Status AsyncRequests::poll(const int64_t ticket) {
+    std::lock_guard lock(mutex);
+    expireLocked(Clock::now());
+    return takeLocked(ticket);
+}
+
+AsyncRequests::Status AsyncRequests::await(const int64_t ticket, const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex);
+    completed.wait_for(lock, timeout, [this, ticket] {
+        const auto it = requests.find(ticket);
+        return it == requests.end() || it->second.done;
+    });
+    expireLocked(Clock::now());
+    return takeLocked(ticket);
+}
+
+size_t AsyncRequests::pendingCount() const {
+    std::lock_guard lock(mutex);
+    size_t pending = 0;
+    for (const auto& [ticket, request] : requests) {
+        if (!request.done)
+            ++pending;
+    }
+    return pending;
+}
+
+size_t AsyncRequests::finishedCount() const {
+    std::lock_guard lock(mutex);
+    return uncollected;
+}
+
+void AsyncRequests::shutdown() {
+    pool.shutdown();
+}
@@ -0,0 +1,88 @@
+#ifndef ASYNC_REQUESTS_H
+#define ASYNC_REQUESTS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "worker_pool.h"
+
+// Ticketed background execution for the blocking submission methods (transfers, claims,
+// bridge withdrawals). submit() hands the job to the module's worker pool and returns a
+// ticket immediately; the job's result string (the same JSON the synchronous method
+// returns) is then collected with poll() or await(). A finished result is handed out
+// once: the first poll/await that observes it releases the ticket.
+//
+// Tickets expire: a result nobody collects is kept for at most finishedTtl, and only the
+// newest maxFinished uncollected results are kept at all, so abandoned tickets cannot grow
+// the table without bound. An expired ticket reads back as Unknown, like a released one.
+class AsyncRequests {
+public:
+    enum class State { Unknown, Pending, Done };
+
+    static constexpr size_t MaxFinished = 4096;
+    static constexpr std::chrono::minutes FinishedTtl{10};
+
+    struct Status {
+        State state = State::Unknown;
+        std::string method;
+        std::string result;
+    };
+
+    // Defaults to one worker per hardware thread.
+    explicit AsyncRequests(size_t workerCount = std::thread::hardware_concurrency(), size_t maxFinished = MaxFinished,
+                           std::chrono::milliseconds finishedTtl = FinishedTtl);
+
+    // Returns 0 when the module is shutting down and no longer accepts work.
+    int64_t submit(const std::string& method, std::function<std::string()> job);
+
+    Status poll(int64_t ticket);
+    Status await(int64_t ticket, std::chrono::milliseconds timeout);
+
+    size_t pendingCount() const;
+    // Results finished but not collected yet.
+    size_t finishedCount() const;
+
+    // True on a worker thread while it runs a submitted job.
+    static bool runningJob();
+
+    // Finishes every submitted job and stops the workers.
+    void shutdown();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        std::string method;
+        bool done = false;
+        std::string result;
+    };
+
+    struct Finished {
+        int64_t ticket = 0;
+        Clock::time_point at;
+    };
+
+    Status takeLocked(int64_t ticket);
+    void expireLocked(Clock::time_point now);
+
+    mutable std::mutex mutex;
+    std::condition_variable completed;
+    std::unordered_map<int64_t, Request> requests;
+    // Completion order; may still list tickets collected since, which expireLocked skips.
+    std::deque<Finished> finished;
+    size_t uncollected = 0;
+    const size_t maxFinished;
+    const std::chrono::milliseconds finishedTtl;
+    int64_t nextTicket = 1;
+    WorkerPool pool;
+};
+
+#endif // ASYNC_REQUESTS_H
@@ -0,0 +1,113 @@
+#include "autosave.h"
+
+#include <algorithm>
+
+Autosave::Autosave(std::function<int()> save) : save(std::move(save)) {}
+
+Autosave::~Autosave() {
+    stop();
+}
+
+void Autosave::configure(const size_t maxMutations, const std::chrono::milliseconds maxDelay) {
+    {
+        std::lock_guard lock(mutex);
+        this->maxMutations = maxMutations;
+        this->maxDelay = std::max(maxDelay, std::chrono::milliseconds(0));
+        if (enabledLocked() && !stopping && !thread.joinable())
+            thread = std::thread([this] { run(); });
+    }
+    wake.notify_all();
+}
+
+void Autosave::markDirty() {
+    std::lock_guard lock(mutex);
+    const bool wasClean = dirtySequence == savedSequence;
+    if (wasClean)
+        firstUnsavedAt = Clock::now();
+    ++dirtySequence;
+    // The thread only needs waking to arm its timer or when the batch is full.
+    if (wasClean || (maxMutations > 0 && dirtySequence - savedSequence == maxMutations))
+        wake.notify_one();
+}
+
+int Autosave::flush(const bool force) {
+    std::lock_guard saveLock(saveMutex);
+    uint64_t target = 0;
+    {
+        std::lock_guard lock(mutex);
+        target = dirtySequence;
+        if (!force && target == savedSequence)
+            return 0;
+    }
+
+    const int error = save();
+
+    std::lock_guard lock(mutex);
+    if (error == 0) {
+        savedSequence = std::max(savedSequence, target);
+        ++saves;
+        // Whatever came in during the save is now the oldest unsaved change.
+        if (dirtySequence != savedSequence)
+            firstUnsavedAt = Clock::now();
+    } else {
+        ++saveFailures;
+        retryAt = Clock::now() + RetryDelay;
+    }
+    return error;
+}
+
+int Autosave::stop() {
+    bool enabled = false;
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        enabled = enabledLocked();
+    }
+    wake.notify_all();
+    if (thread.joinable())
+        thread.join();
+    return enabled ? flush() : 0;
+}
+
+nlohmann::json Autosave::snapshot() const {
+    std::lock_guard lock(mutex);
+    nlohmann::json result;
+    result["enabled"] = enabledLocked();
+    result["max_mutations"] = maxMutations;
+    result["max_delay_ms"] = maxDelay.count();
+    result["pending_mutations"] = dirtySequence - savedSequence;
+    result["mutations"] = dirtySequence;
+    result["saves"] = saves;
+    result["save_failures"] = saveFailures;
+    return result;
+}
+
+void Autosave::run() {
+    std::unique_lock lock(mutex);
+    while (!stopping) {
+        const uint64_t pending = dirtySequence - savedSequence;
+        if (!enabledLocked() || pending == 0) {
+            wake.wait(lock);
+            continue;
+        }
+        const Clock::time_point now = Clock::now();
+        if (now < retryAt) {
+            wake.wait_until(lock, retryAt);
+            continue;
+        }
+
+        const bool full = maxMutations > 0 && pending >= maxMutations;
+        const bool due = maxDelay.count() > 0 && now >= firstUnsavedAt + maxDelay;
+        if (!full && !due) {
+            if (maxDelay.count() > 0)
+                wake.wait_until(lock, firstUnsavedAt + maxDelay);
+            else
+                wake.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+// Coalesces wallet saves. Mutating calls only mark the wallet dirty; with autosave on, a
+// background thread saves once maxMutations changes have piled up or maxDelay has passed
+// since the first unsaved one, whichever comes first, so a burst of account creations or
+// transfers costs one wallet_ffi_save instead of one each. flush() is the barrier for
+// callers that need their changes on disk before going on.
+//
+// Changes are counted with a sequence number: a save covers every change marked before it
+// started, so concurrent flushes share one save and a change that lands mid-save is picked
+// up by the next.
+class Autosave {
+public:
+    // Failed background saves are retried after this long (or on the next flush()).
+    static constexpr std::chrono::milliseconds RetryDelay{1000};
+
+    // `save` performs one save, taking whatever locks it needs, and returns a
+    // WalletFfiError-style code, 0 on success.
+    explicit Autosave(std::function<int()> save);
+    ~Autosave();
+
+    Autosave(const Autosave&) = delete;
+    Autosave& operator=(const Autosave&) = delete;
+
+    // 0 disables that trigger; both 0 turns background saving off (the default). The thread
+    // is started the first time autosave is turned on.
+    void configure(size_t maxMutations, std::chrono::milliseconds maxDelay);
+
+    void markDirty();
+
+    // Saves everything marked dirty so far and returns the result; SUCCESS straight away if
+    // that is already on disk, unless `force`.
+    int flush(bool force = false);
+
+    // Stops the thread. If autosave is on and changes are pending, saves them one last time
+    // and returns that result. Idempotent.
+    int stop();
+
+    // { enabled, max_mutations, max_delay_ms, pending_mutations, mutations, saves,
+    //   save_failures }
+    nlohmann::json snapshot() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    bool enabledLocked() const { return maxMutations > 0 || maxDelay.count() > 0; }
+
+    const std::function<int()> save;
+    // Serialises saves so that each one knows which changes it covered.
+    std::mutex saveMutex;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    size_t maxMutations = 0;
+    std::chrono::milliseconds maxDelay{0};
+    uint64_t dirtySequence = 0;
+    uint64_t savedSequence = 0;
+    Clock::time_point firstUnsavedAt;
+    Clock::time_point retryAt;
+    uint64_t saves = 0;
+    uint64_t saveFailures = 0;
+    bool stopping = false;
+    std::thread thread;
+};
+
+#endif // AUTOSAVE_H
@@ -0,0 +1,57 @@
+#include "balance_tracker.h"
+
+#include <cstring>
+
+size_t BalanceTracker::KeyHash::operator()(const Key& key) const {
+    // Account ids are uniformly distributed already.
+    uint64_t h = 0;
+    memcpy(&h, key.data(), sizeof(h));
+    return static_cast<size_t>(h);
+}
+
+void BalanceTracker::setEvents(const bool enabled) {
+    events = enabled;
+}
+
+std::vector<BalanceTracker::Change> BalanceTracker::update(const std::vector<Account>& snapshot, const uint64_t block) {
+    std::lock_guard lock(mutex);
+    std::vector<Change> changes;
+    for (const Account& account : snapshot) {
+        Key key{};
+        memcpy(key.data(), account.id.data, 32);
+        const auto [it, first] = baseline.try_emplace(key, account);
+        if (first)
+            continue;
+        Account& previous = it->second;
+        if (previous.balance != account.balance || previous.nonce != account.nonce)
+            changes.push_back(Change{account.id, account.isPublic, previous.balance, account.balance, account.nonce});
+        previous = account;
+    }
+
+    if (events && !changes.empty()) {
+        log.push_back(Event{nextSequence++, block, changes});
+        while (log.size() > MaxEvents)
+            log.pop_front();
+    }
+    return changes;
+}
+
+bool BalanceTracker::hasBaseline() const {
+    std::lock_guard lock(mutex);
+    return !baseline.empty();
+}
+
+void BalanceTracker::reset() {
+    std::lock_guard lock(mutex);
+    baseline.clear();
+}
+
+std::vector<BalanceTracker::Event> BalanceTracker::eventsSince(const int64_t sequence) const {
+    std::lock_guard lock(mutex);
+    std::vector<Event> result;
+    for (const Event& event : log) {
+        if (event.sequence > sequence)
+            result.push_back(event);
+    }
+    return result;
+}
@@ -0,0 +1,77 @@
+#ifndef BALANCE_TRACKER_H
+#define BALANCE_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Balance / nonce snapshots of the wallet's accounts, taken around syncs. Each update()
+// compares a fresh snapshot with the previous one and returns only the accounts that moved;
+// with events on, every non-empty diff is also appended to a bounded log that callers read
+// with a sequence cursor, so they learn what a sync changed without polling every account.
+//
+// An account seen for the first time only joins the baseline, and accounts missing from a
+// snapshot keep their last values.
+class BalanceTracker {
+public:
+    static constexpr size_t MaxEvents = 1024;
+
+    struct Account {
+        FfiBytes32 id{};
+        bool isPublic = false;
+        std::array<uint8_t, 16> balance{};
+        std::array<uint8_t, 16> nonce{};
+    };
+
+    struct Change {
+        FfiBytes32 id{};
+        bool isPublic = false;
+        std::array<uint8_t, 16> previousBalance{};
+        std::array<uint8_t, 16> balance{};
+        std::array<uint8_t, 16> nonce{};
+    };
+
+    struct Event {
+        int64_t sequence = 0;
+        uint64_t block = 0;
+        std::vector<Change> changes;
+    };
+
+    // Off by default: diffs are still computed for other consumers, just not logged.
+    void setEvents(bool enabled);
+    bool eventsEnabled() const { return events; }
+
+    // Replaces the baseline with `snapshot`, taken after syncing to `block`, and returns what
+    // changed.
+    std::vector<Change> update(const std::vector<Account>& snapshot, uint64_t block);
+    bool hasBaseline() const;
+    // Forgets the baseline (another wallet, or nobody tracking any more); the log stays.
+    void reset();
+
+    // Logged diffs newer than `sequence`, oldest first.
+    std::vector<Event> eventsSince(int64_t sequence) const;
+
+private:
+    using Key = std::array<uint8_t, 32>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    std::atomic<bool> events{false};
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Account, KeyHash> baseline;
+    std::deque<Event> log;
+    int64_t nextSequence = 1;
+};
+
+#endif // BALANCE_TRACKER_H
@@ -0,0 +1,100 @@
+#include "builtin_elfs.h"
+
+#include <cstdio>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr const char* PROGRAM_NAMES[BuiltinElfs::ProgramCount] = {"authenticated_transfer", "token", "amm", "ata"};
+
+#ifdef __linux__
+// Writes `elf` into a new memfd and seals it against any further change.
+int createSealedDescriptor(const char* name, const FfiProgram& elf) {
+    const int fd = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+        return -1;
+
+    size_t written = 0;
+    while (written < elf.elf_size) {
+        const ssize_t n = write(fd, elf.elf_data + written, elf.elf_size - written);
+        if (n <= 0) {
+            close(fd);
+            return -1;
+        }
+        written += static_cast<size_t>(n);
+    }
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+#endif
+
+} // namespace
+
+BuiltinElfs::BuiltinElfs(Fetch fetch) : fetch(std::move(fetch)) {}
+
+BuiltinElfs::~BuiltinElfs() {
+#ifdef __linux__
+    for (Slot& slot : slots) {
+        if (slot.descriptor >= 0)
+            close(slot.descriptor);
+    }
+#endif
+}
+
+BuiltinElfs::Elf BuiltinElfs::get(const Program program) {
+    Slot& slot = slots[static_cast<size_t>(program)];
+    std::lock_guard lock(slot.mutex);
+    if (slot.elf)
+        return slot.elf;
+
+    FfiProgram fetched{};
+    if (fetch(program, &fetched) != SUCCESS)
+        return nullptr;
+    slot.elf = Elf(new FfiProgram(fetched), [](const FfiProgram* elf) {
+        wallet_ffi_free_ffi_program(const_cast<FfiProgram*>(elf));
+        delete elf;
+    });
+    return slot.elf;
+}
+
+int BuiltinElfs::openDescriptor(const Program program) {
+#ifdef __linux__
+    const Elf elf = get(program);
+    if (!elf)
+        return -1;
+
+    Slot& slot = slots[static_cast<size_t>(program)];
+    std::lock_guard lock(slot.mutex);
+    if (slot.descriptor < 0) {
+        slot.descriptor = createSealedDescriptor(name(program), *elf);
+        if (slot.descriptor < 0) {
+            perror("BuiltinElfs: memfd");
+            return -1;
+        }
+    }
+    return fcntl(slot.descriptor, F_DUPFD_CLOEXEC, 0);
+#else
+    (void)program;
+    return -1;
+#endif
+}
+
+std::optional<BuiltinElfs::Program> BuiltinElfs::fromName(const std::string& name) {
+    for (size_t i = 0; i < ProgramCount; ++i) {
+        if (name == PROGRAM_NAMES[i])
+            return static_cast<Program>(i);
+    }
+    return std::nullopt;
+}
+
+const char* BuiltinElfs::name(const Program program) {
+    return PROGRAM_NAMES[static_cast<size_t>(program)];
+}
@@ -0,0 +1,59 @@
+#ifndef BUILTIN_ELFS_H
+#define BUILTIN_ELFS_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// The program ELFs built into wallet_ffi (authenticated transfer, token, AMM, ATA). They
+// never change for the life of the process but are several megabytes each, so each one is
+// fetched from wallet_ffi once, on first use, and then shared read-only: the buffer the
+// library handed out is kept as is (no copy) and released with wallet_ffi_free_ffi_program
+// when the cache and every outstanding reference are gone. A failed fetch is not cached.
+class BuiltinElfs {
+public:
+    enum class Program { AuthenticatedTransfer, Token, Amm, Ata };
+    static constexpr size_t ProgramCount = 4;
+
+    using Elf = std::shared_ptr<const FfiProgram>;
+    // Fills `out` for `program` (one of the wallet_ffi_*_elf calls).
+    using Fetch = std::function<WalletFfiError(Program program, FfiProgram* out)>;
+
+    explicit BuiltinElfs(Fetch fetch);
+    ~BuiltinElfs();
+
+    BuiltinElfs(const BuiltinElfs&) = delete;
+    BuiltinElfs& operator=(const BuiltinElfs&) = delete;
+
+    // Null if the fetch failed.
+    Elf get(Program program);
+
+    // A new descriptor for a sealed, read-only in-memory file holding the ELF, for handing
+    // the bytes to another process (or mmap) without copying them through the API. The
+    // caller owns the descriptor. -1 on failure or where memfd sealing is unavailable.
+    int openDescriptor(Program program);
+
+    // "authenticated_transfer", "token", "amm", "ata".
+    static std::optional<Program> fromName(const std::string& name);
+    static const char* name(Program program);
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        Elf elf;
+        int descriptor = -1;
+    };
+
+    const Fetch fetch;
+    std::array<Slot, ProgramCount> slots;
+};
+
+#endif // BUILTIN_ELFS_H
@@ -0,0 +1,291 @@
+#include "hex_codec.h"
+
+#include <array>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HEX_CODEC_X86 1
+#include <immintrin.h>
+#else
+#define HEX_CODEC_X86 0
+#endif
+
+namespace {
+
+constexpr char HexDigits[] = "0123456789abcdef";
+
+// Byte -> its two lowercase hex chars.
+constexpr std::array<std::array<char, 2>, 256> makeEncodeTable() {
+    std::array<std::array<char, 2>, 256> table{};
+    for (int i = 0; i < 256; ++i)
+        table[i] = {HexDigits[i >> 4], HexDigits[i & 0xF]};
+    return table;
+}
+
+// Char -> nibble value, or 0xFF for anything that is not a hex digit.
+constexpr std::array<uint8_t, 256> makeDecodeTable() {
+    std::array<uint8_t, 256> table{};
+    for (int i = 0; i < 256; ++i)
+        table[i] = 0xFF;
+    for (int i = 0; i < 10; ++i)
+        table['0' + i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 6; ++i) {
+        table['a' + i] = static_cast<uint8_t>(10 + i);
+        table['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr auto EncodeTable = makeEncodeTable();
+constexpr auto DecodeTable = makeDecodeTable();
+
+void encodeScalar(const uint8_t* data, const size_t length, char* out) {
+    for (size_t i = 0; i < length; ++i) {
+        out[2 * i] = EncodeTable[data[i]][0];
+        out[2 * i + 1] = EncodeTable[data[i]][1];
+    }
+}
+
+bool decodeScalar(const char* hex, const size_t length, uint8_t* out) {
+    for (size_t i = 0; i < length; ++i) {
+        const uint8_t hi = DecodeTable[static_cast<uint8_t>(hex[2 * i])];
+        const uint8_t lo = DecodeTable[static_cast<uint8_t>(hex[2 * i + 1])];
+        if ((hi | lo) & 0xF0)
+            return false;
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+#if HEX_CODEC_X86
+
+// --- SSE2: 16 bytes <-> 32 chars per step --------------------------------------------------
+
+// Nibbles (0..15 per byte) -> ASCII: n + '0', plus ('a' - '0' - 10) where n > 9.
+__attribute__((target("sse2"))) inline __m128i nibblesToAsciiSse2(const __m128i n) {
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), letters);
+}
+
+__attribute__((target("sse2"))) void encodeSse2(const uint8_t* data, const size_t length, char* out) {
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask);
+        const __m128i lo = _mm_and_si128(bytes, lowMask);
+        // Interleave so each byte's high nibble char precedes its low nibble char.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), nibblesToAsciiSse2(_mm_unpacklo_epi8(hi, lo)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), nibblesToAsciiSse2(_mm_unpackhi_epi8(hi, lo)));
+    }
+    encodeScalar(data + i, length - i, out + 2 * i);
+}
+
+// 16 ASCII chars -> 16 nibble values; `valid` collects a 0xFF byte for every hex digit.
+__attribute__((target("sse2"))) inline __m128i asciiToNibblesSse2(const __m128i c, __m128i& valid) {
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    // OR-ing 0x20 folds 'A'..'F' onto 'a'..'f' and maps nothing else into that range.
+    const __m128i folded = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i isLetter =
+        _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), folded));
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+    const __m128i digitValue = _mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0')));
+    const __m128i letterValue = _mm_andnot_si128(isDigit, _mm_sub_epi8(folded, _mm_set1_epi8('a' - 10)));
+    return _mm_or_si128(digitValue, letterValue);
+}
+
+// Each 16-bit lane holds (high nibble, low nibble) as its two bytes -> one byte value per lane.
+__attribute__((target("sse2"))) inline __m128i combineNibblePairsSse2(const __m128i n) {
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(n, 4), _mm_set1_epi16(0x00F0)), _mm_srli_epi16(n, 8));
+}
+
+__attribute__((target("sse2"))) bool decodeSse2(const char* hex, const size_t length, uint8_t* out) {
+    __m128i valid = _mm_set1_epi8(static_cast<char>(0xFF));
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i + 16));
+        const __m128i bytesA = combineNibblePairsSse2(asciiToNibblesSse2(a, valid));
+        const __m128i bytesB = combineNibblePairsSse2(asciiToNibblesSse2(b, valid));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(bytesA, bytesB));
+    }
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+        return false;
+    return decodeScalar(hex + 2 * i, length - i, out + i);
+}
+
+// --- AVX2: 32 bytes <-> 64 chars per step --------------------------------------------------
+
+__attribute__((target("avx2"))) inline __m256i nibblesToAsciiAvx2(const __m256i n) {
+    const __m256i letters =
+        _mm256_and_si256(_mm256_cmpgt_epi8(n, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')), letters);
+}
+
+__attribute__((target("avx2"))) void encodeAvx2(const uint8_t* data, const size_t length, char* out) {
+    const __m256i lowMask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), lowMask);
+        const __m256i lo = _mm256_and_si256(bytes, lowMask);
+        // unpack works per 128-bit lane: reassemble the lanes into input order.
+        const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(out + 2 * i), nibblesToAsciiAvx2(_mm256_permute2x128_si256(first, second, 0x20))
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(out + 2 * i + 32),
+            nibblesToAsciiAvx2(_mm256_permute2x128_si256(first, second, 0x31))
+        );
+    }
+    encodeSse2(data + i, length - i, out + 2 * i);
+}
+
+__attribute__((target("avx2"))) inline __m256i asciiToNibblesAvx2(const __m256i c, __m256i& valid) {
+    const __m256i isDigit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i folded = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i isLetter = _mm256_and_si256(
+        _mm256_cmpgt_epi8(folded, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), folded)
+    );
+    valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isLetter));
+    const __m256i digitValue = _mm256_and_si256(isDigit, _mm256_sub_epi8(c, _mm256_set1_epi8('0')));
+    const __m256i letterValue = _mm256_andnot_si256(isDigit, _mm256_sub_epi8(folded, _mm256_set1_epi8('a' - 10)));
+    return _mm256_or_si256(digitValue, letterValue);
+}
+
+__attribute__((target("avx2"))) inline __m256i combineNibblePairsAvx2(const __m256i n) {
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_slli_epi16(n, 4), _mm256_set1_epi16(0x00F0)), _mm256_srli_epi16(n, 8)
+    );
+}
+
+__attribute__((target("avx2"))) bool decodeAvx2(const char* hex, const size_t length, uint8_t* out) {
+    __m256i valid = _mm256_set1_epi8(static_cast<char>(0xFF));
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + 2 * i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + 2 * i + 32));
+        const __m256i packed = _mm256_packus_epi16(
+            combineNibblePairsAvx2(asciiToNibblesAvx2(a, valid)), combineNibblePairsAvx2(asciiToNibblesAvx2(b, valid))
+        );
+        // packus interleaves 64-bit quarters as a0 b0 a1 b1; restore a0 a1 b0 b1.
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    if (static_cast<uint32_t>(_mm256_movemask_epi8(valid)) != 0xFFFFFFFFu)
+        return false;
+    return decodeSse2(hex + 2 * i, length - i, out + i);
+}
+
+#endif // HEX_CODEC_X86
+
+HexCodec::Kernel detectKernel() {
+#if HEX_CODEC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return HexCodec::Kernel::Avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return HexCodec::Kernel::Sse2;
+#endif
+    return HexCodec::Kernel::Scalar;
+}
+
+bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+namespace HexCodec {
+
+    Kernel activeKernel() {
+        static const Kernel kernel = detectKernel();
+        return kernel;
+    }
+
+    bool kernelSupported(const Kernel kernel) {
+        switch (kernel) {
+        case Kernel::Avx2:
+            return activeKernel() == Kernel::Avx2;
+        case Kernel::Sse2:
+            return activeKernel() != Kernel::Scalar;
+        case Kernel::Scalar:
+        default:
+            return true;
+        }
+    }
+
+    const char* kernelName(const Kernel kernel) {
+        switch (kernel) {
+        case Kernel::Avx2:
+            return "avx2";
+        case Kernel::Sse2:
+            return "sse2";
+        case Kernel::Scalar:
+        default:
+            return "scalar";
+        }
+    }
+
+    void encode(const Kernel kernel, const uint8_t* data, const size_t length, char* out) {
+        switch (kernel) {
+#if HEX_CODEC_X86
+        case Kernel::Avx2:
+            encodeAvx2(data, length, out);
+            return;
+        case Kernel::Sse2:
+            encodeSse2(data, length, out);
+            return;
+#endif
+        default:
+            encodeScalar(data, length, out);
+            return;
+        }
+    }
+
+    bool decode(const Kernel kernel, const char* hex, const size_t length, uint8_t* out) {
+        switch (kernel) {
+#if HEX_CODEC_X86
+        case Kernel::Avx2:
+            return decodeAvx2(hex, length, out);
+        case Kernel::Sse2:
+            return decodeSse2(hex, length, out);
+#endif
+        default:
+            return decodeScalar(hex, length, out);
+        }
+    }
+
+    void encode(const uint8_t* data, const size_t length, char* out) {
+        encode(activeKernel(), data, length, out);
+    }
+
+    std::string encode(const uint8_t* data, const size_t length) {
+        std::string out(length * 2, '\0');
+        encode(activeKernel(), data, length, out.data());
+        return out;
+    }
+
+    bool decode(const char* hex, const size_t length, uint8_t* out) {
+        return decode(activeKernel(), hex, length, out);
+    }
+
+    std::string_view stripInput(std::string_view text) {
+        while (!text.empty() && isWhitespace(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && isWhitespace(text.back()))
+            text.remove_suffix(1);
+        if (text.size() >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+            text.remove_prefix(2);
+        return text;
+    }
+
+    bool parseFixed(const std::string_view text, uint8_t* out, const size_t length) {
+        const std::string_view hex = stripInput(text);
+        if (hex.size() != length * 2)
+            return false;
+        return decode(hex.data(), length, out);
+    }
+
+} // namespace HexCodec
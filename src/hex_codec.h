@@ -0,0 +1,43 @@
+#ifndef HEX_CODEC_H
+#define HEX_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Hex encode/decode kernels behind bytesToHex / hexToBytes. On x86 the widest kernel the
+// CPU supports (AVX2, else SSE2) is picked once at first use; everything else, and the
+// tail of every SIMD call, runs the table-driven scalar kernel. Encoding is lowercase;
+// decoding accepts either case.
+namespace HexCodec {
+
+    enum class Kernel { Scalar, Sse2, Avx2 };
+
+    // Kernel used by encode()/decode() on this CPU.
+    Kernel activeKernel();
+    bool kernelSupported(Kernel kernel);
+    const char* kernelName(Kernel kernel);
+
+    // Writes 2 * length hex chars to `out` (no terminator).
+    void encode(const uint8_t* data, size_t length, char* out);
+    std::string encode(const uint8_t* data, size_t length);
+
+    // Decodes exactly 2 * length hex chars from `hex` into `out`. Returns false if any char
+    // is not a hex digit; `out` is then partially written.
+    bool decode(const char* hex, size_t length, uint8_t* out);
+
+    // Same as above on an explicit kernel (tests and benchmarks); `kernel` must be supported.
+    void encode(Kernel kernel, const uint8_t* data, size_t length, char* out);
+    bool decode(Kernel kernel, const char* hex, size_t length, uint8_t* out);
+
+    // Drops surrounding whitespace and then one optional "0x"/"0X" prefix.
+    std::string_view stripInput(std::string_view text);
+
+    // Full input validation for a fixed-size value: stripInput, then exactly 2 * length hex
+    // chars. Writes straight into `out` without allocating.
+    bool parseFixed(std::string_view text, uint8_t* out, size_t length);
+
+} // namespace HexCodec
+
+#endif // HEX_CODEC_H
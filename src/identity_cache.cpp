@@ -0,0 +1,48 @@
+#include "identity_cache.h"
+
+#include <cstring>
+
+size_t IdentityCache::KeyHash::operator()(const Key& key) const {
+    // Account ids are hashes already; the first 8 bytes are as good a hash as any.
+    uint64_t h = 0;
+    memcpy(&h, key.data(), sizeof(h));
+    return static_cast<size_t>(h);
+}
+
+IdentityCache::Key IdentityCache::makeKey(const FfiBytes32& id) {
+    Key key{};
+    memcpy(key.data(), id.data, 32);
+    return key;
+}
+
+IdentityCache::Identity IdentityCache::get(const FfiBytes32& id) const {
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(makeKey(id));
+    return it == entries.end() ? nullptr : it->second;
+}
+
+IdentityCache::Identity IdentityCache::put(const FfiBytes32& id, const FfiAccountIdentity& identity) {
+    Identity owned(new FfiAccountIdentity(identity), [](const FfiAccountIdentity* p) {
+        wallet_ffi_free_account_identity(const_cast<FfiAccountIdentity*>(p));
+        delete p;
+    });
+
+    std::lock_guard lock(mutex);
+    const Key key = makeKey(id);
+    // A concurrent resolve got there first: keep that one, release ours with `owned`.
+    if (const auto it = entries.find(key); it != entries.end())
+        return it->second;
+    if (entries.size() < MaxEntries)
+        entries.emplace(key, owned);
+    return owned;
+}
+
+void IdentityCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+}
+
+size_t IdentityCache::size() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
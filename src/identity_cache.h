@@ -0,0 +1,48 @@
+#ifndef IDENTITY_CACHE_H
+#define IDENTITY_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Private account identities as wallet_ffi_resolve_private_account returns them (keys, key
+// path, identifier). They only depend on the wallet's key material, so each one is resolved
+// once per open wallet and shared; an entry is released with wallet_ffi_free_account_identity
+// once the cache and every call using it are done with it. Cleared whenever a different
+// wallet is opened. Failed resolutions are not cached.
+class IdentityCache {
+public:
+    using Identity = std::shared_ptr<const FfiAccountIdentity>;
+
+    static constexpr size_t MaxEntries = 4096;
+
+    // Null if `id` has not been resolved yet.
+    Identity get(const FfiBytes32& id) const;
+    // Takes ownership of `identity` and returns it shared; when the cache is full the result
+    // is not kept, only handed back.
+    Identity put(const FfiBytes32& id, const FfiAccountIdentity& identity);
+
+    void clear();
+    size_t size() const;
+
+private:
+    using Key = std::array<uint8_t, 32>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key makeKey(const FfiBytes32& id);
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Identity, KeyHash> entries;
+};
+
+#endif // IDENTITY_CACHE_H
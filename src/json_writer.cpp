@@ -0,0 +1,111 @@
+#include "json_writer.h"
+
+#include <nlohmann/json.hpp>
+
+#include "hex_codec.h"
+
+JsonObjectWriter::JsonObjectWriter(const size_t capacity) {
+    out.reserve(capacity);
+    out.push_back('{');
+}
+
+void JsonObjectWriter::boolean(const std::string_view name, const bool value) {
+    key(name);
+    out.append(value ? "true" : "false");
+}
+
+void JsonObjectWriter::string(const std::string_view name, const std::string_view value) {
+    key(name);
+    escaped(value);
+}
+
+void JsonObjectWriter::hex(const std::string_view name, const uint8_t* data, const size_t length) {
+    key(name);
+    out.push_back('"');
+    const size_t at = out.size();
+    out.resize(at + length * 2);
+    HexCodec::encode(data, length, out.data() + at);
+    out.push_back('"');
+}
+
+void JsonObjectWriter::hexArray(const std::string_view name, const uint8_t* data, const size_t count, const size_t stride) {
+    key(name);
+    out.push_back('[');
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0)
+            out.push_back(',');
+        out.push_back('"');
+        const size_t at = out.size();
+        out.resize(at + stride * 2);
+        HexCodec::encode(data + i * stride, stride, out.data() + at);
+        out.push_back('"');
+    }
+    out.push_back(']');
+}
+
+std::string JsonObjectWriter::finish() {
+    out.push_back('}');
+    return std::move(out);
+}
+
+void JsonObjectWriter::key(const std::string_view name) {
+    if (!first)
+        out.push_back(',');
+    first = false;
+    // Keys are the module's own ASCII constants; nothing to escape.
+    out.push_back('"');
+    out.append(name);
+    out.append("\":");
+}
+
+void JsonObjectWriter::escaped(const std::string_view value) {
+    // dump() validates UTF-8 (and throws on bad input); leave anything non-ASCII to it so
+    // both the output and the failure behaviour stay the same.
+    for (const char c : value) {
+        if (static_cast<unsigned char>(c) >= 0x80) {
+            out.append(nlohmann::json(std::string(value)).dump());
+            return;
+        }
+    }
+
+    static constexpr char digits[] = "0123456789abcdef";
+    out.push_back('"');
+    size_t run = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\b':
+            out.append("\\b");
+            break;
+        case '\f':
+            out.append("\\f");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        default: {
+            const char escape[] = {'\\', 'u', '0', '0', digits[c >> 4], digits[c & 0xF]};
+            out.append(escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+    out.append(value.data() + run, value.size() - run);
+    out.push_back('"');
+}
@@ -0,0 +1,50 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+// Writes the module's fixed-shape result objects straight into one pre-sized string, with no
+// intermediate nlohmann::json tree. Output is byte-identical to nlohmann::json::dump() of the
+// same object: members must be written in dump()'s order (keys sorted, which keysSorted()
+// lets callers static_assert) and strings are escaped exactly as dump() does.
+class JsonObjectWriter {
+public:
+    // `capacity` is a size estimate; the buffer still grows if it is exceeded.
+    explicit JsonObjectWriter(size_t capacity);
+
+    void boolean(std::string_view key, bool value);
+    void string(std::string_view key, std::string_view value);
+    // Lowercase hex of `length` bytes, as LEZCodec::bytesToHex.
+    void hex(std::string_view key, const uint8_t* data, size_t length);
+
+    // Array of the hex spellings of `count` consecutive `stride`-byte values.
+    void hexArray(std::string_view key, const uint8_t* data, size_t count, size_t stride);
+
+    std::string finish();
+
+    // Bytes a key/value member adds before escaping: quotes, colon, comma.
+    static constexpr size_t memberOverhead(const std::string_view key) { return key.size() + 6; }
+
+    static constexpr bool keysSorted(const std::initializer_list<std::string_view> keys) {
+        const std::string_view* previous = nullptr;
+        for (const std::string_view& key : keys) {
+            if (previous && !(*previous < key))
+                return false;
+            previous = &key;
+        }
+        return true;
+    }
+
+private:
+    void key(std::string_view key);
+    void escaped(std::string_view value);
+
+    std::string out;
+    bool first = true;
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,335 @@
+#include "lez_codec.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "hex_codec.h"
+#include "json_writer.h"
+
+namespace LEZCodec {
+
+std::string bytesToHex(const uint8_t* data, const size_t length) {
+    return HexCodec::encode(data, length);
+}
+
+#if !defined(__SIZEOF_INT128__)
+#error "LEZCodec requires __uint128_t; build with GCC or Clang on 64-bit"
+#endif
+
+namespace {
+
+constexpr uint64_t TEN_19 = 10000000000000000000ull;
+
+constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Writes `value` (< 10^19) right-aligned so that it ends at `end`, two digits per step, and
+// returns where it starts. With `pad` it is zero-filled to all 19 digits.
+char* writeChunk(char* end, uint64_t value, const bool pad) {
+    char* p = end;
+    while (value >= 100) {
+        const size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        const size_t pair = static_cast<size_t>(value) * 2;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+    if (pad) {
+        while (p > end - 19)
+            *--p = '0';
+    }
+    return p;
+}
+
+} // namespace
+
+// Balance from wallet_ffi_get_balance is 16 bytes little-endian (u128). Convert to decimal string for UI.
+// Splits the value into base-10^19 chunks (at most two 128-bit divisions) and formats each
+// chunk with 64-bit arithmetic, instead of a 128-bit divide per digit.
+std::string balanceLe16ToDecimalString(const uint8_t* data) {
+    __uint128_t v = 0;
+    for (int i = 15; i >= 0; --i)
+        v = (v << 8) | data[i];
+
+    char buf[40];
+    char* const end = buf + sizeof(buf);
+    char* start;
+    if (v < TEN_19) {
+        start = writeChunk(end, static_cast<uint64_t>(v), false);
+    } else {
+        const __uint128_t high = v / TEN_19;
+        start = writeChunk(end, static_cast<uint64_t>(v - high * TEN_19), true);
+        if (high < TEN_19) {
+            start = writeChunk(start, static_cast<uint64_t>(high), false);
+        } else {
+            // u128 max is 39 digits: the top chunk is a single digit.
+            const uint64_t top = static_cast<uint64_t>(high / TEN_19);
+            start = writeChunk(start, static_cast<uint64_t>(high - static_cast<__uint128_t>(top) * TEN_19), true);
+            start = writeChunk(start, top, false);
+        }
+    }
+    return std::string(start, end);
+}
+
+// Surrounding whitespace is allowed, nothing else: no sign, no separators, no fraction.
+bool decimalToU128(const std::string& decimal, uint8_t (*output)[16]) {
+    constexpr __uint128_t MAX = ~static_cast<__uint128_t>(0);
+    constexpr __uint128_t MAX_DIV_10 = MAX / 10;
+    constexpr unsigned MAX_MOD_10 = static_cast<unsigned>(MAX % 10);
+
+    size_t begin = 0, end = decimal.size();
+    while (begin < end && isspace(static_cast<unsigned char>(decimal[begin])))
+        ++begin;
+    while (end > begin && isspace(static_cast<unsigned char>(decimal[end - 1])))
+        --end;
+    if (begin == end)
+        return false;
+
+    __uint128_t v = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const unsigned digit = static_cast<unsigned char>(decimal[i]) - '0';
+        if (digit > 9)
+            return false;
+        if (v > MAX_DIV_10 || (v == MAX_DIV_10 && digit > MAX_MOD_10))
+            return false;
+        v = v * 10 + digit;
+    }
+    for (int i = 0; i < 16; ++i)
+        (*output)[i] = static_cast<uint8_t>(v >> (i * 8));
+    return true;
+}
+
+// Accepts surrounding whitespace and an optional 0x/0X prefix. Decodes straight into
+// output_bytes; on failure its contents are unspecified.
+bool hexToBytes(const std::string& hex, std::vector<uint8_t>& output_bytes, int expectedLength) {
+    const std::string_view digits = HexCodec::stripInput(hex);
+    if (digits.size() % 2 != 0)
+        return false;
+    const size_t length = digits.size() / 2;
+    if (expectedLength != -1 && length != static_cast<size_t>(expectedLength))
+        return false;
+
+    output_bytes.resize(length);
+    return HexCodec::decode(digits.data(), length, output_bytes.data());
+}
+
+// Fixed-size parses go straight into the caller's buffer: no heap on the 16/32-byte hot path.
+bool hexToU128(const std::string& hex, uint8_t (*output)[16]) {
+    return HexCodec::parseFixed(hex, *output, 16);
+}
+
+std::string bytes32ToHex(const FfiBytes32& bytes) {
+    return bytesToHex(bytes.data, 32);
+}
+
+bool hexToBytes32(const std::string& hex, FfiBytes32* output_bytes) {
+    if (output_bytes == nullptr)
+        return false;
+    return HexCodec::parseFixed(hex, output_bytes->data, 32);
+}
+
+// The result objects below are written with JsonObjectWriter rather than built as an
+// nlohmann::json tree; members go in dump()'s (sorted) key order, checked at compile time.
+
+// Builds JSON { success, tx_hash, error } for both success (result + empty error) and failure (nullptr + errorMessage).
+std::string transferResultToJson(const FfiTransferResult* result, const std::string& errorMessage) {
+    static_assert(JsonObjectWriter::keysSorted({JsonKeys::Error, JsonKeys::Success, JsonKeys::TxHash}));
+    const bool isError = !errorMessage.empty();
+    const std::string_view txHash = (!isError && result && result->tx_hash) ? std::string_view(result->tx_hash) : std::string_view();
+
+    JsonObjectWriter writer(2 + JsonObjectWriter::memberOverhead(JsonKeys::Error) + errorMessage.size() +
+                            JsonObjectWriter::memberOverhead(JsonKeys::Success) + 5 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::TxHash) + txHash.size());
+    writer.string(JsonKeys::Error, errorMessage);
+    writer.boolean(JsonKeys::Success, !isError && result && result->success);
+    writer.string(JsonKeys::TxHash, txHash);
+    return writer.finish();
+}
+
+// Builds JSON { success, tx_hash, secrets, error } for both success (result + empty error) and failure (nullptr + errorMessage) in case of generic transaction.
+std::string genericTransactionResultToJson(const FfiTransactionResult* result, const std::string& errorMessage) {
+    static_assert(JsonObjectWriter::keysSorted({JsonKeys::Error, JsonKeys::Secrets, JsonKeys::Success, JsonKeys::TxHash}));
+    const bool isError = !errorMessage.empty();
+    const std::string_view txHash = (!isError && result && result->tx_hash) ? std::string_view(result->tx_hash) : std::string_view();
+    const size_t secretCount = (!isError && result && result->secrets_data) ? static_cast<size_t>(result->secrets_size) : 0;
+
+    JsonObjectWriter writer(2 + JsonObjectWriter::memberOverhead(JsonKeys::Error) + errorMessage.size() +
+                            JsonObjectWriter::memberOverhead(JsonKeys::Secrets) + secretCount * 67 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::Success) + 5 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::TxHash) + txHash.size());
+    writer.string(JsonKeys::Error, errorMessage);
+    writer.hexArray(JsonKeys::Secrets, secretCount ? result->secrets_data[0].data : nullptr, secretCount, 32);
+    writer.boolean(JsonKeys::Success, !isError && result && result->success);
+    writer.string(JsonKeys::TxHash, txHash);
+    return writer.finish();
+}
+
+std::string ffiAccountToJson(const FfiAccount& account) {
+    static_assert(JsonObjectWriter::keysSorted({JsonKeys::Balance, JsonKeys::Data, JsonKeys::Nonce, JsonKeys::ProgramOwner}));
+    const size_t dataLength = (account.data && account.data_len > 0) ? static_cast<size_t>(account.data_len) : 0;
+
+    JsonObjectWriter writer(2 + JsonObjectWriter::memberOverhead(JsonKeys::Balance) + 32 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::Data) + dataLength * 2 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::Nonce) + 32 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::ProgramOwner) + 64);
+    writer.hex(JsonKeys::Balance, account.balance.data, 16);
+    writer.hex(JsonKeys::Data, account.data, dataLength);
+    writer.hex(JsonKeys::Nonce, account.nonce.data, 16);
+    writer.hex(JsonKeys::ProgramOwner, reinterpret_cast<const uint8_t*>(account.program_owner.data), 32);
+    return writer.finish();
+}
+
+nlohmann::json ffiAccountListEntryToJson(const FfiAccountListEntry& entry) {
+    nlohmann::json obj = nlohmann::json::object();
+    obj[JsonKeys::AccountId] = bytes32ToHex(entry.account_id);
+    obj[JsonKeys::IsPublic] = entry.is_public;
+    return obj;
+}
+
+std::string ffiPrivateAccountKeysToJson(const FfiPrivateAccountKeys& keys) {
+    static_assert(JsonObjectWriter::keysSorted({JsonKeys::NullifierPublicKey, JsonKeys::ViewingPublicKey}));
+    const size_t viewingKeyLength = (keys.viewing_public_key && keys.viewing_public_key_len > 0) ? static_cast<size_t>(keys.viewing_public_key_len) : 0;
+
+    JsonObjectWriter writer(2 + JsonObjectWriter::memberOverhead(JsonKeys::NullifierPublicKey) + 64 +
+                            JsonObjectWriter::memberOverhead(JsonKeys::ViewingPublicKey) + viewingKeyLength * 2);
+    writer.hex(JsonKeys::NullifierPublicKey, keys.nullifier_public_key.data, 32);
+    writer.hex(JsonKeys::ViewingPublicKey, keys.viewing_public_key, viewingKeyLength);
+    return writer.finish();
+}
+
+// Nothing in this codebase currently emits an "identifier" field in to_keys_json — NPK/VPK
+// identify a key group, not one specific account in it, so get_private_account_keys never
+// attaches one. Kept for forward compatibility (e.g. a hand-crafted or future payload that
+// targets one specific account within a group) and to make the fallback below explicit.
+bool jsonExtractIdentifier(const std::string& json, FfiU128* out_identifier) {
+    nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
+    if (doc.is_discarded() || !doc.is_object())
+        return false;
+    if (!doc.contains(JsonKeys::Identifier) || !doc[JsonKeys::Identifier].is_string())
+        return false;
+    return HexCodec::parseFixed(doc[JsonKeys::Identifier].get_ref<const std::string&>(), out_identifier->data, 16);
+}
+
+bool jsonToFfiPrivateAccountKeys(const std::string& json, FfiPrivateAccountKeys* output_keys) {
+    std::vector<uint8_t> buffer;
+    FfiU128 identifier{};
+    bool hasIdentifier = false;
+    if (!jsonToRecipientKeys(json, &output_keys->nullifier_public_key, buffer, &identifier, &hasIdentifier))
+        return false;
+
+    output_keys->viewing_public_key = nullptr;
+    output_keys->viewing_public_key_len = 0;
+    if (!buffer.empty()) {
+        auto* data = static_cast<uint8_t*>(malloc(buffer.size()));
+        if (!data)
+            return false;
+        memcpy(data, buffer.data(), buffer.size());
+        output_keys->viewing_public_key = data;
+        output_keys->viewing_public_key_len = buffer.size();
+    }
+    return true;
+}
+
+bool jsonToRecipientKeys(const std::string& json, FfiBytes32* nullifier_public_key, std::vector<uint8_t>& viewing_public_key, FfiU128* identifier, bool* has_identifier) {
+    nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
+    if (doc.is_discarded() || !doc.is_object())
+        return false;
+
+    // Nullifier public key is mandatory: a missing/wrong-typed value must not fall back to zero.
+    if (!doc.contains(JsonKeys::NullifierPublicKey) || !doc[JsonKeys::NullifierPublicKey].is_string())
+        return false;
+    if (!hexToBytes32(doc[JsonKeys::NullifierPublicKey].get_ref<const std::string&>(), nullifier_public_key))
+        return false;
+
+    viewing_public_key.clear();
+    if (doc.contains(JsonKeys::ViewingPublicKey)) {
+        if (!doc[JsonKeys::ViewingPublicKey].is_string())
+            return false;
+        if (!hexToBytes(doc[JsonKeys::ViewingPublicKey].get_ref<const std::string&>(), viewing_public_key))
+            return false;
+    }
+
+    *has_identifier = doc.contains(JsonKeys::Identifier) && doc[JsonKeys::Identifier].is_string() &&
+                      HexCodec::parseFixed(doc[JsonKeys::Identifier].get_ref<const std::string&>(), identifier->data, 16);
+    return true;
+}
+
+void u128ToInstructionWords(const uint8_t (&amount)[16], uint32_t (&words)[4]) {
+    for (int i = 0; i < 4; ++i) {
+        words[i] = static_cast<uint32_t>(amount[i * 4]) | (static_cast<uint32_t>(amount[i * 4 + 1]) << 8) |
+                   (static_cast<uint32_t>(amount[i * 4 + 2]) << 16) | (static_cast<uint32_t>(amount[i * 4 + 3]) << 24);
+    }
+}
+
+// Parses a JSON array of 32-byte hex strings into a contiguous byte buffer of siblings.
+// Returns true on success, with out_len set to the number of siblings and out_bytes sized to out_len*32.
+bool jsonArrayHexToSiblings32(const std::string& json_array_str, std::vector<uint8_t>& out_bytes, uintptr_t& out_len) {
+    nlohmann::json doc = nlohmann::json::parse(json_array_str, nullptr, false);
+    if (doc.is_discarded() || !doc.is_array())
+        return false;
+
+    out_len = static_cast<uintptr_t>(doc.size());
+    out_bytes.resize(out_len * 32);
+
+    uint8_t* sibling = out_bytes.data();
+    for (const auto& v : doc) {
+        if (!v.is_string())
+            return false;
+        if (!HexCodec::parseFixed(v.get_ref<const std::string&>(), sibling, 32))
+            return false;
+        sibling += 32;
+    }
+    return true;
+}
+
+// === Binary records ===
+
+bool bytesToBytes32(const std::vector<uint8_t>& bytes, FfiBytes32* output_bytes) {
+    if (output_bytes == nullptr || bytes.size() != 32)
+        return false;
+    memcpy(output_bytes->data, bytes.data(), 32);
+    return true;
+}
+
+bool bytesToU128(const std::vector<uint8_t>& bytes, uint8_t (*output)[16]) {
+    if (bytes.size() != 16)
+        return false;
+    memcpy(*output, bytes.data(), 16);
+    return true;
+}
+
+std::vector<uint8_t> ffiAccountToRecord(const FfiAccount& account) {
+    const size_t dataLength = account.data ? static_cast<size_t>(account.data_len) : 0;
+    std::vector<uint8_t> record(AccountRecordHeaderSize + dataLength);
+    uint8_t* out = record.data();
+    memcpy(out, account.program_owner.data, 32);
+    memcpy(out + 32, account.balance.data, 16);
+    memcpy(out + 48, account.nonce.data, 16);
+    for (int i = 0; i < 4; ++i)
+        out[64 + i] = static_cast<uint8_t>(static_cast<uint32_t>(dataLength) >> (i * 8));
+    if (dataLength > 0)
+        memcpy(out + AccountRecordHeaderSize, account.data, dataLength);
+    return record;
+}
+
+std::vector<uint8_t> transferResultToRecord(const FfiTransferResult* result, const int32_t error) {
+    std::vector<uint8_t> record(TransferRecordSize, 0);
+    const bool success = error == 0 && result && result->success;
+    record[0] = success ? 1 : 0;
+    for (int i = 0; i < 4; ++i)
+        record[1 + i] = static_cast<uint8_t>(static_cast<uint32_t>(error) >> (i * 8));
+    if (success && result->tx_hash && !HexCodec::parseFixed(result->tx_hash, record.data() + 5, 32))
+        memset(record.data() + 5, 0, 32);
+    return record;
+}
+
+} // namespace LEZCodec
@@ -0,0 +1,117 @@
+#ifndef LEZ_CODEC_H
+#define LEZ_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Conversions between wallet_ffi structs and the hex / JSON strings the module exchanges
+// with callers. Pure functions with no wallet state, kept out of lez_core_module.cpp so the
+// codec benchmark (tests/bench_codec.cpp) can drive them directly.
+namespace LEZCodec {
+
+namespace JsonKeys {
+constexpr auto TxHash = "tx_hash";
+constexpr auto Success = "success";
+constexpr auto Error = "error";
+constexpr auto ProgramOwner = "program_owner";
+constexpr auto Balance = "balance";
+constexpr auto Nonce = "nonce";
+constexpr auto Data = "data";
+constexpr auto NullifierPublicKey = "nullifier_public_key";
+constexpr auto ViewingPublicKey = "viewing_public_key";
+constexpr auto Identifier = "identifier";
+constexpr auto AccountId = "account_id";
+constexpr auto IsPublic = "is_public";
+constexpr auto Secrets = "secrets";
+constexpr auto Ticket = "ticket";
+constexpr auto Status = "status";
+constexpr auto Method = "method";
+constexpr auto Result = "result";
+constexpr auto Sequence = "sequence";
+constexpr auto State = "state";
+constexpr auto StartBlock = "start_block";
+constexpr auto CurrentBlock = "current_block";
+constexpr auto TargetBlock = "target_block";
+constexpr auto BlocksPerSecond = "blocks_per_second";
+constexpr auto To = "to";
+constexpr auto Amount = "amount";
+constexpr auto Transactions = "transactions";
+constexpr auto Results = "results";
+constexpr auto TransferAmount = "transfer_amount";
+constexpr auto MergedEntries = "merged_entries";
+constexpr auto Accounts = "accounts";
+constexpr auto SubmitBlock = "submit_block";
+constexpr auto SubmittedAtMs = "submitted_at_ms";
+constexpr auto Id = "id";
+constexpr auto Kind = "kind";
+constexpr auto Block = "block";
+constexpr auto TimeMs = "time_ms";
+constexpr auto PreviousBalance = "previous_balance";
+constexpr auto Records = "records";
+constexpr auto NextCursor = "next_cursor";
+constexpr auto Changes = "changes";
+constexpr auto ElfsLoaded = "elfs_loaded";
+constexpr auto IdentitiesResolved = "identities_resolved";
+constexpr auto IdentitiesFailed = "identities_failed";
+constexpr auto ElapsedMs = "elapsed_ms";
+constexpr auto OwnWallet = "own_wallet";
+} // namespace JsonKeys
+
+// Hex
+std::string bytesToHex(const uint8_t* data, size_t length);
+bool hexToBytes(const std::string& hex, std::vector<uint8_t>& output_bytes, int expectedLength = -1);
+bool hexToU128(const std::string& hex, uint8_t (*output)[16]);
+std::string bytes32ToHex(const FfiBytes32& bytes);
+bool hexToBytes32(const std::string& hex, FfiBytes32* output_bytes);
+
+// u128 little-endian balance <-> decimal string
+std::string balanceLe16ToDecimalString(const uint8_t* data);
+// Strict: digits only (surrounding whitespace allowed); false on anything else or on a
+// value above 2^128 - 1.
+bool decimalToU128(const std::string& decimal, uint8_t (*output)[16]);
+
+// FFI results / records -> JSON
+std::string transferResultToJson(const FfiTransferResult* result, const std::string& errorMessage);
+std::string genericTransactionResultToJson(const FfiTransactionResult* result, const std::string& errorMessage);
+std::string ffiAccountToJson(const FfiAccount& account);
+nlohmann::json ffiAccountListEntryToJson(const FfiAccountListEntry& entry);
+std::string ffiPrivateAccountKeysToJson(const FfiPrivateAccountKeys& keys);
+
+// JSON -> FFI inputs
+bool jsonExtractIdentifier(const std::string& json, FfiU128* out_identifier);
+// On success output_keys->viewing_public_key is malloc'd (or null); release it with free().
+bool jsonToFfiPrivateAccountKeys(const std::string& json, FfiPrivateAccountKeys* output_keys);
+// Both of the above in one parse, with the viewing key in a vector. *has_identifier is false
+// when the JSON carries no (well-formed) identifier, as for jsonExtractIdentifier.
+bool jsonToRecipientKeys(const std::string& json, FfiBytes32* nullifier_public_key, std::vector<uint8_t>& viewing_public_key, FfiU128* identifier, bool* has_identifier);
+// A u128 as the four little-endian u32 words risc0 serde encodes it in (the authenticated
+// transfer program's instruction).
+void u128ToInstructionWords(const uint8_t (&amount)[16], uint32_t (&words)[4]);
+bool jsonArrayHexToSiblings32(const std::string& json_array_str, std::vector<uint8_t>& out_bytes, uintptr_t& out_len);
+
+// Binary API: raw values in, compact little-endian records out
+//   account record:  program_owner[32] balance[16] nonce[16] data_len:u32 data[data_len]
+//   transfer record: success:u8 error:i32 tx_hash[32] (hash all-zero unless success)
+constexpr size_t AccountRecordHeaderSize = 32 + 16 + 16 + 4;
+constexpr size_t TransferRecordSize = 1 + 4 + 32;
+
+// Exact-size copies; false if `bytes` has any other length.
+bool bytesToBytes32(const std::vector<uint8_t>& bytes, FfiBytes32* output_bytes);
+bool bytesToU128(const std::vector<uint8_t>& bytes, uint8_t (*output)[16]);
+
+std::vector<uint8_t> ffiAccountToRecord(const FfiAccount& account);
+// `error` is the WalletFfiError (or INVALID_INPUT for a malformed argument); `result` may be
+// null on failure. A tx hash that is not 32-byte hex is left zeroed.
+std::vector<uint8_t> transferResultToRecord(const FfiTransferResult* result, int32_t error);
+
+} // namespace LEZCodec
+
+#endif // LEZ_CODEC_H
@@ -4,271 +4,665 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <random>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "hex_codec.h"
+#include "lez_codec.h"
+#include "secure_random.h"
+
 namespace {
 
-std::string bytesToHex(const uint8_t* data, const size_t length) {
-    static const char hexChars[] = "0123456789abcdef";
-    std::string out;
-    out.reserve(length * 2);
-    for (size_t i = 0; i < length; ++i) {
-        out.push_back(hexChars[(data[i] >> 4) & 0xF]);
-        out.push_back(hexChars[data[i] & 0xF]);
+using namespace LEZCodec;
+
+// Exclusive hold of the wallet for a call that changes it. Once the call reports success it
+// commit()s, and on release, with a wallet open, the change is counted towards the next
+// autosave; a failed call leaves nothing to save.
+class WalletWriteLock {
+public:
+    WalletWriteLock(RwLock& walletMutex, Autosave& autosave, WalletHandle* const& walletHandle)
+        : lock(walletMutex), autosave(autosave), walletHandle(walletHandle) {}
+    ~WalletWriteLock() {
+        if (committed && walletHandle)
+            autosave.markDirty();
     }
-    return out;
-}
 
-// Balance from wallet_ffi_get_balance is 16 bytes little-endian (u128). Convert to decimal string for UI.
-// Requires __uint128_t (GCC/Clang on 64-bit).
-std::string balanceLe16ToDecimalString(const uint8_t* data) {
-#if defined(__SIZEOF_INT128__) && __SIZEOF_INT128__ >= 16
-    __uint128_t v = 0;
-    for (int i = 0; i < 16; ++i)
-        v |= static_cast<__uint128_t>(data[i]) << (i * 8);
-    if (v == 0)
-        return "0";
-    char buf[40];
-    int i = 0;
-    while (v) {
-        buf[i++] = static_cast<char>('0' + (v % 10));
-        v /= 10;
-    }
-    std::reverse(buf, buf + i);
-    return std::string(buf, i);
-#else
-#error "balanceLe16ToDecimalString requires __uint128_t; build with GCC or Clang on 64-bit"
-#endif
-}
-
-namespace JsonKeys {
-constexpr auto TxHash = "tx_hash";
-constexpr auto Success = "success";
-constexpr auto Error = "error";
-constexpr auto ProgramOwner = "program_owner";
-constexpr auto Balance = "balance";
-constexpr auto Nonce = "nonce";
-constexpr auto Data = "data";
-constexpr auto NullifierPublicKey = "nullifier_public_key";
-constexpr auto ViewingPublicKey = "viewing_public_key";
-constexpr auto Identifier = "identifier";
-constexpr auto AccountId = "account_id";
-constexpr auto IsPublic = "is_public";
-constexpr auto Secrets = "secrets";
-} // namespace JsonKeys
-
-bool hexToBytes(const std::string& hex, std::vector<uint8_t>& output_bytes, int expectedLength = -1) {
-    // Trim whitespace.
-    size_t start = hex.find_first_not_of(" \t\n\r\f\v");
-    if (start == std::string::npos) {
-        output_bytes.clear();
-        return expectedLength == -1 || expectedLength == 0;
-    }
-    size_t end = hex.find_last_not_of(" \t\n\r\f\v");
-    std::string trimmed = hex.substr(start, end - start + 1);
-
-    if (trimmed.size() >= 2 && trimmed[0] == '0' && (trimmed[1] == 'x' || trimmed[1] == 'X'))
-        trimmed = trimmed.substr(2);
-
-    if (trimmed.size() % 2 != 0)
-        return false;
+    WalletWriteLock(const WalletWriteLock&) = delete;
+    WalletWriteLock& operator=(const WalletWriteLock&) = delete;
 
-    std::vector<uint8_t> decoded;
-    decoded.reserve(trimmed.size() / 2);
-    auto nibble = [](char c, int& out) -> bool {
-        if (c >= '0' && c <= '9') { out = c - '0'; return true; }
-        if (c >= 'a' && c <= 'f') { out = c - 'a' + 10; return true; }
-        if (c >= 'A' && c <= 'F') { out = c - 'A' + 10; return true; }
-        return false;
-    };
-    for (size_t i = 0; i < trimmed.size(); i += 2) {
-        int hi = 0, lo = 0;
-        if (!nibble(trimmed[i], hi) || !nibble(trimmed[i + 1], lo))
-            return false;
-        decoded.push_back(static_cast<uint8_t>((hi << 4) | lo));
-    }
+    void commit() { committed = true; }
 
-    if (expectedLength != -1 && static_cast<int>(decoded.size()) != expectedLength)
-        return false;
+private:
+    std::lock_guard<RwLock> lock;
+    Autosave& autosave;
+    WalletHandle* const& walletHandle;
+    bool committed = false;
+};
 
-    output_bytes = std::move(decoded);
-    return true;
+int64_t unixTimeMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
-bool hexToU128(const std::string& hex, uint8_t (*output)[16]) {
-    std::vector<uint8_t> buffer;
-    if (!hexToBytes(hex, buffer, 16))
-        return false;
-    memcpy(output, buffer.data(), 16);
-    return true;
+// Records a submitted transaction, with the wallet's last synced block, in the journal when
+// it is open and in the account history when that is on, if the FFI returned a hash. Best
+// effort: the transaction is submitted either way. The caller holds the wallet lock.
+void recordSubmission(
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        WalletHandle* walletHandle,
+        const char* method,
+        const char* txHashHex,
+        const std::vector<FfiBytes32>& accounts,
+        const uint8_t* amount
+) {
+    const bool journal = txJournal.isOpen();
+    const bool history = accountHistory.enabled();
+    FfiBytes32 txHash{};
+    if (!txHashHex || (!journal && !history) || !hexToBytes32(txHashHex, &txHash))
+        return;
+    uint64_t submitBlock = 0;
+    if (wallet_ffi_get_last_synced_block(walletHandle, &submitBlock) != SUCCESS)
+        submitBlock = 0;
+    if (journal && !txJournal.recordSubmission(method, accounts, amount, txHash, submitBlock))
+        fprintf(stderr, "%s: could not journal the transaction\n", method);
+    if (history)
+        accountHistory.recordSubmission(method, accounts, amount, txHash, submitBlock, unixTimeMs());
+}
+
+// Balance and nonce of every wallet account. The caller holds the wallet lock.
+std::vector<BalanceTracker::Account> snapshotAccounts(WalletHandle* walletHandle, MethodMetrics::Call& call) {
+    std::vector<BalanceTracker::Account> snapshot;
+    FfiAccountList list{};
+    if (call.ffi([&] { return wallet_ffi_list_accounts(walletHandle, &list); }) != SUCCESS)
+        return snapshot;
+    snapshot.reserve(list.count);
+    for (uintptr_t i = 0; i < list.count; ++i) {
+        const FfiAccountListEntry& entry = list.entries[i];
+        FfiAccount account{};
+        const WalletFfiError error = call.ffi([&] {
+            return entry.is_public ? wallet_ffi_get_account_public(walletHandle, &entry.account_id, &account)
+                                   : wallet_ffi_get_account_private(walletHandle, &entry.account_id, &account);
+        });
+        if (error != SUCCESS)
+            continue;
+        BalanceTracker::Account& tracked = snapshot.emplace_back();
+        tracked.id = entry.account_id;
+        tracked.isPublic = entry.is_public;
+        memcpy(tracked.balance.data(), account.balance.data, 16);
+        memcpy(tracked.nonce.data(), account.nonce.data, 16);
+        wallet_ffi_free_account_data(&account);
+    }
+    wallet_ffi_free_account_list(&list);
+    return snapshot;
 }
 
-std::string bytes32ToHex(const FfiBytes32& bytes) {
-    return bytesToHex(bytes.data, 32);
+// Syncs to `block`, snapshotting the wallet's accounts around it when the account history or
+// the change events want the diff. The caller holds the wallet lock exclusively.
+int syncTracked(WalletHandle* walletHandle, BalanceTracker& balanceTracker, AccountHistory& accountHistory, MethodMetrics::Call& call, const uint64_t block) {
+    const bool tracking = accountHistory.enabled() || balanceTracker.eventsEnabled();
+    // The first tracked sync needs a baseline to compare against.
+    if (tracking && !balanceTracker.hasBaseline())
+        balanceTracker.update(snapshotAccounts(walletHandle, call), 0);
+    const int result = call.ffi([&] { return wallet_ffi_sync_to_block(walletHandle, block); });
+    if (tracking && result == SUCCESS) {
+        for (const BalanceTracker::Change& change : balanceTracker.update(snapshotAccounts(walletHandle, call), block))
+            accountHistory.recordChange(change.id, block, change.previousBalance, change.balance, change.nonce);
+    }
+    return result;
 }
 
-bool hexToBytes32(const std::string& hex, FfiBytes32* output_bytes) {
-    if (output_bytes == nullptr)
-        return false;
-    std::vector<uint8_t> buffer;
-    if (!hexToBytes(hex, buffer, 32))
-        return false;
-    memcpy(output_bytes->data, buffer.data(), 32);
-    return true;
+// Replays the journal's submissions, oldest first, into the account history after an open.
+void seedAccountHistory(const TxJournal& txJournal, AccountHistory& accountHistory) {
+    if (!accountHistory.enabled())
+        return;
+    const std::vector<TxJournal::Entry> entries = txJournal.query(nullptr, std::nullopt, txJournal.size());
+    for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+        accountHistory.recordSubmission(entry->method, entry->accounts, entry->hasAmount ? entry->amount.data() : nullptr, entry->txHash,
+                                        entry->submitBlock, entry->submittedAtMs);
+    }
+}
+
+// A foreign recipient's identifier isn't known to the sender; the recipient's wallet
+// recovers it from the encrypted transfer payload the next time it runs sync-private.
+FfiU128 randomFfiU128() {
+    FfiU128 value{};
+    SecureRandom::fill(value.data, sizeof(value.data));
+    return value;
 }
 
-// Builds JSON { success, tx_hash, error } for both success (result + empty error) and failure (nullptr + errorMessage).
-std::string transferResultToJson(const FfiTransferResult* result, const std::string& errorMessage) {
+constexpr int64_t MaxRandomIdentifiers = int64_t{1} << 20;
+constexpr size_t MaxPayoutEntries = 65536;
+
+std::string asyncStatusToJson(const int64_t ticket, const AsyncRequests::Status& status) {
     nlohmann::json obj = nlohmann::json::object();
-    const bool isError = !errorMessage.empty();
-    obj[JsonKeys::Success] = !isError && result && result->success;
-    obj[JsonKeys::TxHash] = (!isError && result && result->tx_hash) ? std::string(result->tx_hash) : std::string();
-    obj[JsonKeys::Error] = errorMessage;
+    obj[JsonKeys::Ticket] = ticket;
+    switch (status.state) {
+    case AsyncRequests::State::Pending:
+        obj[JsonKeys::Status] = "pending";
+        break;
+    case AsyncRequests::State::Done:
+        obj[JsonKeys::Status] = "done";
+        break;
+    case AsyncRequests::State::Unknown:
+    default:
+        obj[JsonKeys::Status] = "unknown";
+        break;
+    }
+    obj[JsonKeys::Method] = status.method;
+    obj[JsonKeys::Result] = status.result;
     return obj.dump();
 }
 
-// Builds JSON { success, tx_hash, secrets, error } for both success (result + empty error) and failure (nullptr + errorMessage) in case of generic transaction.
-std::string genericTransactionResultToJson(const FfiTransactionResult* result, const std::string& errorMessage) {
-    nlohmann::json obj = nlohmann::json::object();
-    const bool isError = !errorMessage.empty();
-    obj[JsonKeys::Success] = !isError && result && result->success;
-    obj[JsonKeys::TxHash] = (!isError && result && result->tx_hash) ? std::string(result->tx_hash) : std::string();
-    std::vector<std::string> secrets;
-    if (!isError && result && result->secrets_data) {
-        for (uintptr_t i = 0; i < result->secrets_size; ++i) {
-            secrets.push_back(bytes32ToHex(result->secrets_data[i]));
-        }
+const char* txStateToString(const TxWatcher::State state) {
+    switch (state) {
+    case TxWatcher::State::Confirmed:
+        return "confirmed";
+    case TxWatcher::State::TimedOut:
+        return "timed_out";
+    case TxWatcher::State::Pending:
+    default:
+        return "pending";
     }
-    obj[JsonKeys::Secrets] = secrets;
-    obj[JsonKeys::Error] = errorMessage;
-    return obj.dump();
 }
 
-std::string ffiAccountToJson(const FfiAccount& account) {
-    nlohmann::json obj = nlohmann::json::object();
-    obj[JsonKeys::ProgramOwner] = bytesToHex(reinterpret_cast<const uint8_t*>(account.program_owner.data), 32);
-    obj[JsonKeys::Balance] = bytesToHex(account.balance.data, 16);
-    obj[JsonKeys::Nonce] = bytesToHex(account.nonce.data, 16);
-    if (account.data && account.data_len > 0) {
-        obj[JsonKeys::Data] = bytesToHex(account.data, account.data_len);
-    } else {
-        obj[JsonKeys::Data] = "";
+const char* journalStatusToString(const TxJournal::Status status) {
+    switch (status) {
+    case TxJournal::Status::Confirmed:
+        return "confirmed";
+    case TxJournal::Status::TimedOut:
+        return "timed_out";
+    case TxJournal::Status::Pending:
+    default:
+        return "pending";
     }
-    return obj.dump();
 }
 
-nlohmann::json ffiAccountListEntryToJson(const FfiAccountListEntry& entry) {
-    nlohmann::json obj = nlohmann::json::object();
-    obj[JsonKeys::AccountId] = bytes32ToHex(entry.account_id);
-    obj[JsonKeys::IsPublic] = entry.is_public;
-    return obj;
+bool journalStatusFromString(const std::string& name, TxJournal::Status* out) {
+    for (const TxJournal::Status status : {TxJournal::Status::Pending, TxJournal::Status::Confirmed, TxJournal::Status::TimedOut}) {
+        if (name == journalStatusToString(status)) {
+            *out = status;
+            return true;
+        }
+    }
+    return false;
 }
 
-std::string ffiPrivateAccountKeysToJson(const FfiPrivateAccountKeys& keys) {
-    nlohmann::json obj = nlohmann::json::object();
-    obj[JsonKeys::NullifierPublicKey] = bytes32ToHex(keys.nullifier_public_key);
-    if (keys.viewing_public_key && keys.viewing_public_key_len > 0) {
-        obj[JsonKeys::ViewingPublicKey] = bytesToHex(keys.viewing_public_key, keys.viewing_public_key_len);
-    } else {
-        obj[JsonKeys::ViewingPublicKey] = "";
+constexpr int64_t MaxJournalQueryLimit = 1000;
+constexpr int64_t MaxHistoryPageSize = 1000;
+
+const char* syncStateToString(const SyncEngine::State state) {
+    switch (state) {
+    case SyncEngine::State::Running:
+        return "running";
+    case SyncEngine::State::Done:
+        return "done";
+    case SyncEngine::State::Cancelled:
+        return "cancelled";
+    case SyncEngine::State::Failed:
+        return "failed";
+    case SyncEngine::State::Idle:
+    default:
+        return "idle";
     }
+}
+
+std::string txStatusToJson(const std::string& txHash, const std::string& status) {
+    nlohmann::json obj = nlohmann::json::object();
+    obj[JsonKeys::TxHash] = txHash;
+    obj[JsonKeys::Status] = status;
     return obj.dump();
 }
 
-// Nothing in this codebase currently emits an "identifier" field in to_keys_json — NPK/VPK
-// identify a key group, not one specific account in it, so get_private_account_keys never
-// attaches one. Kept for forward compatibility (e.g. a hand-crafted or future payload that
-// targets one specific account within a group) and to make the fallback below explicit.
-bool jsonExtractIdentifier(const std::string& json, FfiU128* out_identifier) {
-    nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
-    if (doc.is_discarded() || !doc.is_object())
-        return false;
-    if (!doc.contains(JsonKeys::Identifier) || !doc[JsonKeys::Identifier].is_string())
-        return false;
-    std::vector<uint8_t> buffer;
-    if (!hexToBytes(doc[JsonKeys::Identifier].get<std::string>(), buffer, 16))
-        return false;
-    memcpy(out_identifier->data, buffer.data(), 16);
-    return true;
+// Waits for a proving slot: *_async jobs queue behind callers blocked on the call. The wait
+// shows up in get_metrics as "proving_wait".
+ProvingScheduler::Slot admitProof(ProvingScheduler& scheduler, MethodMetrics& metrics) {
+    MethodMetrics::Call wait(metrics, "proving_wait");
+    return scheduler.acquire(AsyncRequests::runningJob() ? ProvingScheduler::Priority::Background
+                                                         : ProvingScheduler::Priority::Interactive);
 }
 
-// A foreign recipient's identifier isn't known to the sender; the recipient's wallet
-// recovers it from the encrypted transfer payload the next time it runs sync-private.
-FfiU128 randomFfiU128() {
-    static std::mt19937_64 rng(std::random_device{}());
-    FfiU128 value{};
-    for (int i = 0; i < 16; i += 8) {
-        uint64_t chunk = rng();
-        memcpy(value.data + i, &chunk, sizeof(chunk));
+// wallet_ffi_transfer_shielded / wallet_ffi_transfer_private to an already-parsed recipient.
+// The caller holds the wallet's lock exclusively.
+WalletFfiError submitToRecipient(
+        WalletHandle* walletHandle,
+        MethodMetrics::Call& call,
+        const bool shielded,
+        const FfiBytes32& fromId,
+        const RecipientBook::Recipient& to,
+        const uint8_t (&amount)[16],
+        FfiTransferResult* result
+) {
+    // to_keys_json normally carries no identifier (NPK/VPK name a key group, not one account
+    // in it) — pick a random one, which the recipient's wallet will recover from the encrypted
+    // transfer payload on its next sync-private.
+    const FfiU128 toIdentifier = to.hasIdentifier ? to.identifier : randomFfiU128();
+    // ToDo: Add keycard support
+    const char *key_path = nullptr;
+
+    return call.ffi([&] {
+        return shielded ? wallet_ffi_transfer_shielded(walletHandle, &fromId, &to.keys, &toIdentifier, &amount, key_path, result)
+                        : wallet_ffi_transfer_private(walletHandle, &fromId, &to.keys, &toIdentifier, &amount, result);
+    });
+}
+
+// transfer_shielded / transfer_private to an already-parsed recipient, under the caller's
+// exclusive `lock`.
+std::string transferToRecipient(
+        WalletWriteLock& lock,
+        WalletHandle* walletHandle,
+        AccountReadCache& readCache,
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        MethodMetrics::Call& call,
+        const char* method,
+        const bool shielded,
+        const FfiBytes32& fromId,
+        const RecipientBook::Recipient& to,
+        const uint8_t (&amount)[16]
+) {
+    FfiTransferResult result{};
+    const WalletFfiError error = submitToRecipient(walletHandle, call, shielded, fromId, to, amount, &result);
+    readCache.invalidate(fromId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "%s: wallet FFI error %d\n", method, error);
+        return transferResultToJson(nullptr, std::string(method) + ": wallet FFI error " + std::to_string(error));
     }
-    return value;
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, method, result.tx_hash, {fromId}, amount);
+    std::string resultJson = transferResultToJson(&result, std::string());
+    wallet_ffi_free_transfer_result(&result);
+    return resultJson;
 }
 
-bool jsonToFfiPrivateAccountKeys(const std::string& json, FfiPrivateAccountKeys* output_keys) {
-    nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
-    if (doc.is_discarded() || !doc.is_object())
-        return false;
+// The transfers from one of the wallet's accounts to an account id.
+enum class AccountTransfer { Public, Deshielded, ShieldedOwned, PrivateOwned };
+
+// Body of transfer_public / transfer_deshielded / transfer_shielded_owned /
+// transfer_private_owned and their *_decimal forms once the amount is parsed; `method` names
+// the public method in errors and records. All but public transfers wait for a proving slot
+// before taking the wallet lock.
+std::string transferBetweenAccounts(
+        RwLock& walletMutex,
+        Autosave& autosave,
+        WalletHandle* const& walletHandle,
+        AccountReadCache& readCache,
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        ProvingScheduler& walletProving,
+        MethodMetrics& metrics,
+        MethodMetrics::Call& call,
+        const char* method,
+        const AccountTransfer kind,
+        const std::string& from_hex,
+        const std::string& to_hex,
+        const uint8_t (&amount)[16]
+) {
+    FfiBytes32 fromId{}, toId{};
+    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
+        fprintf(stderr, "%s: invalid account id hex\n", method);
+        return transferResultToJson(nullptr, std::string(method) + ": invalid account id hex");
+    }
 
-    // Nullifier public key is mandatory: a missing/wrong-typed value must not fall back to zero.
-    if (!doc.contains(JsonKeys::NullifierPublicKey) || !doc[JsonKeys::NullifierPublicKey].is_string())
-        return false;
-    if (!hexToBytes32(doc[JsonKeys::NullifierPublicKey].get<std::string>(), &output_keys->nullifier_public_key))
-        return false;
+    ProvingScheduler::Slot proving;
+    if (kind != AccountTransfer::Public) {
+        proving = admitProof(walletProving, metrics);
+        if (!proving) {
+            fprintf(stderr, "%s: proving queue full\n", method);
+            return transferResultToJson(nullptr, std::string(method) + ": proving queue full");
+        }
+    }
+    // ToDo: Add keycard support
+    const char *key_path = nullptr;
+
+    FfiTransferResult result{};
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] {
+        switch (kind) {
+        case AccountTransfer::Public:
+            return wallet_ffi_transfer_public(walletHandle, &fromId, &toId, &amount, &result);
+        case AccountTransfer::Deshielded:
+            return wallet_ffi_transfer_deshielded(walletHandle, &fromId, &toId, &amount, &result);
+        case AccountTransfer::ShieldedOwned:
+            return wallet_ffi_transfer_shielded_owned(walletHandle, &fromId, &toId, &amount, key_path, &result);
+        case AccountTransfer::PrivateOwned:
+            return wallet_ffi_transfer_private_owned(walletHandle, &fromId, &toId, &amount, &result);
+        }
+        return INTERNAL_ERROR;
+    });
+    readCache.invalidate(fromId);
+    readCache.invalidate(toId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "%s: wallet FFI error %d\n", method, error);
+        return transferResultToJson(nullptr, std::string(method) + ": wallet FFI error " + std::to_string(error));
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, method, result.tx_hash, {fromId, toId}, amount);
+    std::string resultJson = transferResultToJson(&result, std::string());
+    wallet_ffi_free_transfer_result(&result);
+    return resultJson;
+}
+
+// Body of transfer_shielded / transfer_private and their *_decimal forms once the amount is
+// parsed.
+std::string transferToKeys(
+        RwLock& walletMutex,
+        Autosave& autosave,
+        WalletHandle* const& walletHandle,
+        AccountReadCache& readCache,
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        ProvingScheduler& walletProving,
+        MethodMetrics& metrics,
+        MethodMetrics::Call& call,
+        const char* method,
+        const bool shielded,
+        const std::string& from_hex,
+        const std::string& to_keys_json,
+        const uint8_t (&amount)[16]
+) {
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId)) {
+        fprintf(stderr, "%s: invalid from account id hex\n", method);
+        return transferResultToJson(nullptr, std::string(method) + ": invalid from account id hex");
+    }
 
-    output_keys->viewing_public_key = nullptr;
-    output_keys->viewing_public_key_len = 0;
+    const RecipientBook::Entry to = RecipientBook::parse(to_keys_json);
+    if (!to) {
+        fprintf(stderr, "%s: failed to parse to_keys_json\n", method);
+        return transferResultToJson(nullptr, std::string(method) + ": failed to parse to_keys_json");
+    }
 
-    if (doc.contains(JsonKeys::ViewingPublicKey)) {
-        if (!doc[JsonKeys::ViewingPublicKey].is_string())
-            return false;
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "%s: proving queue full\n", method);
+        return transferResultToJson(nullptr, std::string(method) + ": proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return transferToRecipient(lock, walletHandle, readCache, txJournal, accountHistory, call, method, shielded, fromId, *to, amount);
+}
 
-        std::vector<uint8_t> buffer;
-        if (!hexToBytes(doc[JsonKeys::ViewingPublicKey].get<std::string>(), buffer))
-            return false;
+// Body of vault_claim / vault_claim_private and their *_decimal forms once the amount is
+// parsed; the private claim waits for a proving slot.
+std::string vaultClaim(
+        RwLock& walletMutex,
+        Autosave& autosave,
+        WalletHandle* const& walletHandle,
+        AccountReadCache& readCache,
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        ProvingScheduler& walletProving,
+        MethodMetrics& metrics,
+        MethodMetrics::Call& call,
+        const char* method,
+        const bool isPrivate,
+        const std::string& owner_account_id_hex,
+        const uint8_t (&amount)[16]
+) {
+    FfiBytes32 ownerId{};
+    if (!hexToBytes32(owner_account_id_hex, &ownerId)) {
+        fprintf(stderr, "%s: invalid owner_account_id_hex\n", method);
+        return transferResultToJson(nullptr, std::string(method) + ": invalid owner_account_id_hex");
+    }
 
-        if (!buffer.empty()) {
-            auto* data = static_cast<uint8_t*>(malloc(buffer.size()));
-            if (!data)
-                return false;
-            memcpy(data, buffer.data(), buffer.size());
-            output_keys->viewing_public_key = data;
-            output_keys->viewing_public_key_len = buffer.size();
+    ProvingScheduler::Slot proving;
+    if (isPrivate) {
+        proving = admitProof(walletProving, metrics);
+        if (!proving) {
+            fprintf(stderr, "%s: proving queue full\n", method);
+            return transferResultToJson(nullptr, std::string(method) + ": proving queue full");
         }
     }
 
-    return true;
+    FfiTransferResult result{};
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] {
+        return isPrivate ? wallet_ffi_vault_claim_private(walletHandle, &ownerId, &amount, &result)
+                         : wallet_ffi_vault_claim(walletHandle, &ownerId, &amount, &result);
+    });
+    readCache.invalidate(ownerId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "%s: wallet FFI error %d\n", method, error);
+        return transferResultToJson(nullptr, std::string(method) + ": wallet FFI error " + std::to_string(error));
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, method, result.tx_hash, {ownerId}, amount);
+    std::string resultJson = transferResultToJson(&result, std::string());
+    wallet_ffi_free_transfer_result(&result);
+    return resultJson;
 }
 
-// Parses a JSON array of 32-byte hex strings into a contiguous byte buffer of siblings.
-// Returns true on success, with out_len set to the number of siblings and out_bytes sized to out_len*32.
-bool jsonArrayHexToSiblings32(const std::string& json_array_str, std::vector<uint8_t>& out_bytes, uintptr_t& out_len) {
-    nlohmann::json doc = nlohmann::json::parse(json_array_str, nullptr, false);
-    if (doc.is_discarded() || !doc.is_array())
-        return false;
+// Shared tail of the managed_* transfers: formats `result` and records the submission. The
+// caller holds the managed wallet's lock exclusively. Managed wallets skip the read cache and
+// the balance tracker, which both follow the module's own wallet.
+std::string finishManagedTransfer(
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        WalletHandle* walletHandle,
+        const char* method,
+        const WalletFfiError error,
+        FfiTransferResult& result,
+        const std::vector<FfiBytes32>& accounts,
+        const uint8_t* amount
+) {
+    if (error != SUCCESS) {
+        fprintf(stderr, "%s: wallet FFI error %d\n", method, error);
+        return transferResultToJson(nullptr, std::string(method) + ": wallet FFI error " + std::to_string(error));
+    }
+    recordSubmission(txJournal, accountHistory, walletHandle, method, result.tx_hash, accounts, amount);
+    std::string resultJson = transferResultToJson(&result, std::string());
+    wallet_ffi_free_transfer_result(&result);
+    return resultJson;
+}
+
+// Resolves a private account's identity through the cache, so each one reaches wallet_ffi
+// once per open wallet. The caller holds the wallet lock (shared is enough).
+WalletFfiError resolvePrivateIdentity(
+        WalletHandle* walletHandle,
+        IdentityCache& identityCache,
+        MethodMetrics::Call& call,
+        const FfiBytes32& id,
+        IdentityCache::Identity* out
+) {
+    IdentityCache::Identity identity = identityCache.get(id);
+    if (!identity) {
+        FfiAccountIdentity resolved{};
+        const WalletFfiError error = call.ffi([&] { return wallet_ffi_resolve_private_account(walletHandle, id, &resolved); });
+        if (error != SUCCESS)
+            return error;
+        identity = identityCache.put(id, resolved);
+    }
+    if (out)
+        *out = std::move(identity);
+    return SUCCESS;
+}
+
+// Shared tail of the generic private transaction methods: resolves `account_ids`, submits
+// `program_with_dependencies` and formats the result, under the caller's exclusive `lock`.
+std::string sendGenericPrivateTransaction(
+        WalletWriteLock& lock,
+        WalletHandle* walletHandle,
+        AccountReadCache& readCache,
+        IdentityCache& identityCache,
+        TxJournal& txJournal,
+        AccountHistory& accountHistory,
+        MethodMetrics::Call& call,
+        const char* method,
+        const std::vector<std::string>& account_ids,
+        const std::vector<uint32_t>& instruction,
+        const FfiProgramWithDependencies& program_with_dependencies
+) {
+    // The cache owns the identities; `held` keeps them alive until the call returns.
+    std::vector<IdentityCache::Identity> held;
+    held.reserve(account_ids.size());
+    std::vector<FfiAccountIdentity> identities_resolved;
+    identities_resolved.reserve(account_ids.size());
+    std::vector<FfiBytes32> touched_ids;
+    touched_ids.reserve(account_ids.size());
+
+    for (int i = 0; i < account_ids.size(); ++i) {
+        FfiBytes32 id{};
+        if (!hexToBytes32(account_ids[i], &id)) {
+            fprintf(stderr, "wallet_ffi_resolve_private_account: invalid account_id_hex");
+            return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_private_account: invalid account_id_hex"));
+        }
+
+        IdentityCache::Identity identity;
+        const WalletFfiError error = resolvePrivateIdentity(walletHandle, identityCache, call, id, &identity);
+        if (error != SUCCESS) {
+            fprintf(stderr, "wallet_ffi_resolve_private_account failed for index %d: wallet FFI error %d\n", i, error);
+            return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_private_account: wallet FFI error ") + std::to_string(error));
+        }
+        identities_resolved.push_back(*identity);
+        held.push_back(std::move(identity));
+        touched_ids.push_back(id);
+    }
+
+    FfiTransactionResult result {};
+
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_send_generic_private_transaction(
+        walletHandle,
+        identities_resolved.data(),
+        static_cast<uintptr_t>(identities_resolved.size()),
+        instruction.data(),
+        static_cast<uintptr_t>(instruction.size()),
+        &program_with_dependencies,
+        &result
+    ); });
 
-    out_len = static_cast<uintptr_t>(doc.size());
-    out_bytes.clear();
-    out_bytes.reserve(out_len * 32);
+    for (const FfiBytes32& touched_id : touched_ids) {
+        readCache.invalidate(touched_id);
+    }
 
-    for (const auto& v : doc) {
-        if (!v.is_string())
-            return false;
-        std::vector<uint8_t> bytes;
-        if (!hexToBytes(v.get<std::string>(), bytes, 32))
-            return false;
-        out_bytes.insert(out_bytes.end(), bytes.begin(), bytes.end());
+    if (error != SUCCESS) {
+        fprintf(stderr, "%s: wallet FFI error %d\n", method, error);
+        return transferResultToJson(nullptr, std::string(method) + ": wallet FFI error " + std::to_string(error));
     }
-    return true;
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, method, result.tx_hash, touched_ids, nullptr);
+    std::string resultJson = genericTransactionResultToJson(&result, std::string());
+    wallet_ffi_free_transaction_result(&result);
+    return resultJson;
+}
+
+WalletFfiError fetchBuiltinElf(const BuiltinElfs::Program program, FfiProgram* out) {
+    switch (program) {
+    case BuiltinElfs::Program::AuthenticatedTransfer:
+        return wallet_ffi_transfer_elf(out);
+    case BuiltinElfs::Program::Token:
+        return wallet_ffi_token_elf(out);
+    case BuiltinElfs::Program::Amm:
+        return wallet_ffi_amm_elf(out);
+    case BuiltinElfs::Program::Ata:
+    default:
+        return wallet_ffi_ata_elf(out);
+    }
+}
+
+// The API hands ELFs out by value, so this copy of the shared buffer is the one left.
+std::vector<uint8_t> elfToBytes(const BuiltinElfs::Elf& elf) {
+    if (!elf)
+        return {};
+    return std::vector<uint8_t>(elf->elf_data, elf->elf_data + elf->elf_size);
 }
 
 } // namespace
 
-LEZCoreModule::LEZCoreModule() = default;
+LEZCoreModule::LEZCoreModule()
+    : builtinElfs([this](const BuiltinElfs::Program program, FfiProgram* out) {
+          MethodMetrics::Call call(metrics, "builtin_elf_fetch");
+          const WalletFfiError error = call.ffi([&] { return fetchBuiltinElf(program, out); });
+          if (error != SUCCESS)
+              fprintf(stderr, "%s_elf: wallet FFI error %d\n", BuiltinElfs::name(program), error);
+          return error;
+      }),
+      txJournal([this](const FfiBytes32& hash) {
+          txWatcher.watch(bytes32ToHex(hash), hash, TxJournal::TrackingTimeout);
+      }),
+      txWatcher(
+          [this](const std::vector<FfiBytes32>& hashes, std::vector<std::optional<bool>>& found) {
+              // One lock acquisition for the whole batch of due hashes.
+              MethodMetrics::Call call(metrics, "tx_watcher_poll_batch");
+              std::shared_lock lock(walletMutex);
+              for (size_t i = 0; i < hashes.size(); ++i) {
+                  bool is_found = false;
+                  const WalletFfiError error = call.ffi([&] { return wallet_ffi_poll_transaction_status(walletHandle, hashes[i], &is_found); });
+                  if (error != SUCCESS) {
+                      fprintf(stderr, "tx watcher: wallet FFI error %d\n", error);
+                      continue;
+                  }
+                  found[i] = is_found;
+              }
+          },
+          [this](const TxWatcher::Event& event) {
+              FfiBytes32 hash{};
+              if (event.state == TxWatcher::State::Pending || !hexToBytes32(event.txHash, &hash))
+                  return;
+              txJournal.recordStatus(hash, event.state == TxWatcher::State::Confirmed ? TxJournal::Status::Confirmed : TxJournal::Status::TimedOut);
+          }),
+      syncEngine({
+          [this](uint64_t& block) {
+              std::shared_lock lock(walletMutex);
+              return static_cast<int>(wallet_ffi_get_last_synced_block(walletHandle, &block));
+          },
+          [this](uint64_t& height) {
+              std::shared_lock lock(walletMutex);
+              return static_cast<int>(wallet_ffi_get_current_block_height(walletHandle, &height));
+          },
+          [this](const uint64_t block) {
+              // One chunk per exclusive hold; readers queued meanwhile go before the next one.
+              MethodMetrics::Call call(metrics, "background_sync_chunk");
+              WalletWriteLock lock(walletMutex, autosave, walletHandle);
+              const int result = syncTracked(walletHandle, balanceTracker, accountHistory, call, block);
+              if (result == SUCCESS)
+                  lock.commit();
+              readCache.clear();
+              return result;
+          },
+      }),
+      proverWarmup({
+          BuiltinElfs::ProgramCount,
+          [this](const size_t index) {
+              return builtinElfs.get(static_cast<BuiltinElfs::Program>(index)) ? static_cast<int>(SUCCESS) : static_cast<int>(INTERNAL_ERROR);
+          },
+          [this](std::vector<FfiBytes32>& ids) {
+              FfiAccountList list{};
+              std::shared_lock lock(walletMutex);
+              const WalletFfiError error = wallet_ffi_list_accounts(walletHandle, &list);
+              if (error != SUCCESS)
+                  return static_cast<int>(error);
+              for (uintptr_t i = 0; i < list.count; ++i) {
+                  if (!list.entries[i].is_public)
+                      ids.push_back(list.entries[i].account_id);
+              }
+              wallet_ffi_free_account_list(&list);
+              return static_cast<int>(SUCCESS);
+          },
+          [this](const FfiBytes32& id) {
+              MethodMetrics::Call call(metrics, "prover_warmup_resolve");
+              std::shared_lock lock(walletMutex);
+              return static_cast<int>(resolvePrivateIdentity(walletHandle, identityCache, call, id, nullptr));
+          },
+      }),
+      autosave([this] {
+          std::lock_guard lock(walletMutex);
+          const int error = wallet_ffi_save(walletHandle);
+          if (error != SUCCESS)
+              fprintf(stderr, "autosave: wallet FFI error %d\n", error);
+          return error;
+      }) {}
 
 LEZCoreModule::~LEZCoreModule() {
+    // Stop background work while the handle is still alive; queued submissions still finish.
+    proverWarmup.stop();
+    syncEngine.stop();
+    txWatcher.stop();
+    asyncRequests.shutdown();
+    // Last: the jobs drained above may have left changes behind.
+    autosave.stop();
     if (walletHandle) {
         wallet_ffi_destroy(walletHandle);
         walletHandle = nullptr;
@@ -286,29 +680,37 @@ std::string LEZCoreModule::version() const {
 // === Account Management ===
 
 std::string LEZCoreModule::create_account_public() {
+    MethodMetrics::Call call(metrics, "create_account_public");
     FfiBytes32 id{};
-    const WalletFfiError error = wallet_ffi_create_account_public(walletHandle, &id);
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_create_account_public(walletHandle, &id); });
     if (error != SUCCESS) {
         fprintf(stderr, "create_account_public: wallet FFI error %d\n", error);
         return {};
     }
+    lock.commit();
     return bytes32ToHex(id);
 }
 
 std::string LEZCoreModule::create_account_private() {
+    MethodMetrics::Call call(metrics, "create_account_private");
     FfiBytes32 id{};
-    const WalletFfiError error = wallet_ffi_create_account_private(walletHandle, &id);
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_create_account_private(walletHandle, &id); });
     if (error != SUCCESS) {
         fprintf(stderr, "create_account_private: wallet FFI error %d\n", error);
         return {};
     }
+    lock.commit();
     return bytes32ToHex(id);
 }
 
 LogosList LEZCoreModule::list_accounts() {
+    MethodMetrics::Call call(metrics, "list_accounts");
     LogosList result = nlohmann::json::array();
     FfiAccountList list{};
-    const WalletFfiError error = wallet_ffi_list_accounts(walletHandle, &list);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_list_accounts(walletHandle, &list); });
     if (error != SUCCESS) {
         fprintf(stderr, "list_accounts: wallet FFI error %d\n", error);
         return result;
@@ -323,64 +725,132 @@ LogosList LEZCoreModule::list_accounts() {
 // === Account Queries ===
 
 std::string LEZCoreModule::get_balance(const std::string& account_id_hex, const bool is_public) {
+    MethodMetrics::Call call(metrics, "get_balance");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "get_balance: invalid account_id_hex\n");
         return {};
     }
 
+    if (auto cached = readCache.get(id, !is_public, AccountReadCache::Field::Balance))
+        return *cached;
+
     uint8_t balance[16] = {0};
-    const WalletFfiError error = wallet_ffi_get_balance(walletHandle, &id, is_public, &balance);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_balance(walletHandle, &id, is_public, &balance); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_balance: wallet FFI error %d\n", error);
         return {};
     }
     // Return decimal string for UI display (balance is 16-byte little-endian u128).
-    return balanceLe16ToDecimalString(balance);
+    std::string result = balanceLe16ToDecimalString(balance);
+    readCache.put(id, !is_public, AccountReadCache::Field::Balance, result);
+    return result;
+}
+
+LogosList LEZCoreModule::get_balances(const std::vector<std::string>& account_ids, const std::vector<bool>& is_public) {
+    MethodMetrics::Call call(metrics, "get_balances");
+    LogosList result = nlohmann::json::array();
+    if (account_ids.size() != is_public.size()) {
+        fprintf(stderr, "get_balances: account_ids and is_public must have the same length\n");
+        return result;
+    }
+
+    // One id / balance buffer for the whole batch; each entry only rewrites them.
+    FfiBytes32 id{};
+    uint8_t balance[16] = {0};
+    std::shared_lock lock(walletMutex);
+    for (size_t i = 0; i < account_ids.size(); ++i) {
+        nlohmann::json entry = nlohmann::json::object();
+        entry[JsonKeys::AccountId] = account_ids[i];
+        entry[JsonKeys::IsPublic] = static_cast<bool>(is_public[i]);
+
+        if (!hexToBytes32(account_ids[i], &id)) {
+            entry[JsonKeys::Balance] = "";
+            entry[JsonKeys::Error] = "get_balances: invalid account_id_hex";
+            result.push_back(std::move(entry));
+            continue;
+        }
+
+        if (auto cached = readCache.get(id, !is_public[i], AccountReadCache::Field::Balance)) {
+            entry[JsonKeys::Balance] = *cached;
+            entry[JsonKeys::Error] = "";
+            result.push_back(std::move(entry));
+            continue;
+        }
+
+        const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_balance(walletHandle, &id, is_public[i], &balance); });
+        if (error != SUCCESS) {
+            fprintf(stderr, "get_balances: wallet FFI error %d for index %zu\n", error, i);
+            entry[JsonKeys::Balance] = "";
+            entry[JsonKeys::Error] = "get_balances: wallet FFI error " + std::to_string(error);
+        } else {
+            std::string decimal = balanceLe16ToDecimalString(balance);
+            readCache.put(id, !is_public[i], AccountReadCache::Field::Balance, decimal);
+            entry[JsonKeys::Balance] = std::move(decimal);
+            entry[JsonKeys::Error] = "";
+        }
+        result.push_back(std::move(entry));
+    }
+    return result;
 }
 
 std::string LEZCoreModule::get_account_public(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "get_account_public");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "get_account_public: invalid account_id_hex\n");
         return {};
     }
+    if (auto cached = readCache.get(id, false, AccountReadCache::Field::Account))
+        return *cached;
+
     FfiAccount account{};
-    const WalletFfiError error = wallet_ffi_get_account_public(walletHandle, &id, &account);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_public(walletHandle, &id, &account); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_account_public: wallet FFI error %d\n", error);
         return {};
     }
     std::string result = ffiAccountToJson(account);
     wallet_ffi_free_account_data(&account);
+    readCache.put(id, false, AccountReadCache::Field::Account, result);
     return result;
 }
 
 std::string LEZCoreModule::get_account_private(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "get_account_private");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "get_account_private: invalid account_id_hex\n");
         return {};
     }
+    if (auto cached = readCache.get(id, true, AccountReadCache::Field::Account))
+        return *cached;
+
     FfiAccount account{};
-    const WalletFfiError error = wallet_ffi_get_account_private(walletHandle, &id, &account);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_private(walletHandle, &id, &account); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_account_private: wallet FFI error %d\n", error);
         return {};
     }
     std::string result = ffiAccountToJson(account);
     wallet_ffi_free_account_data(&account);
+    readCache.put(id, true, AccountReadCache::Field::Account, result);
     return result;
 }
 
 std::string LEZCoreModule::get_public_account_key(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "get_public_account_key");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "get_public_account_key: invalid account_id_hex\n");
         return {};
     }
     FfiPublicAccountKey key{};
-    const WalletFfiError error = wallet_ffi_get_public_account_key(walletHandle, &id, &key);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_public_account_key(walletHandle, &id, &key); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_public_account_key: wallet FFI error %d\n", error);
         return {};
@@ -389,13 +859,15 @@ std::string LEZCoreModule::get_public_account_key(const std::string& account_id_
 }
 
 std::string LEZCoreModule::get_private_account_keys(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "get_private_account_keys");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "get_private_account_keys: invalid account_id_hex\n");
         return {};
     }
     FfiPrivateAccountKeys keys{};
-    const WalletFfiError error = wallet_ffi_get_private_account_keys(walletHandle, &id, &keys);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_private_account_keys(walletHandle, &id, &keys); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_private_account_keys: wallet FFI error %d\n", error);
         return {};
@@ -413,13 +885,14 @@ std::string LEZCoreModule::get_private_account_keys(const std::string& account_i
 // === Account Encoding ===
 
 std::string LEZCoreModule::account_id_to_base58(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "account_id_to_base58");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "account_id_to_base58: invalid account_id_hex\n");
         return {};
     }
 
-    char* str = wallet_ffi_account_id_to_base58(&id);
+    char* str = call.ffi([&] { return wallet_ffi_account_id_to_base58(&id); });
     if (!str) {
         fprintf(stderr, "account_id_to_base58: wallet_ffi returned null\n");
         return {};
@@ -431,8 +904,9 @@ std::string LEZCoreModule::account_id_to_base58(const std::string& account_id_he
 }
 
 std::string LEZCoreModule::account_id_from_base58(const std::string& base58_str) {
+    MethodMetrics::Call call(metrics, "account_id_from_base58");
     FfiBytes32 id{};
-    const WalletFfiError error = wallet_ffi_account_id_from_base58(base58_str.c_str(), &id);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_account_id_from_base58(base58_str.c_str(), &id); });
     if (error != SUCCESS) {
         fprintf(stderr, "account_id_from_base58: wallet FFI error %d\n", error);
         return {};
@@ -443,22 +917,34 @@ std::string LEZCoreModule::account_id_from_base58(const std::string& base58_str)
 // === Blockchain Synchronisation ===
 
 int64_t LEZCoreModule::sync_to_block(const int64_t block_id) {
-    return wallet_ffi_sync_to_block(walletHandle, static_cast<uint64_t>(block_id));
+    MethodMetrics::Call call(metrics, "sync_to_block");
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const int result = syncTracked(walletHandle, balanceTracker, accountHistory, call, static_cast<uint64_t>(block_id));
+    if (result == SUCCESS)
+        lock.commit();
+    // Any cached balance/account may have moved with the newly synced blocks.
+    readCache.clear();
+    return result;
 }
 
 int64_t LEZCoreModule::get_last_synced_block() {
+    MethodMetrics::Call call(metrics, "get_last_synced_block");
     uint64_t block_id = 0;
-    const WalletFfiError error = wallet_ffi_get_last_synced_block(walletHandle, &block_id);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_last_synced_block(walletHandle, &block_id); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_last_synced_block: wallet FFI error %d\n", error);
         return 0;
     }
+    readCache.observeSyncedBlock(block_id);
     return static_cast<int64_t>(block_id);
 }
 
 int64_t LEZCoreModule::get_current_block_height() {
+    MethodMetrics::Call call(metrics, "get_current_block_height");
     uint64_t block_height = 0;
-    const WalletFfiError error = wallet_ffi_get_current_block_height(walletHandle, &block_height);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_current_block_height(walletHandle, &block_height); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_current_block_height: wallet FFI error %d\n", error);
         return 0;
@@ -466,6 +952,34 @@ int64_t LEZCoreModule::get_current_block_height() {
     return static_cast<int64_t>(block_height);
 }
 
+bool LEZCoreModule::start_background_sync(const int64_t target_block, const int64_t chunk_size) {
+    MethodMetrics::Call call(metrics, "start_background_sync");
+    if (!syncEngine.start(static_cast<uint64_t>(std::max<int64_t>(0, target_block)),
+                          static_cast<uint64_t>(std::max<int64_t>(0, chunk_size)))) {
+        fprintf(stderr, "start_background_sync: a background sync is already running\n");
+        return false;
+    }
+    return true;
+}
+
+std::string LEZCoreModule::get_sync_progress() {
+    MethodMetrics::Call call(metrics, "get_sync_progress");
+    const SyncEngine::Progress progress = syncEngine.progress();
+    nlohmann::json obj = nlohmann::json::object();
+    obj[JsonKeys::State] = syncStateToString(progress.state);
+    obj[JsonKeys::StartBlock] = progress.startBlock;
+    obj[JsonKeys::CurrentBlock] = progress.currentBlock;
+    obj[JsonKeys::TargetBlock] = progress.targetBlock;
+    obj[JsonKeys::BlocksPerSecond] = progress.blocksPerSecond;
+    obj[JsonKeys::Error] = progress.error;
+    return obj.dump();
+}
+
+bool LEZCoreModule::cancel_background_sync() {
+    MethodMetrics::Call call(metrics, "cancel_background_sync");
+    return syncEngine.cancel();
+}
+
 // === Pinata claiming ===
 
 std::string LEZCoreModule::claim_pinata(
@@ -473,6 +987,7 @@ std::string LEZCoreModule::claim_pinata(
     const std::string& winner_account_id_hex,
     const std::string& solution_le16_hex
 ) {
+    MethodMetrics::Call call(metrics, "claim_pinata");
     FfiBytes32 pinataId{}, winnerId{};
     if (!hexToBytes32(pinata_account_id_hex, &pinataId) || !hexToBytes32(winner_account_id_hex, &winnerId)) {
         fprintf(stderr, "claim_pinata: invalid account id hex\n");
@@ -484,11 +999,16 @@ std::string LEZCoreModule::claim_pinata(
         return {};
     }
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_claim_pinata(walletHandle, &pinataId, &winnerId, &solution, &result);
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_claim_pinata(walletHandle, &pinataId, &winnerId, &solution, &result); });
+    readCache.invalidate(pinataId);
+    readCache.invalidate(winnerId);
     if (error != SUCCESS) {
         fprintf(stderr, "claim_pinata: wallet FFI error %d\n", error);
         return {};
     }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "claim_pinata", result.tx_hash, {pinataId, winnerId}, nullptr);
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
@@ -501,6 +1021,7 @@ std::string LEZCoreModule::claim_pinata_private_owned_already_initialized(
     int64_t winner_proof_index,
     const std::string& winner_proof_siblings_json
 ) {
+    MethodMetrics::Call call(metrics, "claim_pinata_private_owned_already_initialized");
     FfiBytes32 pinataId{}, winnerId{};
     if (!hexToBytes32(pinata_account_id_hex, &pinataId) || !hexToBytes32(winner_account_id_hex, &winnerId)) {
         fprintf(stderr, "claim_pinata_private_owned_already_initialized: invalid account id hex\n");
@@ -525,7 +1046,13 @@ std::string LEZCoreModule::claim_pinata_private_owned_already_initialized(
     }
 
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_claim_pinata_private_owned_already_initialized(
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "claim_pinata_private_owned_already_initialized: proving queue full\n");
+        return {};
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_claim_pinata_private_owned_already_initialized(
         walletHandle,
         &pinataId,
         &winnerId,
@@ -534,11 +1061,15 @@ std::string LEZCoreModule::claim_pinata_private_owned_already_initialized(
         siblings_ptr,
         siblings_len,
         &result
-    );
+    ); });
+    readCache.invalidate(pinataId);
+    readCache.invalidate(winnerId);
     if (error != SUCCESS) {
         fprintf(stderr, "claim_pinata_private_owned_already_initialized: wallet FFI error %d\n", error);
         return {};
     }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "claim_pinata_private_owned_already_initialized", result.tx_hash, {pinataId, winnerId}, nullptr);
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
@@ -549,6 +1080,7 @@ std::string LEZCoreModule::claim_pinata_private_owned_not_initialized(
     const std::string& winner_account_id_hex,
     const std::string& solution_le16_hex
 ) {
+    MethodMetrics::Call call(metrics, "claim_pinata_private_owned_not_initialized");
     FfiBytes32 pinataId{}, winnerId{};
     if (!hexToBytes32(pinata_account_id_hex, &pinataId) || !hexToBytes32(winner_account_id_hex, &winnerId)) {
         fprintf(stderr, "claim_pinata_private_owned_not_initialized: invalid account id hex\n");
@@ -560,17 +1092,27 @@ std::string LEZCoreModule::claim_pinata_private_owned_not_initialized(
         return {};
     }
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_claim_pinata_private_owned_not_initialized(
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "claim_pinata_private_owned_not_initialized: proving queue full\n");
+        return {};
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_claim_pinata_private_owned_not_initialized(
         walletHandle,
         &pinataId,
         &winnerId,
         &solution,
         &result
-    );
+    ); });
+    readCache.invalidate(pinataId);
+    readCache.invalidate(winnerId);
     if (error != SUCCESS) {
         fprintf(stderr, "claim_pinata_private_owned_not_initialized: wallet FFI error %d\n", error);
         return {};
     }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "claim_pinata_private_owned_not_initialized", result.tx_hash, {pinataId, winnerId}, nullptr);
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
@@ -583,27 +1125,13 @@ std::string LEZCoreModule::transfer_public(
     const std::string& to_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{}, toId{};
-    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
-        fprintf(stderr, "transfer_public: invalid account id hex\n");
-        return transferResultToJson(nullptr, "transfer_public: invalid account id hex");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_public");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_public: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "transfer_public: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_public(walletHandle, &fromId, &toId, &amount, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_public: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_public: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_public", AccountTransfer::Public, from_hex, to_hex, amount);
 }
 
 std::string LEZCoreModule::transfer_shielded(
@@ -611,44 +1139,13 @@ std::string LEZCoreModule::transfer_shielded(
     const std::string& to_keys_json,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{};
-    if (!hexToBytes32(from_hex, &fromId)) {
-        fprintf(stderr, "transfer_shielded: invalid from account id hex\n");
-        return transferResultToJson(nullptr, "transfer_shielded: invalid from account id hex");
-    }
-
-    FfiPrivateAccountKeys toKeys{};
-    if (!jsonToFfiPrivateAccountKeys(to_keys_json, &toKeys)) {
-        fprintf(stderr, "transfer_shielded: failed to parse to_keys_json\n");
-        return transferResultToJson(nullptr, "transfer_shielded: failed to parse to_keys_json");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_shielded");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_shielded: amount_le16_hex must be 32 hex characters (16 bytes)\n");
-        free(const_cast<uint8_t*>(toKeys.viewing_public_key));
         return transferResultToJson(nullptr, "transfer_shielded: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    // to_keys_json never carries an identifier in this codebase (NPK/VPK name a key group,
-    // not one account in it) — pick a random one, which the recipient's wallet will recover
-    // from the encrypted transfer payload on its next sync-private. See jsonExtractIdentifier.
-    FfiU128 toIdentifier{};
-    if (!jsonExtractIdentifier(to_keys_json, &toIdentifier))
-        toIdentifier = randomFfiU128();
-    // ToDo: Add keycard support
-    const char *key_path = nullptr;
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_shielded(walletHandle, &fromId, &toKeys, &toIdentifier, &amount, key_path, &result);
-    free(const_cast<uint8_t*>(toKeys.viewing_public_key));
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_shielded: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_shielded: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return transferToKeys(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_shielded", true, from_hex, to_keys_json, amount);
 }
 
 std::string LEZCoreModule::transfer_deshielded(
@@ -656,27 +1153,13 @@ std::string LEZCoreModule::transfer_deshielded(
     const std::string& to_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{}, toId{};
-    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
-        fprintf(stderr, "transfer_deshielded: invalid account id hex\n");
-        return transferResultToJson(nullptr, "transfer_deshielded: invalid account id hex");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_deshielded");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_deshielded: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "transfer_deshielded: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_deshielded(walletHandle, &fromId, &toId, &amount, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_deshielded: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_deshielded: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_deshielded", AccountTransfer::Deshielded, from_hex, to_hex, amount);
 }
 
 std::string LEZCoreModule::transfer_private(
@@ -684,40 +1167,13 @@ std::string LEZCoreModule::transfer_private(
     const std::string& to_keys_json,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{};
-    if (!hexToBytes32(from_hex, &fromId)) {
-        fprintf(stderr, "transfer_private: invalid from account id hex\n");
-        return transferResultToJson(nullptr, "transfer_private: invalid from account id hex");
-    }
-
-    FfiPrivateAccountKeys toKeys{};
-    if (!jsonToFfiPrivateAccountKeys(to_keys_json, &toKeys)) {
-        fprintf(stderr, "transfer_private: failed to parse to_keys_json\n");
-        return transferResultToJson(nullptr, "transfer_private: failed to parse to_keys_json");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_private");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_private: amount_le16_hex must be 32 hex characters (16 bytes)\n");
-        free(const_cast<uint8_t*>(toKeys.viewing_public_key));
         return transferResultToJson(nullptr, "transfer_private: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    // See transfer_shielded above: to_keys_json never carries an identifier, so always pick
-    // a random one for the recipient's wallet to recover via sync-private.
-    FfiU128 toIdentifier{};
-    if (!jsonExtractIdentifier(to_keys_json, &toIdentifier))
-        toIdentifier = randomFfiU128();
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_private(walletHandle, &fromId, &toKeys, &toIdentifier, &amount, &result);
-    free(const_cast<uint8_t*>(toKeys.viewing_public_key));
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_private: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_private: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return transferToKeys(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_private", false, from_hex, to_keys_json, amount);
 }
 
 std::string LEZCoreModule::transfer_shielded_owned(
@@ -725,72 +1181,45 @@ std::string LEZCoreModule::transfer_shielded_owned(
     const std::string& to_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{}, toId{};
-    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
-        fprintf(stderr, "transfer_shielded_owned: invalid account id hex\n");
-        return transferResultToJson(nullptr, "transfer_shielded_owned: invalid account id hex");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_shielded_owned");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_shielded_owned: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "transfer_shielded_owned: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    // ToDo: Add keycard support
-    const char *key_path = nullptr;
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_shielded_owned(walletHandle, &fromId, &toId, &amount, key_path, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_shielded_owned: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_shielded_owned: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
-}
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_shielded_owned", AccountTransfer::ShieldedOwned, from_hex, to_hex, amount);
+}
 
 std::string LEZCoreModule::transfer_private_owned(
     const std::string& from_hex,
     const std::string& to_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 fromId{}, toId{};
-    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
-        fprintf(stderr, "transfer_private_owned: invalid account id hex\n");
-        return transferResultToJson(nullptr, "transfer_private_owned: invalid account id hex");
-    }
-
+    MethodMetrics::Call call(metrics, "transfer_private_owned");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "transfer_private_owned: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "transfer_private_owned: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_transfer_private_owned(walletHandle, &fromId, &toId, &amount, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "transfer_private_owned: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "transfer_private_owned: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_private_owned", AccountTransfer::PrivateOwned, from_hex, to_hex, amount);
 }
 
 std::string LEZCoreModule::register_public_account(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "register_public_account");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "register_public_account: invalid account_id_hex\n");
         return transferResultToJson(nullptr, "register_public_account: invalid account_id_hex");
     }
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_register_public_account(walletHandle, &id, &result);
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_register_public_account(walletHandle, &id, &result); });
+    readCache.invalidate(id);
     if (error != SUCCESS) {
         fprintf(stderr, "register_public_account: wallet FFI error %d\n", error);
         return transferResultToJson(nullptr, "register_public_account: wallet FFI error " + std::to_string(error));
     }
+    lock.commit();
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
@@ -803,6 +1232,7 @@ std::string LEZCoreModule::bridge_withdraw(
     const std::string& bedrock_account_pk_hex,
     const uint64_t amount
 ) {
+    MethodMetrics::Call call(metrics, "bridge_withdraw");
     FfiBytes32 fromId{}, bedrockAccountPk{};
     if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(bedrock_account_pk_hex, &bedrockAccountPk)) {
         fprintf(stderr, "bridge_withdraw: invalid account id or bedrock account pk hex\n");
@@ -810,12 +1240,19 @@ std::string LEZCoreModule::bridge_withdraw(
     }
 
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_bridge_withdraw(
-        walletHandle, &fromId, amount, &bedrockAccountPk, &result);
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_bridge_withdraw(
+        walletHandle, &fromId, amount, &bedrockAccountPk, &result); });
+    readCache.invalidate(fromId);
     if (error != SUCCESS) {
         fprintf(stderr, "bridge_withdraw: wallet FFI error %d\n", error);
         return transferResultToJson(nullptr, "bridge_withdraw: wallet FFI error " + std::to_string(error));
     }
+    lock.commit();
+    uint8_t amountLe16[16] = {0};
+    for (int b = 0; b < 8; ++b)
+        amountLe16[b] = static_cast<uint8_t>(amount >> (b * 8));
+    recordSubmission(txJournal, accountHistory, walletHandle, "bridge_withdraw", result.tx_hash, {fromId}, amountLe16);
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
@@ -824,150 +1261,108 @@ std::string LEZCoreModule::bridge_withdraw(
 // === Vault claiming ===
 
 std::string LEZCoreModule::get_vault_balance(const std::string& owner_account_id_hex) {
+    MethodMetrics::Call call(metrics, "get_vault_balance");
     FfiBytes32 ownerId{};
     if (!hexToBytes32(owner_account_id_hex, &ownerId)) {
         fprintf(stderr, "get_vault_balance: invalid owner_account_id_hex\n");
         return {};
     }
 
+    if (auto cached = readCache.get(ownerId, false, AccountReadCache::Field::VaultBalance))
+        return *cached;
+
     uint8_t balance[16] = {0};
-    const WalletFfiError error = wallet_ffi_get_vault_balance(walletHandle, &ownerId, &balance);
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_vault_balance(walletHandle, &ownerId, &balance); });
     if (error != SUCCESS) {
         fprintf(stderr, "get_vault_balance: wallet FFI error %d\n", error);
         return {};
     }
-    return balanceLe16ToDecimalString(balance);
+    std::string result = balanceLe16ToDecimalString(balance);
+    readCache.put(ownerId, false, AccountReadCache::Field::VaultBalance, result);
+    return result;
 }
 
 std::string LEZCoreModule::vault_claim(
     const std::string& owner_account_id_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 ownerId{};
-    if (!hexToBytes32(owner_account_id_hex, &ownerId)) {
-        fprintf(stderr, "vault_claim: invalid owner_account_id_hex\n");
-        return transferResultToJson(nullptr, "vault_claim: invalid owner_account_id_hex");
-    }
-
+    MethodMetrics::Call call(metrics, "vault_claim");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "vault_claim: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "vault_claim: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_vault_claim(walletHandle, &ownerId, &amount, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "vault_claim: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "vault_claim: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return vaultClaim(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "vault_claim", false, owner_account_id_hex, amount);
 }
 
 std::string LEZCoreModule::vault_claim_private(
     const std::string& owner_account_id_hex,
     const std::string& amount_le16_hex
 ) {
-    FfiBytes32 ownerId{};
-    if (!hexToBytes32(owner_account_id_hex, &ownerId)) {
-        fprintf(stderr, "vault_claim_private: invalid owner_account_id_hex\n");
-        return transferResultToJson(nullptr, "vault_claim_private: invalid owner_account_id_hex");
-    }
-
+    MethodMetrics::Call call(metrics, "vault_claim_private");
     uint8_t amount[16];
     if (!hexToU128(amount_le16_hex, &amount)) {
         fprintf(stderr, "vault_claim_private: amount_le16_hex must be 32 hex characters (16 bytes)\n");
         return transferResultToJson(nullptr, "vault_claim_private: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
-
-    FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_vault_claim_private(walletHandle, &ownerId, &amount, &result);
-    if (error != SUCCESS) {
-        fprintf(stderr, "vault_claim_private: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, "vault_claim_private: wallet FFI error " + std::to_string(error));
-    }
-    std::string resultJson = transferResultToJson(&result, std::string());
-    wallet_ffi_free_transfer_result(&result);
-    return resultJson;
+    return vaultClaim(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "vault_claim_private", true, owner_account_id_hex, amount);
 }
 
 std::string LEZCoreModule::register_private_account(const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "register_private_account");
     FfiBytes32 id{};
     if (!hexToBytes32(account_id_hex, &id)) {
         fprintf(stderr, "register_private_account: invalid account_id_hex\n");
         return transferResultToJson(nullptr, "register_private_account: invalid account_id_hex");
     }
     FfiTransferResult result{};
-    const WalletFfiError error = wallet_ffi_register_private_account(walletHandle, &id, &result);
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "register_private_account: proving queue full\n");
+        return transferResultToJson(nullptr, "register_private_account: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_register_private_account(walletHandle, &id, &result); });
+    readCache.invalidate(id);
     if (error != SUCCESS) {
         fprintf(stderr, "register_private_account: wallet FFI error %d\n", error);
         return transferResultToJson(nullptr, "register_private_account: wallet FFI error " + std::to_string(error));
     }
+    lock.commit();
     std::string resultJson = transferResultToJson(&result, std::string());
     wallet_ffi_free_transfer_result(&result);
     return resultJson;
 }
 
 std::vector<uint8_t> LEZCoreModule::token_elf() {
-    FfiProgram ffi_program{};
-    WalletFfiError error = wallet_ffi_token_elf(&ffi_program);
-    if (error != SUCCESS) {
-        fprintf(stderr, "token_elf: wallet FFI error %d\n", error);
-        return std::vector<uint8_t>{};
-    }
-
-    std::vector<uint8_t> result(ffi_program.elf_data,
-                                 ffi_program.elf_data + ffi_program.elf_size);
-
-    wallet_ffi_free_ffi_program(&ffi_program);
-    return result;
+    MethodMetrics::Call call(metrics, "token_elf");
+    return elfToBytes(builtinElfs.get(BuiltinElfs::Program::Token));
 }
 
 std::vector<uint8_t> LEZCoreModule::amm_elf() {
-    FfiProgram ffi_program{};
-    WalletFfiError error = wallet_ffi_amm_elf(&ffi_program);
-    if (error != SUCCESS) {
-        fprintf(stderr, "amm_elf: wallet FFI error %d\n", error);
-        return std::vector<uint8_t>{};
-    }
-
-    std::vector<uint8_t> result(ffi_program.elf_data,
-                                 ffi_program.elf_data + ffi_program.elf_size);
-
-    wallet_ffi_free_ffi_program(&ffi_program);
-    return result;
+    MethodMetrics::Call call(metrics, "amm_elf");
+    return elfToBytes(builtinElfs.get(BuiltinElfs::Program::Amm));
 }
 
 std::vector<uint8_t> LEZCoreModule::ata_elf() {
-    FfiProgram ffi_program{};
-    WalletFfiError error = wallet_ffi_ata_elf(&ffi_program);
-    if (error != SUCCESS) {
-        fprintf(stderr, "ata_elf: wallet FFI error %d\n", error);
-        return std::vector<uint8_t>{};
-    }
-
-    std::vector<uint8_t> result(ffi_program.elf_data,
-                                 ffi_program.elf_data + ffi_program.elf_size);
-
-    wallet_ffi_free_ffi_program(&ffi_program);
-    return result;
+    MethodMetrics::Call call(metrics, "ata_elf");
+    return elfToBytes(builtinElfs.get(BuiltinElfs::Program::Ata));
 }
 
 std::vector<uint8_t> LEZCoreModule::authenticated_transfer_elf() {
-    FfiProgram ffi_program{};
-    WalletFfiError error = wallet_ffi_transfer_elf(&ffi_program);
-    if (error != SUCCESS) {
-        fprintf(stderr, "authenticated_transfer_elf: wallet FFI error %d\n", error);
-        return std::vector<uint8_t>{};
-    }
-
-    std::vector<uint8_t> result(ffi_program.elf_data,
-                                 ffi_program.elf_data + ffi_program.elf_size);
+    MethodMetrics::Call call(metrics, "authenticated_transfer_elf");
+    return elfToBytes(builtinElfs.get(BuiltinElfs::Program::AuthenticatedTransfer));
+}
 
-    wallet_ffi_free_ffi_program(&ffi_program);
-    return result;
+int64_t LEZCoreModule::builtin_elf_fd(const std::string& program_name) {
+    MethodMetrics::Call call(metrics, "builtin_elf_fd");
+    const std::optional<BuiltinElfs::Program> program = BuiltinElfs::fromName(program_name);
+    if (!program) {
+        fprintf(stderr, "builtin_elf_fd: unknown program %s\n", program_name.c_str());
+        return -1;
+    }
+    return builtinElfs.openDescriptor(*program);
 }
 
 std::string LEZCoreModule::send_generic_public_transaction(
@@ -976,8 +1371,11 @@ std::string LEZCoreModule::send_generic_public_transaction(
         const std::vector<uint32_t>& instruction,
         const std::string& program_id_hex
 ) {
+    MethodMetrics::Call call(metrics, "send_generic_public_transaction");
     std::vector<FfiAccountIdentity> identities_resolved;
     identities_resolved.reserve(account_ids.size());
+    std::vector<FfiBytes32> touched_ids;
+    touched_ids.reserve(account_ids.size());
 
     for (int i = 0; i < account_ids.size(); ++i) {
         FfiAccountIdentity acc_identity{};
@@ -988,12 +1386,13 @@ std::string LEZCoreModule::send_generic_public_transaction(
             return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_public_account: invalid account_id_hex"));
         }
 
-        WalletFfiError error = wallet_ffi_resolve_public_account(id, signing_requirements[i], &acc_identity);
+        WalletFfiError error = call.ffi([&] { return wallet_ffi_resolve_public_account(id, signing_requirements[i], &acc_identity); });
         if (error != SUCCESS) {
             fprintf(stderr, "wallet_ffi_resolve_public_account failed for index %d: wallet FFI error %d\n", i, error);
             return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_public_account: wallet FFI error ") + std::to_string(error));
         }
         identities_resolved.push_back(acc_identity);
+        touched_ids.push_back(id);
     }
 
     const FfiAccountIdentity *account_identities = identities_resolved.data();
@@ -1012,7 +1411,8 @@ std::string LEZCoreModule::send_generic_public_transaction(
 
     FfiTransactionResult result {};
 
-    const WalletFfiError error = wallet_ffi_send_generic_public_transaction(
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_send_generic_public_transaction(
         walletHandle,
         account_identities,
         account_identities_size,
@@ -1020,16 +1420,21 @@ std::string LEZCoreModule::send_generic_public_transaction(
         input_instruction_data_size,
         program_id,
         &result
-    );
+    ); });
 
     for (FfiAccountIdentity& acc_identity : identities_resolved) {
         wallet_ffi_free_account_identity(&acc_identity);
     }
+    for (const FfiBytes32& touched_id : touched_ids) {
+        readCache.invalidate(touched_id);
+    }
 
     if (error != SUCCESS) {
         fprintf(stderr, "send_generic_public_transaction: wallet FFI error %d\n", error);
         return transferResultToJson(nullptr, std::string("send_generic_public_transaction: wallet FFI error ") + std::to_string(error));
     }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "send_generic_public_transaction", result.tx_hash, touched_ids, nullptr);
     std::string resultJson = genericTransactionResultToJson(&result, std::string());
     wallet_ffi_free_transaction_result(&result);
     return resultJson;
@@ -1041,114 +1446,160 @@ std::string LEZCoreModule::send_generic_private_transaction(
         const std::vector<uint8_t>& program_elf,
         const std::vector<std::vector<uint8_t>>& program_dependencies
 ) {
-    std::vector<FfiAccountIdentity> identities_resolved;
-    identities_resolved.reserve(account_ids.size());
-
-    for (int i = 0; i < account_ids.size(); ++i) {
-        FfiAccountIdentity acc_identity{};
-
-        FfiBytes32 id{};
-        if (!hexToBytes32(account_ids[i], &id)) {
-            fprintf(stderr, "wallet_ffi_resolve_private_account: invalid account_id_hex");
-            return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_private_account: invalid account_id_hex"));
-        }
-
-        WalletFfiError error = wallet_ffi_resolve_private_account(walletHandle, id, &acc_identity);
-        if (error != SUCCESS) {
-            fprintf(stderr, "wallet_ffi_resolve_private_account failed for index %d: wallet FFI error %d\n", i, error);
-            return transferResultToJson(nullptr, std::string("wallet_ffi_resolve_private_account: wallet FFI error ") + std::to_string(error));
-        }
-        identities_resolved.push_back(acc_identity);
-    }
-
-    const FfiAccountIdentity *account_identities = identities_resolved.data();
-    uintptr_t account_identities_size = static_cast<uintptr_t>(identities_resolved.size());
-
-    const uint32_t* input_instruction_data = instruction.data();
-    uintptr_t input_instruction_data_size = static_cast<uintptr_t>(instruction.size());
-
+    MethodMetrics::Call call(metrics, "send_generic_private_transaction");
     FfiProgram main_program {};
-
-    const uint8_t *program_elf_data = program_elf.data();
-    uintptr_t program_elf_size = static_cast<uintptr_t>(program_elf.size());
-
-    main_program.elf_data = program_elf_data;
-    main_program.elf_size = program_elf_size;
+    main_program.elf_data = program_elf.data();
+    main_program.elf_size = static_cast<uintptr_t>(program_elf.size());
 
     std::vector<FfiProgram> ffi_program_dependencies;
     ffi_program_dependencies.reserve(program_dependencies.size());
-
-    for (int i = 0; i < program_dependencies.size(); ++i) {
+    for (const std::vector<uint8_t>& dependency : program_dependencies) {
         FfiProgram program{};
+        program.elf_data = dependency.data();
+        program.elf_size = static_cast<uintptr_t>(dependency.size());
+        ffi_program_dependencies.push_back(program);
+    }
 
-        const uint8_t *program_elf_data = program_dependencies[i].data();
-        uintptr_t program_elf_size = static_cast<uintptr_t>(program_dependencies[i].size());
+    FfiProgramWithDependencies program_with_dependencies {};
+    program_with_dependencies.program = main_program;
+    program_with_dependencies.deps = ffi_program_dependencies.data();
+    program_with_dependencies.deps_size = static_cast<uintptr_t>(ffi_program_dependencies.size());
 
-        program.elf_data = program_elf_data;
-        program.elf_size = program_elf_size;
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "send_generic_private_transaction: proving queue full\n");
+        return transferResultToJson(nullptr, "send_generic_private_transaction: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return sendGenericPrivateTransaction(lock, walletHandle, readCache, identityCache, txJournal, accountHistory, call, "send_generic_private_transaction",
+                                         account_ids, instruction, program_with_dependencies);
+}
 
-        ffi_program_dependencies.push_back(program);
+std::string LEZCoreModule::send_builtin_private_transaction(
+        const std::vector<std::string>& account_ids,
+        const std::vector<uint32_t>& instruction,
+        const std::string& program_name,
+        const std::vector<std::string>& dependency_names
+) {
+    MethodMetrics::Call call(metrics, "send_builtin_private_transaction");
+    // Held until the submission returns, so wallet_ffi reads the shared buffers in place.
+    std::vector<BuiltinElfs::Elf> elfs;
+    elfs.reserve(1 + dependency_names.size());
+    for (size_t i = 0; i <= dependency_names.size(); ++i) {
+        const std::string& name = i == 0 ? program_name : dependency_names[i - 1];
+        const std::optional<BuiltinElfs::Program> program = BuiltinElfs::fromName(name);
+        if (!program) {
+            fprintf(stderr, "send_builtin_private_transaction: unknown program %s\n", name.c_str());
+            return transferResultToJson(nullptr, "send_builtin_private_transaction: unknown program " + name);
+        }
+        BuiltinElfs::Elf elf = builtinElfs.get(*program);
+        if (!elf) {
+            return transferResultToJson(nullptr, "send_builtin_private_transaction: cannot load program " + name);
+        }
+        elfs.push_back(std::move(elf));
     }
 
-    const FfiProgram *dependencies_data = ffi_program_dependencies.data();
-    uintptr_t dependencies_size = static_cast<uintptr_t>(ffi_program_dependencies.size());
+    std::vector<FfiProgram> dependencies;
+    dependencies.reserve(dependency_names.size());
+    for (size_t i = 1; i < elfs.size(); ++i) {
+        dependencies.push_back(*elfs[i]);
+    }
 
     FfiProgramWithDependencies program_with_dependencies {};
+    program_with_dependencies.program = *elfs[0];
+    program_with_dependencies.deps = dependencies.data();
+    program_with_dependencies.deps_size = static_cast<uintptr_t>(dependencies.size());
+
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "send_builtin_private_transaction: proving queue full\n");
+        return transferResultToJson(nullptr, "send_builtin_private_transaction: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return sendGenericPrivateTransaction(lock, walletHandle, readCache, identityCache, txJournal, accountHistory, call, "send_builtin_private_transaction",
+                                         account_ids, instruction, program_with_dependencies);
+}
 
-    program_with_dependencies.program = main_program;
-    program_with_dependencies.deps = dependencies_data;
-    program_with_dependencies.deps_size = dependencies_size;
-
-    FfiTransactionResult result {};
+// === Program registry ===
 
-    const WalletFfiError error = wallet_ffi_send_generic_private_transaction(
-        walletHandle, 
-        account_identities,
-        account_identities_size,
-        input_instruction_data, 
-        input_instruction_data_size,
-        &program_with_dependencies,
-        &result
-    );
+std::string LEZCoreModule::register_program(const std::vector<uint8_t>& program_elf) {
+    MethodMetrics::Call call(metrics, "register_program");
+    const std::string handle = programRegistry.add(program_elf);
+    if (handle.empty())
+        fprintf(stderr, "register_program: cannot register a %zu-byte ELF\n", program_elf.size());
+    return handle;
+}
 
-    for (FfiAccountIdentity& acc_identity : identities_resolved) {
-        wallet_ffi_free_account_identity(&acc_identity);
+std::string LEZCoreModule::register_builtin_program(const std::string& program_name) {
+    MethodMetrics::Call call(metrics, "register_builtin_program");
+    const std::optional<BuiltinElfs::Program> program = BuiltinElfs::fromName(program_name);
+    if (!program) {
+        fprintf(stderr, "register_builtin_program: unknown program %s\n", program_name.c_str());
+        return {};
     }
+    return programRegistry.add(builtinElfs.get(*program));
+}
 
-    if (error != SUCCESS) {
-        fprintf(stderr, "send_generic_private_transaction: wallet FFI error %d\n", error);
-        return transferResultToJson(nullptr, std::string("send_generic_private_transaction: wallet FFI error ") + std::to_string(error));
-    }
-    std::string resultJson = genericTransactionResultToJson(&result, std::string());
-    wallet_ffi_free_transaction_result(&result);
-    return resultJson;
+bool LEZCoreModule::unregister_program(const std::string& program_handle) {
+    MethodMetrics::Call call(metrics, "unregister_program");
+    return programRegistry.remove(program_handle);
+}
+
+std::string LEZCoreModule::send_registered_private_transaction(
+        const std::vector<std::string>& account_ids,
+        const std::vector<uint32_t>& instruction,
+        const std::string& program_handle,
+        const std::vector<std::string>& dependency_handles
+) {
+    MethodMetrics::Call call(metrics, "send_registered_private_transaction");
+    std::string missing;
+    const std::shared_ptr<const ProgramRegistry::Prepared> prepared = programRegistry.prepare(program_handle, dependency_handles, missing);
+    if (!prepared) {
+        fprintf(stderr, "send_registered_private_transaction: unknown program handle %s\n", missing.c_str());
+        return transferResultToJson(nullptr, "send_registered_private_transaction: unknown program handle " + missing);
+    }
+
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "send_registered_private_transaction: proving queue full\n");
+        return transferResultToJson(nullptr, "send_registered_private_transaction: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return sendGenericPrivateTransaction(lock, walletHandle, readCache, identityCache, txJournal, accountHistory, call, "send_registered_private_transaction",
+                                         account_ids, instruction, prepared->ffi);
 }
 
 std::string LEZCoreModule::send_program_deployment_transaction(
         const std::vector<uint8_t>& program_elf
 ) {
+    MethodMetrics::Call call(metrics, "send_program_deployment_transaction");
     FfiTransactionResult result {};
 
     const uint8_t *program_elf_data = program_elf.data();
     uintptr_t program_elf_size = static_cast<uintptr_t>(program_elf.size());
 
-    const WalletFfiError error = wallet_ffi_program_deployment(
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_program_deployment(
         walletHandle, 
         program_elf_data,
         program_elf_size,
         &result
-    );
+    ); });
+    // Deployment fees come out of an account this call does not name; drop everything.
+    readCache.clear();
 
     if (error != SUCCESS) {
         fprintf(stderr, "send_program_deployment_transaction: wallet FFI error %d\n", error);
         return transferResultToJson(nullptr, std::string("send_program_deployment_transaction: wallet FFI error ") + std::to_string(error));
     }
+    lock.commit();
     std::string resultJson = genericTransactionResultToJson(&result, std::string());
     wallet_ffi_free_transaction_result(&result);
     return resultJson;
 }
 
 bool LEZCoreModule::poll_transaction_status(const std::string& tx_hash_hex) {
+    MethodMetrics::Call call(metrics, "poll_transaction_status");
     FfiBytes32 tx_hash{};
     if (!hexToBytes32(tx_hash_hex, &tx_hash)) {
         fprintf(stderr, "poll_transaction_status: invalid tx_hash_hex\n");
@@ -1157,11 +1608,12 @@ bool LEZCoreModule::poll_transaction_status(const std::string& tx_hash_hex) {
 
     bool is_found = false;
 
-    const WalletFfiError error = wallet_ffi_poll_transaction_status(
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_poll_transaction_status(
         walletHandle, 
         tx_hash,
         &is_found
-    );
+    ); });
 
     if (error != SUCCESS) {
         fprintf(stderr, "poll_transaction_status: wallet FFI error %d\n", error);
@@ -1171,122 +1623,1505 @@ bool LEZCoreModule::poll_transaction_status(const std::string& tx_hash_hex) {
     return is_found;
 }
 
-// === Wallet Lifecycle ===
+// === Recipient book ===
 
-std::string LEZCoreModule::create_new(
-    const std::string& config_path,
-    const std::string& storage_path,
-    const std::string& statistics_path,
-    const std::string& password
-) {
-    if (walletHandle) {
-        fprintf(stderr, "create_new: wallet is already open\n");
+std::string LEZCoreModule::register_recipient(const std::string& to_keys_json) {
+    MethodMetrics::Call call(metrics, "register_recipient");
+    const RecipientBook::Entry recipient = RecipientBook::parse(to_keys_json);
+    if (!recipient) {
+        fprintf(stderr, "register_recipient: failed to parse to_keys_json\n");
         return {};
     }
+    return recipientBook.add(recipient);
+}
 
-    FfiCreateWalletOutput create_output = wallet_ffi_create_new(config_path.c_str(), storage_path.c_str(), statistics_path.c_str(), password.c_str());
-    if (!create_output.wallet) {
-        fprintf(stderr, "create_new: wallet_ffi_create_new returned null\n");
-        return {};
+bool LEZCoreModule::unregister_recipient(const std::string& recipient_handle) {
+    MethodMetrics::Call call(metrics, "unregister_recipient");
+    return recipientBook.remove(recipient_handle);
+}
+
+std::string LEZCoreModule::transfer_shielded_to(
+    const std::string& from_hex,
+    const std::string& recipient_handle,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_to");
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId)) {
+        fprintf(stderr, "transfer_shielded_to: invalid from account id hex\n");
+        return transferResultToJson(nullptr, "transfer_shielded_to: invalid from account id hex");
     }
 
-    walletHandle = create_output.wallet;
-    std::string mnemonic(create_output.mnemonic);
+    const RecipientBook::Entry to = recipientBook.get(recipient_handle);
+    if (!to) {
+        fprintf(stderr, "transfer_shielded_to: unknown recipient handle %s\n", recipient_handle.c_str());
+        return transferResultToJson(nullptr, "transfer_shielded_to: unknown recipient handle " + recipient_handle);
+    }
 
-    wallet_ffi_free_string(create_output.mnemonic);
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "transfer_shielded_to: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "transfer_shielded_to: amount_le16_hex must be 32 hex characters (16 bytes)");
+    }
 
-    return mnemonic;
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "transfer_shielded_to: proving queue full\n");
+        return transferResultToJson(nullptr, "transfer_shielded_to: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return transferToRecipient(lock, walletHandle, readCache, txJournal, accountHistory, call, "transfer_shielded_to", true, fromId, *to, amount);
 }
 
-int64_t LEZCoreModule::restore_storage(const std::string& mnemonic, const std::string password, uint32_t depth) {
-    const WalletFfiError error = wallet_ffi_restore_data(walletHandle, mnemonic.c_str(), password.c_str(), depth);
-    if (error != SUCCESS) {
-        fprintf(stderr, "restore_storage: wallet FFI error %d\n", error);
-        return error;
+std::string LEZCoreModule::transfer_private_to(
+    const std::string& from_hex,
+    const std::string& recipient_handle,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "transfer_private_to");
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId)) {
+        fprintf(stderr, "transfer_private_to: invalid from account id hex\n");
+        return transferResultToJson(nullptr, "transfer_private_to: invalid from account id hex");
     }
 
-    return SUCCESS;
-}
-
-int64_t LEZCoreModule::open(const std::string& config_path, const std::string& storage_path, const std::string& statistics_path) {
-    if (walletHandle) {
-        fprintf(stderr, "open: wallet is already open\n");
-        return INTERNAL_ERROR;
+    const RecipientBook::Entry to = recipientBook.get(recipient_handle);
+    if (!to) {
+        fprintf(stderr, "transfer_private_to: unknown recipient handle %s\n", recipient_handle.c_str());
+        return transferResultToJson(nullptr, "transfer_private_to: unknown recipient handle " + recipient_handle);
     }
 
-    walletHandle = wallet_ffi_open(config_path.c_str(), storage_path.c_str(), statistics_path.c_str());
-    if (!walletHandle) {
-        fprintf(stderr, "open: wallet_ffi_open returned null\n");
-        return INTERNAL_ERROR;
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "transfer_private_to: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "transfer_private_to: amount_le16_hex must be 32 hex characters (16 bytes)");
     }
 
-    return SUCCESS;
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "transfer_private_to: proving queue full\n");
+        return transferResultToJson(nullptr, "transfer_private_to: proving queue full");
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    return transferToRecipient(lock, walletHandle, readCache, txJournal, accountHistory, call, "transfer_private_to", false, fromId, *to, amount);
 }
 
-int64_t LEZCoreModule::save() {
-    return wallet_ffi_save(walletHandle);
-}
+// === Batched payouts ===
 
-// === Configuration ===
+std::string LEZCoreModule::payout_public(
+    const std::string& from_hex,
+    const std::string& payouts_json,
+    const std::string& program_id_hex
+) {
+    MethodMetrics::Call call(metrics, "payout_public");
+    const auto batchError = [](const std::string& message) {
+        fprintf(stderr, "%s\n", message.c_str());
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::Success] = false;
+        obj[JsonKeys::Error] = message;
+        obj[JsonKeys::Transactions] = 0;
+        obj[JsonKeys::Results] = nlohmann::json::array();
+        return obj.dump();
+    };
 
-std::string LEZCoreModule::get_sequencer_addr() {
-    char* addr = wallet_ffi_get_sequencer_addr(walletHandle);
-    if (!addr) {
-        fprintf(stderr, "get_sequencer_addr: wallet_ffi returned null\n");
-        return {};
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId))
+        return batchError("payout_public: invalid from account id hex");
+    uint8_t programIdBytes[32];
+    if (!HexCodec::parseFixed(program_id_hex, programIdBytes, sizeof(programIdBytes)))
+        return batchError("payout_public: invalid program_id_hex");
+    FfiProgramId programId{};
+    memcpy(programId.data, programIdBytes, sizeof(programIdBytes));
+
+    const nlohmann::json doc = nlohmann::json::parse(payouts_json, nullptr, false);
+    if (doc.is_discarded() || !doc.is_array() || doc.empty() || doc.size() > MaxPayoutEntries)
+        return batchError("payout_public: payouts_json must be an array of 1 to " + std::to_string(MaxPayoutEntries) + " entries");
+
+    // One transfer per distinct recipient; entry i is paid by transfers[transferOf[i]].
+    struct Transfer {
+        FfiBytes32 to{};
+        __uint128_t amount = 0;
+        // Entries merged into this transfer.
+        size_t entries = 0;
+        // Whether wallet_ffi accepted the transaction (it may still report failure).
+        bool sent = false;
+        bool success = false;
+        std::string txHash;
+        std::string error;
+    };
+    std::vector<Transfer> transfers;
+    std::vector<size_t> transferOf(doc.size());
+    std::unordered_map<std::string, size_t> transferByRecipient;
+    for (size_t i = 0; i < doc.size(); ++i) {
+        const nlohmann::json& entry = doc[i];
+        FfiBytes32 to{};
+        uint8_t amount[16];
+        if (!entry.is_object() || !entry.contains(JsonKeys::To) || !entry[JsonKeys::To].is_string() ||
+            !entry.contains(JsonKeys::Amount) || !entry[JsonKeys::Amount].is_string() ||
+            !hexToBytes32(entry[JsonKeys::To].get_ref<const std::string&>(), &to) ||
+            !hexToU128(entry[JsonKeys::Amount].get_ref<const std::string&>(), &amount)) {
+            return batchError("payout_public: entry " + std::to_string(i) + " needs a \"to\" account id and a 16-byte hex \"amount\"");
+        }
+        __uint128_t value = 0;
+        for (int b = 15; b >= 0; --b)
+            value = (value << 8) | amount[b];
+
+        const auto [it, added] = transferByRecipient.emplace(std::string(reinterpret_cast<const char*>(to.data), 32), transfers.size());
+        if (added) {
+            Transfer& transfer = transfers.emplace_back();
+            transfer.to = to;
+            transfer.amount = value;
+            transfer.entries = 1;
+        } else {
+            Transfer& merged = transfers[it->second];
+            if (merged.amount + value < merged.amount)
+                return batchError("payout_public: amounts for entry " + std::to_string(i) + "'s recipient add up to 2^128 or more");
+            merged.amount += value;
+            ++merged.entries;
+        }
+        transferOf[i] = it->second;
     }
 
-    std::string value(addr);
-    wallet_ffi_free_string(addr);
-    return value;
-}
+    FfiAccountIdentity accounts[2] = {};
+    const WalletFfiError senderError = call.ffi([&] { return wallet_ffi_resolve_public_account(fromId, true, &accounts[0]); });
+    if (senderError != SUCCESS)
+        return batchError("payout_public: wallet_ffi_resolve_public_account: wallet FFI error " + std::to_string(senderError));
 
-// === Labels ===
+    for (Transfer& transfer : transfers) {
+        WalletFfiError error = call.ffi([&] { return wallet_ffi_resolve_public_account(transfer.to, false, &accounts[1]); });
+        if (error != SUCCESS) {
+            transfer.error = "wallet_ffi_resolve_public_account: wallet FFI error " + std::to_string(error);
+            continue;
+        }
 
-bool LEZCoreModule::check_label_available(const std::string& label) {
-    const char* label_c = label.c_str();
+        uint8_t amount[16];
+        for (int b = 0; b < 16; ++b)
+            amount[b] = static_cast<uint8_t>(transfer.amount >> (b * 8));
+        uint32_t instruction[4];
+        u128ToInstructionWords(amount, instruction);
+
+        FfiTransactionResult result{};
+        {
+            // Per transfer, not per batch, so reads and other submissions interleave with a long payout.
+            WalletWriteLock lock(walletMutex, autosave, walletHandle);
+            error = call.ffi([&] { return wallet_ffi_send_generic_public_transaction(walletHandle, accounts, 2, instruction, 4, programId, &result); });
+            readCache.invalidate(fromId);
+            readCache.invalidate(transfer.to);
+            if (error == SUCCESS) {
+                lock.commit();
+                recordSubmission(txJournal, accountHistory, walletHandle, "payout_public", result.tx_hash, {fromId, transfer.to}, amount);
+            }
+        }
+        wallet_ffi_free_account_identity(&accounts[1]);
+        accounts[1] = FfiAccountIdentity{};
 
-    LabelAvailability label_check = wallet_ffi_check_label_available(
-        walletHandle,
-        label_c
-    );
+        if (error != SUCCESS) {
+            fprintf(stderr, "payout_public: wallet FFI error %d\n", error);
+            transfer.error = "wallet FFI error " + std::to_string(error);
+            continue;
+        }
+        transfer.sent = true;
+        transfer.success = result.success;
+        if (result.tx_hash)
+            transfer.txHash = result.tx_hash;
+        wallet_ffi_free_transaction_result(&result);
+    }
+    wallet_ffi_free_account_identity(&accounts[0]);
+
+    bool allSucceeded = true;
+    nlohmann::json results = nlohmann::json::array();
+    for (size_t i = 0; i < doc.size(); ++i) {
+        const Transfer& transfer = transfers[transferOf[i]];
+        allSucceeded = allSucceeded && transfer.success;
+        uint8_t transferAmount[16];
+        for (int b = 0; b < 16; ++b)
+            transferAmount[b] = static_cast<uint8_t>(transfer.amount >> (b * 8));
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::To] = doc[i][JsonKeys::To];
+        obj[JsonKeys::Amount] = doc[i][JsonKeys::Amount];
+        obj[JsonKeys::TransferAmount] = bytesToHex(transferAmount, sizeof(transferAmount));
+        obj[JsonKeys::MergedEntries] = transfer.entries;
+        obj[JsonKeys::Success] = transfer.success;
+        obj[JsonKeys::TxHash] = transfer.txHash;
+        obj[JsonKeys::Error] = transfer.error;
+        results.push_back(std::move(obj));
+    }
 
-    if (label_check.error != SUCCESS) {
-        fprintf(stderr, "check_label_available: wallet FFI error %d\n", label_check.error);
+    nlohmann::json obj = nlohmann::json::object();
+    obj[JsonKeys::Success] = allSucceeded;
+    obj[JsonKeys::Error] = "";
+    obj[JsonKeys::Transactions] = std::count_if(transfers.begin(), transfers.end(), [](const Transfer& transfer) { return transfer.sent; });
+    obj[JsonKeys::Results] = std::move(results);
+    return obj.dump();
+}
+
+// === Transaction tracking ===
+
+bool LEZCoreModule::watch_transaction(const std::string& tx_hash_hex, const int64_t timeout_ms) {
+    MethodMetrics::Call call(metrics, "watch_transaction");
+    FfiBytes32 tx_hash{};
+    if (!hexToBytes32(tx_hash_hex, &tx_hash)) {
+        fprintf(stderr, "watch_transaction: invalid tx_hash_hex\n");
         return false;
     }
+    txWatcher.watch(bytes32ToHex(tx_hash), tx_hash, std::chrono::milliseconds(std::max<int64_t>(0, timeout_ms)));
+    return true;
+}
 
-    return label_check.is_available;
+std::string LEZCoreModule::wait_for_transaction(const std::string& tx_hash_hex, const int64_t timeout_ms) {
+    MethodMetrics::Call call(metrics, "wait_for_transaction");
+    FfiBytes32 tx_hash{};
+    if (!hexToBytes32(tx_hash_hex, &tx_hash)) {
+        fprintf(stderr, "wait_for_transaction: invalid tx_hash_hex\n");
+        return txStatusToJson(tx_hash_hex, "invalid");
+    }
+    const std::string key = bytes32ToHex(tx_hash);
+    const auto timeout = std::chrono::milliseconds(std::max<int64_t>(0, timeout_ms));
+    txWatcher.watch(key, tx_hash, timeout);
+    return txStatusToJson(key, txStateToString(txWatcher.wait(key, timeout)));
 }
 
-int64_t LEZCoreModule::add_label(const std::string& label, const std::string& account_id_hex, bool is_private) {
-    const char* label_c = label.c_str();
+LogosList LEZCoreModule::get_transaction_events(const int64_t since_sequence) {
+    MethodMetrics::Call call(metrics, "get_transaction_events");
+    LogosList result = nlohmann::json::array();
+    for (const TxWatcher::Event& event : txWatcher.eventsSince(since_sequence)) {
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::Sequence] = event.sequence;
+        obj[JsonKeys::TxHash] = event.txHash;
+        obj[JsonKeys::Status] = txStateToString(event.state);
+        result.push_back(std::move(obj));
+    }
+    return result;
+}
 
-    FfiBytes32 id{};
-    if (!hexToBytes32(account_id_hex, &id)) {
-        fprintf(stderr, "wallet_ffi_add_label: invalid account_id_hex");
-        return WalletFfiError::INVALID_ACCOUNT_ID;
+// === Transaction journal ===
+
+bool LEZCoreModule::set_tx_journal(const bool enabled) {
+    MethodMetrics::Call call(metrics, "set_tx_journal");
+    txJournalOnOpen = enabled;
+    return true;
+}
+
+std::string LEZCoreModule::get_journal_transactions(const std::string& account_id_hex, const std::string& status, const int64_t limit) {
+    MethodMetrics::Call call(metrics, "get_journal_transactions");
+    if (limit < 1 || limit > MaxJournalQueryLimit) {
+        fprintf(stderr, "get_journal_transactions: limit must be between 1 and %lld\n", static_cast<long long>(MaxJournalQueryLimit));
+        return "[]";
+    }
+    FfiBytes32 account{};
+    if (!account_id_hex.empty() && !hexToBytes32(account_id_hex, &account)) {
+        fprintf(stderr, "get_journal_transactions: invalid account_id_hex\n");
+        return "[]";
+    }
+    std::optional<TxJournal::Status> statusFilter;
+    if (!status.empty()) {
+        TxJournal::Status parsed{};
+        if (!journalStatusFromString(status, &parsed)) {
+            fprintf(stderr, "get_journal_transactions: unknown status '%s'\n", status.c_str());
+            return "[]";
+        }
+        statusFilter = parsed;
+    }
+
+    nlohmann::json result = nlohmann::json::array();
+    for (const TxJournal::Entry& entry : txJournal.query(account_id_hex.empty() ? nullptr : &account, statusFilter, static_cast<size_t>(limit))) {
+        nlohmann::json accounts = nlohmann::json::array();
+        for (const FfiBytes32& id : entry.accounts)
+            accounts.push_back(bytes32ToHex(id));
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::Sequence] = entry.sequence;
+        obj[JsonKeys::Method] = entry.method;
+        obj[JsonKeys::TxHash] = bytes32ToHex(entry.txHash);
+        obj[JsonKeys::Accounts] = std::move(accounts);
+        obj[JsonKeys::Amount] = entry.hasAmount ? bytesToHex(entry.amount.data(), entry.amount.size()) : "";
+        obj[JsonKeys::SubmitBlock] = entry.submitBlock;
+        obj[JsonKeys::SubmittedAtMs] = entry.submittedAtMs;
+        obj[JsonKeys::Status] = journalStatusToString(entry.status);
+        result.push_back(std::move(obj));
+    }
+    return result.dump();
+}
+
+// === Account history ===
+
+bool LEZCoreModule::set_account_history(const bool enabled) {
+    MethodMetrics::Call call(metrics, "set_account_history");
+    accountHistory.setEnabled(enabled);
+    // Nobody left comparing: a later baseline must not span the gap.
+    if (!accountHistory.enabled() && !balanceTracker.eventsEnabled())
+        balanceTracker.reset();
+    return true;
+}
+
+std::string LEZCoreModule::get_account_history(const std::string& account_id_hex, const int64_t cursor, const int64_t limit) {
+    MethodMetrics::Call call(metrics, "get_account_history");
+    nlohmann::json result = nlohmann::json::object();
+    result[JsonKeys::Records] = nlohmann::json::array();
+    result[JsonKeys::NextCursor] = 0;
+    FfiBytes32 account{};
+    if (!hexToBytes32(account_id_hex, &account)) {
+        fprintf(stderr, "get_account_history: invalid account_id_hex\n");
+        return result.dump();
+    }
+    if (cursor < 0 || limit < 1 || limit > MaxHistoryPageSize) {
+        fprintf(stderr, "get_account_history: cursor must not be negative and limit must be between 1 and %lld\n",
+                static_cast<long long>(MaxHistoryPageSize));
+        return result.dump();
+    }
+
+    const AccountHistory::Page page = accountHistory.query(account, static_cast<uint64_t>(cursor), static_cast<size_t>(limit));
+    nlohmann::json& records = result[JsonKeys::Records];
+    for (const AccountHistory::Record& record : page.records) {
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::Id] = record.id;
+        obj[JsonKeys::Block] = record.block;
+        obj[JsonKeys::TimeMs] = record.timeMs;
+        if (record.kind == AccountHistory::Kind::Submission) {
+            obj[JsonKeys::Kind] = "submission";
+            obj[JsonKeys::Method] = *record.method;
+            obj[JsonKeys::TxHash] = bytes32ToHex(record.txHash);
+            obj[JsonKeys::Amount] = record.hasAmount ? bytesToHex(record.amount.data(), record.amount.size()) : "";
+        } else {
+            obj[JsonKeys::Kind] = "balance";
+            obj[JsonKeys::PreviousBalance] = bytesToHex(record.previousBalance.data(), record.previousBalance.size());
+            obj[JsonKeys::Balance] = bytesToHex(record.balance.data(), record.balance.size());
+            obj[JsonKeys::Nonce] = bytesToHex(record.nonce.data(), record.nonce.size());
+        }
+        records.push_back(std::move(obj));
     }
+    result[JsonKeys::NextCursor] = page.nextCursor;
+    return result.dump();
+}
 
-    FfiAccountIdWithPrivacy acc_id_with_privacy = { id, is_private };
+// === Balance change events ===
 
-    WalletFfiError error = wallet_ffi_add_label(walletHandle, label_c, acc_id_with_privacy);
-    if (error != SUCCESS) {
+bool LEZCoreModule::set_balance_events(const bool enabled) {
+    MethodMetrics::Call call(metrics, "set_balance_events");
+    balanceTracker.setEvents(enabled);
+    if (!accountHistory.enabled() && !balanceTracker.eventsEnabled())
+        balanceTracker.reset();
+    return true;
+}
+
+LogosList LEZCoreModule::get_changes_since(const int64_t cursor) {
+    MethodMetrics::Call call(metrics, "get_changes_since");
+    LogosList result = nlohmann::json::array();
+    for (const BalanceTracker::Event& event : balanceTracker.eventsSince(cursor)) {
+        nlohmann::json changes = nlohmann::json::array();
+        for (const BalanceTracker::Change& change : event.changes) {
+            nlohmann::json obj = nlohmann::json::object();
+            obj[JsonKeys::AccountId] = bytes32ToHex(change.id);
+            obj[JsonKeys::IsPublic] = change.isPublic;
+            obj[JsonKeys::PreviousBalance] = bytesToHex(change.previousBalance.data(), change.previousBalance.size());
+            obj[JsonKeys::Balance] = bytesToHex(change.balance.data(), change.balance.size());
+            obj[JsonKeys::Nonce] = bytesToHex(change.nonce.data(), change.nonce.size());
+            changes.push_back(std::move(obj));
+        }
+        nlohmann::json obj = nlohmann::json::object();
+        obj[JsonKeys::Sequence] = event.sequence;
+        obj[JsonKeys::Block] = event.block;
+        obj[JsonKeys::Changes] = std::move(changes);
+        result.push_back(std::move(obj));
+    }
+    return result;
+}
+
+// === Recipient identifiers ===
+
+std::string LEZCoreModule::random_identifiers(const int64_t count) {
+    MethodMetrics::Call call(metrics, "random_identifiers");
+    if (count < 1 || count > MaxRandomIdentifiers) {
+        fprintf(stderr, "random_identifiers: count must be between 1 and %lld\n", static_cast<long long>(MaxRandomIdentifiers));
+        return "[]";
+    }
+
+    const size_t n = static_cast<size_t>(count);
+    std::vector<uint8_t> raw(n * 16);
+    SecureRandom::fill(raw.data(), raw.size());
+
+    // ["<32 hex>","<32 hex>",...]: 35 chars per entry less the last comma, plus the brackets.
+    std::string out(n * 35 + 1, ',');
+    out.front() = '[';
+    out.back() = ']';
+    for (size_t i = 0; i < n; ++i) {
+        char* entry = out.data() + 1 + i * 35;
+        entry[0] = '"';
+        HexCodec::encode(raw.data() + i * 16, 16, entry + 1);
+        entry[33] = '"';
+    }
+    return out;
+}
+
+std::vector<uint8_t> LEZCoreModule::random_identifiers_bin(const int64_t count) {
+    MethodMetrics::Call call(metrics, "random_identifiers_bin");
+    if (count < 1 || count > MaxRandomIdentifiers) {
+        fprintf(stderr, "random_identifiers_bin: count must be between 1 and %lld\n", static_cast<long long>(MaxRandomIdentifiers));
+        return {};
+    }
+    std::vector<uint8_t> out(static_cast<size_t>(count) * 16);
+    SecureRandom::fill(out.data(), out.size());
+    return out;
+}
+
+// === Decimal amounts ===
+
+std::string LEZCoreModule::transfer_public_decimal(
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_public_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_public_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_public_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_public_decimal", AccountTransfer::Public, from_hex, to_hex, amount);
+}
+
+std::string LEZCoreModule::transfer_shielded_decimal(
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_shielded_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_shielded_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferToKeys(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_shielded_decimal", true, from_hex, to_keys_json, amount);
+}
+
+std::string LEZCoreModule::transfer_deshielded_decimal(
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_deshielded_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_deshielded_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_deshielded_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_deshielded_decimal", AccountTransfer::Deshielded, from_hex, to_hex, amount);
+}
+
+std::string LEZCoreModule::transfer_private_decimal(
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_private_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_private_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_private_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferToKeys(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_private_decimal", false, from_hex, to_keys_json, amount);
+}
+
+std::string LEZCoreModule::transfer_shielded_owned_decimal(
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_owned_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_shielded_owned_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_shielded_owned_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_shielded_owned_decimal", AccountTransfer::ShieldedOwned, from_hex, to_hex, amount);
+}
+
+std::string LEZCoreModule::transfer_private_owned_decimal(
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "transfer_private_owned_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "transfer_private_owned_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "transfer_private_owned_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return transferBetweenAccounts(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "transfer_private_owned_decimal", AccountTransfer::PrivateOwned, from_hex, to_hex, amount);
+}
+
+std::string LEZCoreModule::vault_claim_decimal(
+    const std::string& owner_account_id_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "vault_claim_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "vault_claim_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "vault_claim_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return vaultClaim(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "vault_claim_decimal", false, owner_account_id_hex, amount);
+}
+
+std::string LEZCoreModule::vault_claim_private_decimal(
+    const std::string& owner_account_id_hex,
+    const std::string& amount_decimal
+) {
+    MethodMetrics::Call call(metrics, "vault_claim_private_decimal");
+    uint8_t amount[16];
+    if (!decimalToU128(amount_decimal, &amount)) {
+        fprintf(stderr, "vault_claim_private_decimal: amount_decimal must be a decimal integer below 2^128\n");
+        return transferResultToJson(nullptr, "vault_claim_private_decimal: amount_decimal must be a decimal integer below 2^128");
+    }
+    return vaultClaim(walletMutex, autosave, walletHandle, readCache, txJournal, accountHistory, walletProving, metrics, call, "vault_claim_private_decimal", true, owner_account_id_hex, amount);
+}
+
+// === Binary API ===
+
+std::vector<uint8_t> LEZCoreModule::get_balance_bin(const std::vector<uint8_t>& account_id, const bool is_public) {
+    MethodMetrics::Call call(metrics, "get_balance_bin");
+    FfiBytes32 id{};
+    if (!bytesToBytes32(account_id, &id)) {
+        fprintf(stderr, "get_balance_bin: account_id must be 32 bytes\n");
+        return {};
+    }
+
+    if (auto cached = readCache.get(id, !is_public, AccountReadCache::Field::BalanceLe16))
+        return std::vector<uint8_t>(cached->begin(), cached->end());
+
+    uint8_t balance[16] = {0};
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_balance(walletHandle, &id, is_public, &balance); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "get_balance_bin: wallet FFI error %d\n", error);
+        return {};
+    }
+    readCache.put(id, !is_public, AccountReadCache::Field::BalanceLe16, std::string(reinterpret_cast<const char*>(balance), 16));
+    return std::vector<uint8_t>(balance, balance + 16);
+}
+
+std::vector<uint8_t> LEZCoreModule::get_account_public_bin(const std::vector<uint8_t>& account_id) {
+    MethodMetrics::Call call(metrics, "get_account_public_bin");
+    FfiBytes32 id{};
+    if (!bytesToBytes32(account_id, &id)) {
+        fprintf(stderr, "get_account_public_bin: account_id must be 32 bytes\n");
+        return {};
+    }
+    if (auto cached = readCache.get(id, false, AccountReadCache::Field::AccountRecord))
+        return std::vector<uint8_t>(cached->begin(), cached->end());
+
+    FfiAccount account{};
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_public(walletHandle, &id, &account); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "get_account_public_bin: wallet FFI error %d\n", error);
+        return {};
+    }
+    std::vector<uint8_t> record = ffiAccountToRecord(account);
+    wallet_ffi_free_account_data(&account);
+    readCache.put(id, false, AccountReadCache::Field::AccountRecord, std::string(record.begin(), record.end()));
+    return record;
+}
+
+std::vector<uint8_t> LEZCoreModule::get_account_private_bin(const std::vector<uint8_t>& account_id) {
+    MethodMetrics::Call call(metrics, "get_account_private_bin");
+    FfiBytes32 id{};
+    if (!bytesToBytes32(account_id, &id)) {
+        fprintf(stderr, "get_account_private_bin: account_id must be 32 bytes\n");
+        return {};
+    }
+    if (auto cached = readCache.get(id, true, AccountReadCache::Field::AccountRecord))
+        return std::vector<uint8_t>(cached->begin(), cached->end());
+
+    FfiAccount account{};
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_private(walletHandle, &id, &account); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "get_account_private_bin: wallet FFI error %d\n", error);
+        return {};
+    }
+    std::vector<uint8_t> record = ffiAccountToRecord(account);
+    wallet_ffi_free_account_data(&account);
+    readCache.put(id, true, AccountReadCache::Field::AccountRecord, std::string(record.begin(), record.end()));
+    return record;
+}
+
+std::vector<uint8_t> LEZCoreModule::transfer_public_bin(
+    const std::vector<uint8_t>& from,
+    const std::vector<uint8_t>& to,
+    const std::vector<uint8_t>& amount_le16
+) {
+    MethodMetrics::Call call(metrics, "transfer_public_bin");
+    FfiBytes32 fromId{}, toId{};
+    uint8_t amount[16];
+    if (!bytesToBytes32(from, &fromId) || !bytesToBytes32(to, &toId) || !bytesToU128(amount_le16, &amount)) {
+        fprintf(stderr, "transfer_public_bin: account ids must be 32 bytes and amount 16 bytes\n");
+        return transferResultToRecord(nullptr, INVALID_INPUT);
+    }
+
+    FfiTransferResult result{};
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_public(walletHandle, &fromId, &toId, &amount, &result); });
+    readCache.invalidate(fromId);
+    readCache.invalidate(toId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "transfer_public_bin: wallet FFI error %d\n", error);
+        return transferResultToRecord(nullptr, error);
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "transfer_public_bin", result.tx_hash, {fromId, toId}, amount);
+    std::vector<uint8_t> record = transferResultToRecord(&result, SUCCESS);
+    wallet_ffi_free_transfer_result(&result);
+    return record;
+}
+
+std::vector<uint8_t> LEZCoreModule::transfer_shielded_bin(
+    const std::vector<uint8_t>& from,
+    const std::vector<uint8_t>& to_nullifier_public_key,
+    const std::vector<uint8_t>& to_viewing_public_key,
+    const std::vector<uint8_t>& amount_le16
+) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_bin");
+    FfiBytes32 fromId{};
+    FfiPrivateAccountKeys toKeys{};
+    uint8_t amount[16];
+    if (!bytesToBytes32(from, &fromId) || !bytesToBytes32(to_nullifier_public_key, &toKeys.nullifier_public_key) ||
+        to_viewing_public_key.empty() || !bytesToU128(amount_le16, &amount)) {
+        fprintf(stderr, "transfer_shielded_bin: from / nullifier key must be 32 bytes, viewing key non-empty, amount 16 bytes\n");
+        return transferResultToRecord(nullptr, INVALID_INPUT);
+    }
+    // wallet_ffi only reads the key; point it at the caller's bytes instead of copying.
+    toKeys.viewing_public_key = const_cast<uint8_t*>(to_viewing_public_key.data());
+    toKeys.viewing_public_key_len = static_cast<uintptr_t>(to_viewing_public_key.size());
+
+    // See transfer_shielded: the recipient's wallet recovers a random identifier on sync-private.
+    FfiU128 toIdentifier = randomFfiU128();
+    const char *key_path = nullptr;
+
+    FfiTransferResult result{};
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "transfer_shielded_bin: proving queue full\n");
+        return transferResultToRecord(nullptr, INTERNAL_ERROR);
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_shielded(walletHandle, &fromId, &toKeys, &toIdentifier, &amount, key_path, &result); });
+    readCache.invalidate(fromId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "transfer_shielded_bin: wallet FFI error %d\n", error);
+        return transferResultToRecord(nullptr, error);
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "transfer_shielded_bin", result.tx_hash, {fromId}, amount);
+    std::vector<uint8_t> record = transferResultToRecord(&result, SUCCESS);
+    wallet_ffi_free_transfer_result(&result);
+    return record;
+}
+
+std::vector<uint8_t> LEZCoreModule::transfer_deshielded_bin(
+    const std::vector<uint8_t>& from,
+    const std::vector<uint8_t>& to,
+    const std::vector<uint8_t>& amount_le16
+) {
+    MethodMetrics::Call call(metrics, "transfer_deshielded_bin");
+    FfiBytes32 fromId{}, toId{};
+    uint8_t amount[16];
+    if (!bytesToBytes32(from, &fromId) || !bytesToBytes32(to, &toId) || !bytesToU128(amount_le16, &amount)) {
+        fprintf(stderr, "transfer_deshielded_bin: account ids must be 32 bytes and amount 16 bytes\n");
+        return transferResultToRecord(nullptr, INVALID_INPUT);
+    }
+
+    FfiTransferResult result{};
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "transfer_deshielded_bin: proving queue full\n");
+        return transferResultToRecord(nullptr, INTERNAL_ERROR);
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_deshielded(walletHandle, &fromId, &toId, &amount, &result); });
+    readCache.invalidate(fromId);
+    readCache.invalidate(toId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "transfer_deshielded_bin: wallet FFI error %d\n", error);
+        return transferResultToRecord(nullptr, error);
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "transfer_deshielded_bin", result.tx_hash, {fromId, toId}, amount);
+    std::vector<uint8_t> record = transferResultToRecord(&result, SUCCESS);
+    wallet_ffi_free_transfer_result(&result);
+    return record;
+}
+
+std::vector<uint8_t> LEZCoreModule::transfer_private_bin(
+    const std::vector<uint8_t>& from,
+    const std::vector<uint8_t>& to_nullifier_public_key,
+    const std::vector<uint8_t>& to_viewing_public_key,
+    const std::vector<uint8_t>& amount_le16
+) {
+    MethodMetrics::Call call(metrics, "transfer_private_bin");
+    FfiBytes32 fromId{};
+    FfiPrivateAccountKeys toKeys{};
+    uint8_t amount[16];
+    if (!bytesToBytes32(from, &fromId) || !bytesToBytes32(to_nullifier_public_key, &toKeys.nullifier_public_key) ||
+        to_viewing_public_key.empty() || !bytesToU128(amount_le16, &amount)) {
+        fprintf(stderr, "transfer_private_bin: from / nullifier key must be 32 bytes, viewing key non-empty, amount 16 bytes\n");
+        return transferResultToRecord(nullptr, INVALID_INPUT);
+    }
+    toKeys.viewing_public_key = const_cast<uint8_t*>(to_viewing_public_key.data());
+    toKeys.viewing_public_key_len = static_cast<uintptr_t>(to_viewing_public_key.size());
+
+    FfiU128 toIdentifier = randomFfiU128();
+    FfiTransferResult result{};
+    const ProvingScheduler::Slot proving = admitProof(walletProving, metrics);
+    if (!proving) {
+        fprintf(stderr, "transfer_private_bin: proving queue full\n");
+        return transferResultToRecord(nullptr, INTERNAL_ERROR);
+    }
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_private(walletHandle, &fromId, &toKeys, &toIdentifier, &amount, &result); });
+    readCache.invalidate(fromId);
+    if (error != SUCCESS) {
+        fprintf(stderr, "transfer_private_bin: wallet FFI error %d\n", error);
+        return transferResultToRecord(nullptr, error);
+    }
+    lock.commit();
+    recordSubmission(txJournal, accountHistory, walletHandle, "transfer_private_bin", result.tx_hash, {fromId}, amount);
+    std::vector<uint8_t> record = transferResultToRecord(&result, SUCCESS);
+    wallet_ffi_free_transfer_result(&result);
+    return record;
+}
+
+bool LEZCoreModule::poll_transaction_status_bin(const std::vector<uint8_t>& tx_hash) {
+    MethodMetrics::Call call(metrics, "poll_transaction_status_bin");
+    FfiBytes32 hash{};
+    if (!bytesToBytes32(tx_hash, &hash)) {
+        fprintf(stderr, "poll_transaction_status_bin: tx_hash must be 32 bytes\n");
+        return false;
+    }
+
+    bool is_found = false;
+    std::shared_lock lock(walletMutex);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_poll_transaction_status(walletHandle, hash, &is_found); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "poll_transaction_status_bin: wallet FFI error %d\n", error);
+        return false;
+    }
+    return is_found;
+}
+
+// === Asynchronous submission ===
+
+int64_t LEZCoreModule::claim_pinata_async(
+    const std::string& pinata_account_id_hex,
+    const std::string& winner_account_id_hex,
+    const std::string& solution_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "claim_pinata_async");
+    return asyncRequests.submit("claim_pinata", [=, this] {
+        return claim_pinata(pinata_account_id_hex, winner_account_id_hex, solution_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::claim_pinata_private_owned_already_initialized_async(
+    const std::string& pinata_account_id_hex,
+    const std::string& winner_account_id_hex,
+    const std::string& solution_le16_hex,
+    int64_t winner_proof_index,
+    const std::string& winner_proof_siblings_json
+) {
+    MethodMetrics::Call call(metrics, "claim_pinata_private_owned_already_initialized_async");
+    return asyncRequests.submit("claim_pinata_private_owned_already_initialized", [=, this] {
+        return claim_pinata_private_owned_already_initialized(
+            pinata_account_id_hex, winner_account_id_hex, solution_le16_hex, winner_proof_index, winner_proof_siblings_json);
+    });
+}
+
+int64_t LEZCoreModule::claim_pinata_private_owned_not_initialized_async(
+    const std::string& pinata_account_id_hex,
+    const std::string& winner_account_id_hex,
+    const std::string& solution_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "claim_pinata_private_owned_not_initialized_async");
+    return asyncRequests.submit("claim_pinata_private_owned_not_initialized", [=, this] {
+        return claim_pinata_private_owned_not_initialized(pinata_account_id_hex, winner_account_id_hex, solution_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_public_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_public_async");
+    return asyncRequests.submit("transfer_public", [=, this] {
+        return transfer_public(from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_shielded_async(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_async");
+    return asyncRequests.submit("transfer_shielded", [=, this] {
+        return transfer_shielded(from_hex, to_keys_json, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_deshielded_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_deshielded_async");
+    return asyncRequests.submit("transfer_deshielded", [=, this] {
+        return transfer_deshielded(from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_private_async(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_private_async");
+    return asyncRequests.submit("transfer_private", [=, this] {
+        return transfer_private(from_hex, to_keys_json, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_shielded_owned_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_shielded_owned_async");
+    return asyncRequests.submit("transfer_shielded_owned", [=, this] {
+        return transfer_shielded_owned(from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::transfer_private_owned_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "transfer_private_owned_async");
+    return asyncRequests.submit("transfer_private_owned", [=, this] {
+        return transfer_private_owned(from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::bridge_withdraw_async(const std::string& from_hex, const std::string& bedrock_account_pk_hex, const uint64_t amount) {
+    MethodMetrics::Call call(metrics, "bridge_withdraw_async");
+    return asyncRequests.submit("bridge_withdraw", [=, this] {
+        return bridge_withdraw(from_hex, bedrock_account_pk_hex, amount);
+    });
+}
+
+int64_t LEZCoreModule::vault_claim_async(const std::string& owner_account_id_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "vault_claim_async");
+    return asyncRequests.submit("vault_claim", [=, this] {
+        return vault_claim(owner_account_id_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::vault_claim_private_async(const std::string& owner_account_id_hex, const std::string& amount_le16_hex) {
+    MethodMetrics::Call call(metrics, "vault_claim_private_async");
+    return asyncRequests.submit("vault_claim_private", [=, this] {
+        return vault_claim_private(owner_account_id_hex, amount_le16_hex);
+    });
+}
+
+std::string LEZCoreModule::poll_async_result(const int64_t ticket) {
+    MethodMetrics::Call call(metrics, "poll_async_result");
+    return asyncStatusToJson(ticket, asyncRequests.poll(ticket));
+}
+
+std::string LEZCoreModule::await_async_result(const int64_t ticket, const int64_t timeout_ms) {
+    MethodMetrics::Call call(metrics, "await_async_result");
+    const auto timeout = std::chrono::milliseconds(std::max<int64_t>(0, timeout_ms));
+    return asyncStatusToJson(ticket, asyncRequests.await(ticket, timeout));
+}
+
+// === Wallet Lifecycle ===
+
+std::string LEZCoreModule::create_new(
+    const std::string& config_path,
+    const std::string& storage_path,
+    const std::string& statistics_path,
+    const std::string& password
+) {
+    MethodMetrics::Call call(metrics, "create_new");
+    std::lock_guard lock(walletMutex);
+    if (walletHandle) {
+        fprintf(stderr, "create_new: wallet is already open\n");
+        return {};
+    }
+
+    FfiCreateWalletOutput create_output = call.ffi([&] { return wallet_ffi_create_new(config_path.c_str(), storage_path.c_str(), statistics_path.c_str(), password.c_str()); });
+    if (!create_output.wallet) {
+        fprintf(stderr, "create_new: wallet_ffi_create_new returned null\n");
+        return {};
+    }
+
+    walletHandle = create_output.wallet;
+    readCache.clear();
+    identityCache.clear();
+    accountHistory.clear();
+    balanceTracker.reset();
+    if (txJournalOnOpen) {
+        if (txJournal.open(storage_path + ".txjournal"))
+            seedAccountHistory(txJournal, accountHistory);
+        else
+            fprintf(stderr, "create_new: could not open the transaction journal\n");
+    }
+    if (proverWarmupOnOpen)
+        proverWarmup.start();
+    std::string mnemonic(create_output.mnemonic);
+
+    wallet_ffi_free_string(create_output.mnemonic);
+
+    return mnemonic;
+}
+
+int64_t LEZCoreModule::restore_storage(const std::string& mnemonic, const std::string password, uint32_t depth) {
+    MethodMetrics::Call call(metrics, "restore_storage");
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_restore_data(walletHandle, mnemonic.c_str(), password.c_str(), depth); });
+    readCache.clear();
+    identityCache.clear();
+    accountHistory.clear();
+    balanceTracker.reset();
+    if (error != SUCCESS) {
+        fprintf(stderr, "restore_storage: wallet FFI error %d\n", error);
+        return error;
+    }
+    lock.commit();
+
+    return SUCCESS;
+}
+
+int64_t LEZCoreModule::open(const std::string& config_path, const std::string& storage_path, const std::string& statistics_path) {
+    MethodMetrics::Call call(metrics, "open");
+    std::lock_guard lock(walletMutex);
+    if (walletHandle) {
+        fprintf(stderr, "open: wallet is already open\n");
+        return INTERNAL_ERROR;
+    }
+
+    walletHandle = call.ffi([&] { return wallet_ffi_open(config_path.c_str(), storage_path.c_str(), statistics_path.c_str()); });
+    if (!walletHandle) {
+        fprintf(stderr, "open: wallet_ffi_open returned null\n");
+        return INTERNAL_ERROR;
+    }
+    readCache.clear();
+    identityCache.clear();
+    accountHistory.clear();
+    balanceTracker.reset();
+    if (txJournalOnOpen) {
+        if (txJournal.open(storage_path + ".txjournal"))
+            seedAccountHistory(txJournal, accountHistory);
+        else
+            fprintf(stderr, "open: could not open the transaction journal\n");
+    }
+    if (proverWarmupOnOpen)
+        proverWarmup.start();
+
+    return SUCCESS;
+}
+
+int64_t LEZCoreModule::save() {
+    MethodMetrics::Call call(metrics, "save");
+    return call.ffi([&] { return autosave.flush(true); });
+}
+
+int64_t LEZCoreModule::flush() {
+    MethodMetrics::Call call(metrics, "flush");
+    return call.ffi([&] { return autosave.flush(); });
+}
+
+bool LEZCoreModule::set_autosave(const int64_t max_mutations, const int64_t max_delay_ms) {
+    MethodMetrics::Call call(metrics, "set_autosave");
+    autosave.configure(max_mutations > 0 ? static_cast<size_t>(max_mutations) : 0, std::chrono::milliseconds(std::max<int64_t>(0, max_delay_ms)));
+    return true;
+}
+
+std::string LEZCoreModule::get_autosave_stats() {
+    MethodMetrics::Call call(metrics, "get_autosave_stats");
+    return autosave.snapshot().dump();
+}
+
+// === Configuration ===
+
+std::string LEZCoreModule::get_sequencer_addr() {
+    MethodMetrics::Call call(metrics, "get_sequencer_addr");
+    std::shared_lock lock(walletMutex);
+    char* addr = call.ffi([&] { return wallet_ffi_get_sequencer_addr(walletHandle); });
+    if (!addr) {
+        fprintf(stderr, "get_sequencer_addr: wallet_ffi returned null\n");
+        return {};
+    }
+
+    std::string value(addr);
+    wallet_ffi_free_string(addr);
+    return value;
+}
+
+// === Proving ===
+
+bool LEZCoreModule::set_proving_limits(const int64_t max_concurrent, const int64_t max_queued) {
+    MethodMetrics::Call call(metrics, "set_proving_limits");
+    if (max_queued < 0) {
+        fprintf(stderr, "set_proving_limits: max_queued must not be negative\n");
+        return false;
+    }
+    provingScheduler.configure(max_concurrent > 0 ? static_cast<size_t>(max_concurrent) : 0, static_cast<size_t>(max_queued));
+    walletProving.configure(1, static_cast<size_t>(max_queued));
+    return true;
+}
+
+std::string LEZCoreModule::get_proving_stats() {
+    MethodMetrics::Call call(metrics, "get_proving_stats");
+    nlohmann::json stats = provingScheduler.snapshot();
+    stats[JsonKeys::OwnWallet] = walletProving.snapshot();
+    return stats.dump();
+}
+
+bool LEZCoreModule::set_prover_warmup(const bool enabled) {
+    MethodMetrics::Call call(metrics, "set_prover_warmup");
+    proverWarmupOnOpen = enabled;
+    return true;
+}
+
+bool LEZCoreModule::start_prover_warmup() {
+    MethodMetrics::Call call(metrics, "start_prover_warmup");
+    std::shared_lock lock(walletMutex);
+    if (!walletHandle) {
+        fprintf(stderr, "start_prover_warmup: no wallet is open\n");
+        return false;
+    }
+    return proverWarmup.start();
+}
+
+std::string LEZCoreModule::get_prover_readiness() {
+    MethodMetrics::Call call(metrics, "get_prover_readiness");
+    static constexpr const char* StateNames[] = {"cold", "warming", "ready", "failed"};
+    const ProverWarmup::Progress progress = proverWarmup.progress();
+    nlohmann::json result;
+    result[JsonKeys::State] = StateNames[static_cast<int>(progress.state)];
+    result[JsonKeys::ElfsLoaded] = progress.elfsLoaded;
+    result[JsonKeys::IdentitiesResolved] = progress.identitiesResolved;
+    result[JsonKeys::IdentitiesFailed] = progress.identitiesFailed;
+    result[JsonKeys::ElapsedMs] = progress.elapsedMs;
+    result[JsonKeys::Error] = progress.error;
+    return result.dump();
+}
+
+// === Managed wallets ===
+
+int64_t LEZCoreModule::open_managed_wallet(
+    const std::string& wallet_id,
+    const std::string& config_path,
+    const std::string& storage_path,
+    const std::string& statistics_path
+) {
+    MethodMetrics::Call call(metrics, "open_managed_wallet");
+    const WalletFfiError error = call.ffi([&] { return managedWallets.add(wallet_id, config_path, storage_path, statistics_path); });
+    if (error != SUCCESS)
+        fprintf(stderr, "open_managed_wallet: cannot open wallet %s\n", wallet_id.c_str());
+    return error;
+}
+
+int64_t LEZCoreModule::close_managed_wallet(const std::string& wallet_id) {
+    MethodMetrics::Call call(metrics, "close_managed_wallet");
+    return call.ffi([&] { return managedWallets.remove(wallet_id); });
+}
+
+bool LEZCoreModule::set_managed_wallet_limit(const int64_t max_open) {
+    MethodMetrics::Call call(metrics, "set_managed_wallet_limit");
+    managedWallets.setMaxOpen(max_open > 0 ? static_cast<size_t>(max_open) : 0);
+    return true;
+}
+
+std::string LEZCoreModule::get_managed_wallets() {
+    MethodMetrics::Call call(metrics, "get_managed_wallets");
+    return managedWallets.snapshot().dump();
+}
+
+std::string LEZCoreModule::managed_create_account_public(const std::string& wallet_id) {
+    MethodMetrics::Call call(metrics, "managed_create_account_public");
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_create_account_public: unknown wallet %s\n", wallet_id.c_str());
+        return {};
+    }
+
+    FfiBytes32 id{};
+    std::lock_guard lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_create_account_public(wallet.handle(), &id); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "managed_create_account_public: wallet FFI error %d\n", error);
+        return {};
+    }
+    return bytes32ToHex(id);
+}
+
+std::string LEZCoreModule::managed_get_balance(const std::string& wallet_id, const std::string& account_id_hex, const bool is_public) {
+    MethodMetrics::Call call(metrics, "managed_get_balance");
+    FfiBytes32 id{};
+    if (!hexToBytes32(account_id_hex, &id)) {
+        fprintf(stderr, "managed_get_balance: invalid account_id_hex\n");
+        return {};
+    }
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_get_balance: unknown wallet %s\n", wallet_id.c_str());
+        return {};
+    }
+
+    uint8_t balance[16] = {0};
+    std::shared_lock lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_balance(wallet.handle(), &id, is_public, &balance); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "managed_get_balance: wallet FFI error %d\n", error);
+        return {};
+    }
+    return balanceLe16ToDecimalString(balance);
+}
+
+LogosList LEZCoreModule::managed_list_accounts(const std::string& wallet_id) {
+    MethodMetrics::Call call(metrics, "managed_list_accounts");
+    LogosList result = nlohmann::json::array();
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_list_accounts: unknown wallet %s\n", wallet_id.c_str());
+        return result;
+    }
+
+    FfiAccountList list{};
+    std::shared_lock lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_list_accounts(wallet.handle(), &list); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "managed_list_accounts: wallet FFI error %d\n", error);
+        return result;
+    }
+    for (uintptr_t i = 0; i < list.count; ++i) {
+        result.push_back(ffiAccountListEntryToJson(list.entries[i]));
+    }
+    wallet_ffi_free_account_list(&list);
+    return result;
+}
+
+std::string LEZCoreModule::managed_get_account_public(const std::string& wallet_id, const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "managed_get_account_public");
+    FfiBytes32 id{};
+    if (!hexToBytes32(account_id_hex, &id)) {
+        fprintf(stderr, "managed_get_account_public: invalid account_id_hex\n");
+        return {};
+    }
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_get_account_public: unknown wallet %s\n", wallet_id.c_str());
+        return {};
+    }
+
+    FfiAccount account{};
+    std::shared_lock lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_public(wallet.handle(), &id, &account); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "managed_get_account_public: wallet FFI error %d\n", error);
+        return {};
+    }
+    std::string result = ffiAccountToJson(account);
+    wallet_ffi_free_account_data(&account);
+    return result;
+}
+
+std::string LEZCoreModule::managed_get_account_private(const std::string& wallet_id, const std::string& account_id_hex) {
+    MethodMetrics::Call call(metrics, "managed_get_account_private");
+    FfiBytes32 id{};
+    if (!hexToBytes32(account_id_hex, &id)) {
+        fprintf(stderr, "managed_get_account_private: invalid account_id_hex\n");
+        return {};
+    }
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_get_account_private: unknown wallet %s\n", wallet_id.c_str());
+        return {};
+    }
+
+    FfiAccount account{};
+    std::shared_lock lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_get_account_private(wallet.handle(), &id, &account); });
+    if (error != SUCCESS) {
+        fprintf(stderr, "managed_get_account_private: wallet FFI error %d\n", error);
+        return {};
+    }
+    std::string result = ffiAccountToJson(account);
+    wallet_ffi_free_account_data(&account);
+    return result;
+}
+
+std::string LEZCoreModule::managed_transfer_public(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_public");
+    FfiBytes32 fromId{}, toId{};
+    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
+        fprintf(stderr, "managed_transfer_public: invalid account id hex\n");
+        return transferResultToJson(nullptr, "managed_transfer_public: invalid account id hex");
+    }
+
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "managed_transfer_public: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "managed_transfer_public: amount_le16_hex must be 32 hex characters (16 bytes)");
+    }
+
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_transfer_public: unknown wallet %s\n", wallet_id.c_str());
+        return transferResultToJson(nullptr, "managed_transfer_public: unknown wallet " + wallet_id);
+    }
+
+    FfiTransferResult result{};
+    std::lock_guard lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_public(wallet.handle(), &fromId, &toId, &amount, &result); });
+    return finishManagedTransfer(txJournal, accountHistory, wallet.handle(), "managed_transfer_public", error, result, {fromId, toId}, amount);
+}
+
+int64_t LEZCoreModule::managed_transfer_public_async(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_public_async");
+    return asyncRequests.submit("managed_transfer_public", [=, this] {
+        return managed_transfer_public(wallet_id, from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+std::string LEZCoreModule::managed_transfer_shielded(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_shielded");
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId)) {
+        fprintf(stderr, "managed_transfer_shielded: invalid from account id hex\n");
+        return transferResultToJson(nullptr, "managed_transfer_shielded: invalid from account id hex");
+    }
+
+    const RecipientBook::Entry to = RecipientBook::parse(to_keys_json);
+    if (!to) {
+        fprintf(stderr, "managed_transfer_shielded: failed to parse to_keys_json\n");
+        return transferResultToJson(nullptr, "managed_transfer_shielded: failed to parse to_keys_json");
+    }
+
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "managed_transfer_shielded: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "managed_transfer_shielded: amount_le16_hex must be 32 hex characters (16 bytes)");
+    }
+
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_transfer_shielded: unknown wallet %s\n", wallet_id.c_str());
+        return transferResultToJson(nullptr, "managed_transfer_shielded: unknown wallet " + wallet_id);
+    }
+
+    const ProvingScheduler::Slot proving = admitProof(provingScheduler, metrics);
+    if (!proving) {
+        fprintf(stderr, "managed_transfer_shielded: proving queue full\n");
+        return transferResultToJson(nullptr, "managed_transfer_shielded: proving queue full");
+    }
+    FfiTransferResult result{};
+    std::lock_guard lock(wallet.lock());
+    const WalletFfiError error = submitToRecipient(wallet.handle(), call, true, fromId, *to, amount, &result);
+    return finishManagedTransfer(txJournal, accountHistory, wallet.handle(), "managed_transfer_shielded", error, result, {fromId}, amount);
+}
+
+std::string LEZCoreModule::managed_transfer_deshielded(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_deshielded");
+    FfiBytes32 fromId{}, toId{};
+    if (!hexToBytes32(from_hex, &fromId) || !hexToBytes32(to_hex, &toId)) {
+        fprintf(stderr, "managed_transfer_deshielded: invalid account id hex\n");
+        return transferResultToJson(nullptr, "managed_transfer_deshielded: invalid account id hex");
+    }
+
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "managed_transfer_deshielded: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "managed_transfer_deshielded: amount_le16_hex must be 32 hex characters (16 bytes)");
+    }
+
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_transfer_deshielded: unknown wallet %s\n", wallet_id.c_str());
+        return transferResultToJson(nullptr, "managed_transfer_deshielded: unknown wallet " + wallet_id);
+    }
+
+    const ProvingScheduler::Slot proving = admitProof(provingScheduler, metrics);
+    if (!proving) {
+        fprintf(stderr, "managed_transfer_deshielded: proving queue full\n");
+        return transferResultToJson(nullptr, "managed_transfer_deshielded: proving queue full");
+    }
+    FfiTransferResult result{};
+    std::lock_guard lock(wallet.lock());
+    const WalletFfiError error = call.ffi([&] { return wallet_ffi_transfer_deshielded(wallet.handle(), &fromId, &toId, &amount, &result); });
+    return finishManagedTransfer(txJournal, accountHistory, wallet.handle(), "managed_transfer_deshielded", error, result, {fromId, toId}, amount);
+}
+
+std::string LEZCoreModule::managed_transfer_private(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_private");
+    FfiBytes32 fromId{};
+    if (!hexToBytes32(from_hex, &fromId)) {
+        fprintf(stderr, "managed_transfer_private: invalid from account id hex\n");
+        return transferResultToJson(nullptr, "managed_transfer_private: invalid from account id hex");
+    }
+
+    const RecipientBook::Entry to = RecipientBook::parse(to_keys_json);
+    if (!to) {
+        fprintf(stderr, "managed_transfer_private: failed to parse to_keys_json\n");
+        return transferResultToJson(nullptr, "managed_transfer_private: failed to parse to_keys_json");
+    }
+
+    uint8_t amount[16];
+    if (!hexToU128(amount_le16_hex, &amount)) {
+        fprintf(stderr, "managed_transfer_private: amount_le16_hex must be 32 hex characters (16 bytes)\n");
+        return transferResultToJson(nullptr, "managed_transfer_private: amount_le16_hex must be 32 hex characters (16 bytes)");
+    }
+
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_transfer_private: unknown wallet %s\n", wallet_id.c_str());
+        return transferResultToJson(nullptr, "managed_transfer_private: unknown wallet " + wallet_id);
+    }
+
+    const ProvingScheduler::Slot proving = admitProof(provingScheduler, metrics);
+    if (!proving) {
+        fprintf(stderr, "managed_transfer_private: proving queue full\n");
+        return transferResultToJson(nullptr, "managed_transfer_private: proving queue full");
+    }
+    FfiTransferResult result{};
+    std::lock_guard lock(wallet.lock());
+    const WalletFfiError error = submitToRecipient(wallet.handle(), call, false, fromId, *to, amount, &result);
+    return finishManagedTransfer(txJournal, accountHistory, wallet.handle(), "managed_transfer_private", error, result, {fromId}, amount);
+}
+
+int64_t LEZCoreModule::managed_transfer_shielded_async(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_shielded_async");
+    return asyncRequests.submit("managed_transfer_shielded", [=, this] {
+        return managed_transfer_shielded(wallet_id, from_hex, to_keys_json, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::managed_transfer_deshielded_async(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_hex,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_deshielded_async");
+    return asyncRequests.submit("managed_transfer_deshielded", [=, this] {
+        return managed_transfer_deshielded(wallet_id, from_hex, to_hex, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::managed_transfer_private_async(
+    const std::string& wallet_id,
+    const std::string& from_hex,
+    const std::string& to_keys_json,
+    const std::string& amount_le16_hex
+) {
+    MethodMetrics::Call call(metrics, "managed_transfer_private_async");
+    return asyncRequests.submit("managed_transfer_private", [=, this] {
+        return managed_transfer_private(wallet_id, from_hex, to_keys_json, amount_le16_hex);
+    });
+}
+
+int64_t LEZCoreModule::managed_sync_to_block(const std::string& wallet_id, const int64_t block_id) {
+    MethodMetrics::Call call(metrics, "managed_sync_to_block");
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_sync_to_block: unknown wallet %s\n", wallet_id.c_str());
+        return INTERNAL_ERROR;
+    }
+    std::lock_guard lock(wallet.lock());
+    return call.ffi([&] { return wallet_ffi_sync_to_block(wallet.handle(), static_cast<uint64_t>(block_id)); });
+}
+
+int64_t LEZCoreModule::managed_save(const std::string& wallet_id) {
+    MethodMetrics::Call call(metrics, "managed_save");
+    const WalletManager::Lease wallet = managedWallets.acquire(wallet_id);
+    if (!wallet) {
+        fprintf(stderr, "managed_save: unknown wallet %s\n", wallet_id.c_str());
+        return INTERNAL_ERROR;
+    }
+    std::lock_guard lock(wallet.lock());
+    return call.ffi([&] { return wallet_ffi_save(wallet.handle()); });
+}
+
+// === Diagnostics ===
+
+std::string LEZCoreModule::get_metrics() {
+    return metrics.snapshot().dump();
+}
+
+// === Labels ===
+
+bool LEZCoreModule::check_label_available(const std::string& label) {
+    MethodMetrics::Call call(metrics, "check_label_available");
+    const char* label_c = label.c_str();
+
+    std::shared_lock lock(walletMutex);
+    LabelAvailability label_check = call.ffi([&] { return wallet_ffi_check_label_available(
+        walletHandle,
+        label_c
+    ); });
+
+    if (label_check.error != SUCCESS) {
+        call.ffiError(label_check.error);
+        fprintf(stderr, "check_label_available: wallet FFI error %d\n", label_check.error);
+        return false;
+    }
+
+    return label_check.is_available;
+}
+
+int64_t LEZCoreModule::add_label(const std::string& label, const std::string& account_id_hex, bool is_private) {
+    MethodMetrics::Call call(metrics, "add_label");
+    const char* label_c = label.c_str();
+
+    FfiBytes32 id{};
+    if (!hexToBytes32(account_id_hex, &id)) {
+        fprintf(stderr, "wallet_ffi_add_label: invalid account_id_hex");
+        return WalletFfiError::INVALID_ACCOUNT_ID;
+    }
+
+    FfiAccountIdWithPrivacy acc_id_with_privacy = { id, is_private };
+
+    WalletWriteLock lock(walletMutex, autosave, walletHandle);
+    WalletFfiError error = call.ffi([&] { return wallet_ffi_add_label(walletHandle, label_c, acc_id_with_privacy); });
+    if (error != SUCCESS) {
         fprintf(stderr, "wallet_ffi_add_label failed : wallet FFI error %d\n", error);
+        return error;
     }
+    lock.commit();
 
     return SUCCESS;
 }
 
 std::string LEZCoreModule::resolve_label(const std::string& label) {
+    MethodMetrics::Call call(metrics, "resolve_label");
     const char* label_c = label.c_str();
 
-    AccountIdResolvedFromLabel acc_id_res = wallet_ffi_resolve_label(
+    std::shared_lock lock(walletMutex);
+    AccountIdResolvedFromLabel acc_id_res = call.ffi([&] { return wallet_ffi_resolve_label(
         walletHandle,
         label_c
-    );
+    ); });
 
     if (acc_id_res.error != SUCCESS) {
+        call.ffiError(acc_id_res.error);
         fprintf(stderr, "wallet_ffi_resolve_label failed : wallet FFI error %d\n", acc_id_res.error);
         return {};
     }
@@ -1301,6 +3136,7 @@ std::string LEZCoreModule::resolve_label(const std::string& label) {
 }
 
 std::vector<std::string> LEZCoreModule::get_all_labels_for_account(const std::string& account_id_hex, bool is_private) {
+    MethodMetrics::Call call(metrics, "get_all_labels_for_account");
     FfiAccountIdWithPrivacy acc_id_with_privacy;
 
     FfiBytes32 id{};
@@ -1312,9 +3148,11 @@ std::vector<std::string> LEZCoreModule::get_all_labels_for_account(const std::st
     acc_id_with_privacy.account_id = id;
     acc_id_with_privacy.is_private = is_private;
 
-    LabelList label_list = wallet_ffi_get_all_labels_for_account(walletHandle, acc_id_with_privacy);
+    std::shared_lock lock(walletMutex);
+    LabelList label_list = call.ffi([&] { return wallet_ffi_get_all_labels_for_account(walletHandle, acc_id_with_privacy); });
 
     if (label_list.error != SUCCESS) {
+        call.ffiError(label_list.error);
         fprintf(stderr, "wallet_ffi_get_all_labels_for_account failed : wallet FFI error %d\n", label_list.error);
         return {};
     }
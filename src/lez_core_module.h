@@ -1,11 +1,31 @@
 #ifndef LEZ_CORE_MODULE_H
 #define LEZ_CORE_MODULE_H
 
+#include <atomic>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <logos_json.h>
 
+#include "account_history.h"
+#include "account_read_cache.h"
+#include "async_requests.h"
+#include "autosave.h"
+#include "balance_tracker.h"
+#include "builtin_elfs.h"
+#include "identity_cache.h"
+#include "method_metrics.h"
+#include "program_registry.h"
+#include "prover_warmup.h"
+#include "proving_scheduler.h"
+#include "recipient_book.h"
+#include "rw_lock.h"
+#include "sync_engine.h"
+#include "tx_journal.h"
+#include "tx_watcher.h"
+#include "wallet_manager.h"
+
 extern "C" {
 #include <wallet_ffi.h>
 }
@@ -32,7 +52,19 @@ public:
     // === Wallet Lifecycle ===
     std::string create_new(const std::string& config_path, const std::string& storage_path, const std::string& statistics_path, const std::string& password);
     int64_t open(const std::string& config_path, const std::string& storage_path, const std::string& statistics_path);
+    // Saves now, whether or not anything changed since the last save.
     int64_t save();
+    // Autosave: calls that change the wallet (account creation, labels, transfers, claims,
+    // sync) mark it dirty, and a background thread saves once max_mutations changes are
+    // pending or max_delay_ms after the first of them, whichever comes first (<= 0 disables
+    // that trigger; both <= 0 turns autosave off, the default). With autosave on, the module
+    // also saves pending changes one last time when it is destroyed.
+    bool set_autosave(int64_t max_mutations, int64_t max_delay_ms);
+    // Barrier: returns once every change made before the call is saved, with the
+    // wallet_ffi_save result (SUCCESS without saving if nothing is pending).
+    int64_t flush();
+    // { enabled, max_mutations, max_delay_ms, pending_mutations, mutations, saves, save_failures }
+    std::string get_autosave_stats();
 
     int64_t restore_storage(const std::string& mnemonic, const std::string password, uint32_t depth);
 
@@ -43,6 +75,10 @@ public:
 
     // === Account Queries ===
     std::string get_balance(const std::string& account_id_hex, bool is_public);
+    // Batch form of get_balance: account_ids[i] is queried with is_public[i]. Returns one
+    // { account_id, is_public, balance, error } object per input, in input order; a bad id or
+    // FFI failure only fails its own entry (balance "" + error message), never the whole batch.
+    LogosList get_balances(const std::vector<std::string>& account_ids, const std::vector<bool>& is_public);
     std::string get_account_public(const std::string& account_id_hex);
     std::string get_account_private(const std::string& account_id_hex);
     std::string get_public_account_key(const std::string& account_id_hex);
@@ -56,6 +92,16 @@ public:
     int64_t sync_to_block(int64_t block_id);
     int64_t get_last_synced_block();
     int64_t get_current_block_height();
+    // Non-blocking sync toward target_block (<= 0: the chain head, followed as it grows) in
+    // chunks of chunk_size blocks (<= 0: 500) on a background thread. The wallet is only held
+    // for one chunk at a time, so queries and transfers keep working meanwhile. Returns false
+    // if a background sync is already running.
+    bool start_background_sync(int64_t target_block, int64_t chunk_size);
+    // { state: "idle" | "running" | "done" | "cancelled" | "failed", start_block,
+    //   current_block, target_block, blocks_per_second, error }
+    std::string get_sync_progress();
+    // Stops a running background sync after its current chunk. Returns false if none was running.
+    bool cancel_background_sync();
 
     // === Pinata claiming ===
     std::string claim_pinata(const std::string& pinata_account_id_hex, const std::string& winner_account_id_hex, const std::string& solution_le16_hex);
@@ -76,13 +122,105 @@ public:
     std::vector<uint8_t> token_elf();
     std::vector<uint8_t> amm_elf();
     std::vector<uint8_t> ata_elf();
+    // The built-in ELFs are fetched once and shared; the getters above return a copy. This
+    // returns a new descriptor for a sealed, read-only in-memory file with program_name's ELF
+    // ("authenticated_transfer", "token", "amm" or "ata") to mmap or pass on without copying.
+    // The caller must close it. -1 on failure.
+    int64_t builtin_elf_fd(const std::string& program_name);
 
     std::string send_generic_public_transaction(const std::vector<std::string>& account_ids, const std::vector<bool>& signing_requirements, const std::vector<uint32_t>& instruction, const std::string& program_id_hex);
     std::string send_generic_private_transaction(const std::vector<std::string>& account_ids, const std::vector<uint32_t>& instruction, const std::vector<uint8_t>& program_elf, const std::vector<std::vector<uint8_t>>& program_dependencies);
+    // send_generic_private_transaction with built-in programs named as for builtin_elf_fd; the
+    // module submits its shared ELF buffers directly instead of taking them over the API.
+    std::string send_builtin_private_transaction(const std::vector<std::string>& account_ids, const std::vector<uint32_t>& instruction, const std::string& program_name, const std::vector<std::string>& dependency_names);
     std::string send_program_deployment_transaction(const std::vector<uint8_t>& program_elf);
 
     bool poll_transaction_status(const std::string& tx_hash_hex);
 
+    // === Program registry ===
+    // Register a program ELF once and submit private transactions by the returned handle (hex
+    // SHA-256 of the ELF) instead of sending the ELF every time. The same bytes always get the
+    // same handle. "" if the ELF is empty or the registry is full.
+    std::string register_program(const std::vector<uint8_t>& program_elf);
+    // Registers a built-in program (names as for builtin_elf_fd) without copying it.
+    std::string register_builtin_program(const std::string& program_name);
+    bool unregister_program(const std::string& program_handle);
+    // send_generic_private_transaction with the program and its dependencies given by handle.
+    std::string send_registered_private_transaction(const std::vector<std::string>& account_ids, const std::vector<uint32_t>& instruction, const std::string& program_handle, const std::vector<std::string>& dependency_handles);
+
+    // === Recipient book ===
+    // Register a private-transfer recipient once (to_keys_json as for transfer_shielded) and pay
+    // it by the returned handle (hex SHA-256 of its keys) without parsing or copying the keys on
+    // every transfer. The same keys always get the same handle. "" if to_keys_json is malformed
+    // or the book is full.
+    std::string register_recipient(const std::string& to_keys_json);
+    bool unregister_recipient(const std::string& recipient_handle);
+    // transfer_shielded / transfer_private to a registered recipient.
+    std::string transfer_shielded_to(const std::string& from_hex, const std::string& recipient_handle, const std::string& amount_le16_hex);
+    std::string transfer_private_to(const std::string& from_hex, const std::string& recipient_handle, const std::string& amount_le16_hex);
+
+    // === Batched payouts ===
+    // Pays every { to, amount } in payouts_json (account id hex, 16-byte little-endian hex
+    // amount) from from_hex with the authenticated-transfer program (program_id_hex), through
+    // send_generic_public_transaction. The sender is resolved once and entries for the same
+    // recipient are merged into one transfer, since the program moves one balance per
+    // transaction. A malformed entry fails the whole batch before anything is sent; past that,
+    // each transfer succeeds or fails on its own. Returns { success, error, transactions,
+    // results: [{ to, amount, transfer_amount, merged_entries, success, tx_hash, error }] }
+    // with results in input order. transactions counts the transfers actually submitted;
+    // transfer_amount is what the entry's transaction paid in total, the sum of the
+    // merged_entries entries for that recipient.
+    std::string payout_public(const std::string& from_hex, const std::string& payouts_json, const std::string& program_id_hex);
+
+    // === Transaction tracking ===
+    // Hands tx_hash_hex to the module's background watcher, which polls all watched hashes in
+    // one pass (with per-hash exponential backoff) until each is confirmed or its timeout_ms
+    // runs out. Returns false for a malformed hash.
+    bool watch_transaction(const std::string& tx_hash_hex, int64_t timeout_ms);
+    // Blocks up to timeout_ms for tx_hash_hex to be confirmed, watching it first if needed.
+    // Returns { tx_hash, status: "confirmed" | "timed_out" | "pending" | "invalid" }.
+    std::string wait_for_transaction(const std::string& tx_hash_hex, int64_t timeout_ms);
+    // Confirmation / timeout events newer than since_sequence, oldest first:
+    // [{ sequence, tx_hash, status }]. Pass the last sequence seen to resume.
+    LogosList get_transaction_events(int64_t since_sequence);
+
+    // === Transaction journal ===
+    // Journals every transaction the module submits (method, accounts, amount, hash, last
+    // synced block, time) in <storage_path>.txjournal, a memory-mapped append-only file, and
+    // follows each through the watcher above; after a restart, transactions still pending are
+    // watched again. Off by default; takes effect from the next open / create_new.
+    bool set_tx_journal(bool enabled);
+    // Journaled transactions, newest first, at most limit (1..1000): [{ sequence, method,
+    // tx_hash, accounts, amount, submit_block, submitted_at_ms, status }], amount being
+    // 16-byte little-endian hex or "" and status "pending" | "confirmed" | "timed_out".
+    // account_id_hex / status "" match any. "[]" when the journal is off or an argument is bad.
+    std::string get_journal_transactions(const std::string& account_id_hex, const std::string& status, int64_t limit);
+
+    // === Account history ===
+    // Keeps a per-account history of the transactions the module submits and of the balance /
+    // nonce changes each sync_to_block (or background sync chunk) brings to the wallet's own
+    // accounts. While this or the balance events below are on, every sync reads each wallet
+    // account once more. Off by default. In memory; with the journal on, submissions are
+    // restored from it on open.
+    bool set_account_history(bool enabled);
+    // One page of account_id_hex's history, newest first: { records, next_cursor }. Records are
+    // { id, kind: "submission", block, time_ms, method, tx_hash, amount } or { id, kind:
+    // "balance", block, time_ms, previous_balance, balance, nonce }, with 16-byte
+    // little-endian hex values. Pass cursor 0 for the newest page, then next_cursor until it
+    // comes back 0. limit: 1..1000.
+    std::string get_account_history(const std::string& account_id_hex, int64_t cursor, int64_t limit);
+
+    // === Balance change events ===
+    // After each sync_to_block (or background sync chunk) that moved any of the wallet's
+    // accounts, logs one event listing just the accounts whose balance or nonce changed, so
+    // clients need not re-read every balance per block. Off by default; shares its per-sync
+    // account snapshot with the account history above. The log keeps the latest 1024 events.
+    bool set_balance_events(bool enabled);
+    // Events newer than cursor, oldest first: [{ sequence, block, changes: [{ account_id,
+    // is_public, previous_balance, balance, nonce }] }], values in 16-byte little-endian hex.
+    // Pass the last sequence seen to resume.
+    LogosList get_changes_since(int64_t cursor);
+
     // === Bridge (L1 Bedrock <-> L2) ===
     std::string bridge_withdraw(const std::string& from_hex, const std::string& bedrock_account_pk_hex, uint64_t amount);
 
@@ -91,9 +229,143 @@ public:
     std::string vault_claim(const std::string& owner_account_id_hex, const std::string& amount_le16_hex);
     std::string vault_claim_private(const std::string& owner_account_id_hex, const std::string& amount_le16_hex);
 
+    // === Recipient identifiers ===
+    // count fresh random 16-byte recipient identifiers from the module's CSPRNG, for the
+    // "identifier" field of to_keys_json when a job builds many transfers up front:
+    // ["<32 hex chars>", ...]. "[]" unless 1 <= count <= 1048576.
+    std::string random_identifiers(int64_t count);
+    // Same, as count * 16 raw bytes; empty on a bad count.
+    std::vector<uint8_t> random_identifiers_bin(int64_t count);
+
+    // === Decimal amounts ===
+    // The transfers and vault claims above with the amount as a plain decimal string
+    // ("1500000") instead of 16-byte little-endian hex. Anything but digits (surrounding
+    // whitespace aside) or a value of 2^128 or more fails the call without reaching the wallet.
+    std::string transfer_public_decimal(const std::string& from_hex, const std::string& to_hex, const std::string& amount_decimal);
+    std::string transfer_shielded_decimal(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_decimal);
+    std::string transfer_deshielded_decimal(const std::string& from_hex, const std::string& to_hex, const std::string& amount_decimal);
+    std::string transfer_private_decimal(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_decimal);
+    std::string transfer_shielded_owned_decimal(const std::string& from_hex, const std::string& to_hex, const std::string& amount_decimal);
+    std::string transfer_private_owned_decimal(const std::string& from_hex, const std::string& to_hex, const std::string& amount_decimal);
+    std::string vault_claim_decimal(const std::string& owner_account_id_hex, const std::string& amount_decimal);
+    std::string vault_claim_private_decimal(const std::string& owner_account_id_hex, const std::string& amount_decimal);
+
+    // === Binary API ===
+    // Twins of the hottest calls for service callers, with raw values instead of hex / JSON:
+    // account ids, keys and tx hashes are 32 bytes, amounts and balances 16 bytes little-endian.
+    // A wrongly sized argument fails the call. Records are laid out as documented in lez_codec.h.
+    // 16-byte balance; empty on failure.
+    std::vector<uint8_t> get_balance_bin(const std::vector<uint8_t>& account_id, bool is_public);
+    // Account record; empty on failure.
+    std::vector<uint8_t> get_account_public_bin(const std::vector<uint8_t>& account_id);
+    std::vector<uint8_t> get_account_private_bin(const std::vector<uint8_t>& account_id);
+    // 37-byte transfer record: success, WalletFfiError (INVALID_INPUT for bad arguments), tx hash.
+    std::vector<uint8_t> transfer_public_bin(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to, const std::vector<uint8_t>& amount_le16);
+    std::vector<uint8_t> transfer_shielded_bin(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to_nullifier_public_key, const std::vector<uint8_t>& to_viewing_public_key, const std::vector<uint8_t>& amount_le16);
+    std::vector<uint8_t> transfer_deshielded_bin(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to, const std::vector<uint8_t>& amount_le16);
+    std::vector<uint8_t> transfer_private_bin(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to_nullifier_public_key, const std::vector<uint8_t>& to_viewing_public_key, const std::vector<uint8_t>& amount_le16);
+    bool poll_transaction_status_bin(const std::vector<uint8_t>& tx_hash);
+
+    // === Asynchronous submission ===
+    // Non-blocking twins of the blocking submission methods above. Each queues the call on the
+    // module's worker pool and returns a ticket (> 0) immediately, or 0 if the module is shutting
+    // down. The result, collected with poll_async_result / await_async_result, is exactly the JSON
+    // string the synchronous method returns.
+    int64_t claim_pinata_async(const std::string& pinata_account_id_hex, const std::string& winner_account_id_hex, const std::string& solution_le16_hex);
+    int64_t claim_pinata_private_owned_already_initialized_async(const std::string& pinata_account_id_hex, const std::string& winner_account_id_hex, const std::string& solution_le16_hex, int64_t winner_proof_index, const std::string& winner_proof_siblings_json);
+    int64_t claim_pinata_private_owned_not_initialized_async(const std::string& pinata_account_id_hex, const std::string& winner_account_id_hex, const std::string& solution_le16_hex);
+    int64_t transfer_public_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t transfer_shielded_async(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    int64_t transfer_deshielded_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t transfer_private_async(const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    int64_t transfer_shielded_owned_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t transfer_private_owned_async(const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t bridge_withdraw_async(const std::string& from_hex, const std::string& bedrock_account_pk_hex, uint64_t amount);
+    int64_t vault_claim_async(const std::string& owner_account_id_hex, const std::string& amount_le16_hex);
+    int64_t vault_claim_private_async(const std::string& owner_account_id_hex, const std::string& amount_le16_hex);
+
+    // { ticket, status: "pending" | "done" | "unknown", method, result }. A finished result is
+    // reported once; afterwards the ticket is released and reads back as "unknown". Tickets
+    // expire: a result left uncollected for 10 minutes, or beyond the newest 4096 uncollected
+    // ones, is dropped and its ticket reads back as "unknown" too.
+    std::string poll_async_result(int64_t ticket);
+    // Same as poll_async_result, but first waits up to timeout_ms for the request to finish.
+    std::string await_async_result(int64_t ticket, int64_t timeout_ms);
+
     // === Configuration ===
     std::string get_sequencer_addr();
 
+    // === Proving ===
+    // Calls that build a ZK proof (private, shielded and deshielded transfers, private generic
+    // transactions, private claims, private account registration) are admitted through a
+    // scheduler shared by the module's own wallet and the managed ones: at most max_concurrent
+    // at once (<= 0: one per hardware thread, the default), callers blocked on the call ahead
+    // of *_async jobs. The own wallet's proofs, which all take its lock exclusively, first
+    // queue one at a time on a scheduler of their own, so its callers overtake its *_async jobs
+    // whatever max_concurrent is. With max_queued > 0, a call that would wait behind that many
+    // others in either queue fails at once with "<method>: proving queue full" (0: no limit).
+    // False for a negative max_queued.
+    bool set_proving_limits(int64_t max_concurrent, int64_t max_queued);
+    // { max_concurrent, max_queued, running, queued, queued_interactive, queued_background,
+    //   peak_queued, admitted, rejected, wait_sum_us, wait_max_us, own_wallet: { the same, for
+    //   the own wallet's queue } }; the wait distribution is in get_metrics under "proving_wait".
+    std::string get_proving_stats();
+    // Background warm-up after open / create_new: fetches the built-in program ELFs and
+    // resolves the identities of the wallet's private accounts, so the first private call does
+    // not pay for either. Off by default; enabling it does not start a run on its own.
+    bool set_prover_warmup(bool enabled);
+    // Starts a warm-up for the open wallet now; false if one is running or no wallet is open.
+    bool start_prover_warmup();
+    // { state: "cold" | "warming" | "ready" | "failed", elfs_loaded, identities_resolved,
+    //   identities_failed, elapsed_ms, error }. Calls made before "ready" work as usual.
+    std::string get_prover_readiness();
+
+    // === Managed wallets ===
+    // Wallets hosted next to the module's own one and addressed by a caller-chosen wallet_id,
+    // so one module instance can serve many customers. At most max_open of them stay open:
+    // opening another saves (wallet_ffi_save) and closes the least recently used idle one,
+    // which is reopened from its paths on its next call. Calls on different wallets run in
+    // parallel, and the *_async form runs on the module's worker pool like the other
+    // asynchronous submissions. An unknown wallet_id fails a call like INTERNAL_ERROR would.
+    // Registers and opens wallet_id; INTERNAL_ERROR if it is taken or cannot be opened.
+    int64_t open_managed_wallet(const std::string& wallet_id, const std::string& config_path, const std::string& storage_path, const std::string& statistics_path);
+    // Saves, closes and forgets wallet_id once its running calls finish; the wallet_ffi_save
+    // result (the wallet stays open if that fails).
+    int64_t close_managed_wallet(const std::string& wallet_id);
+    // <= 0: 256. Lowering it closes idle wallets right away.
+    bool set_managed_wallet_limit(int64_t max_open);
+    // { registered, open, leased, max_open, opens, evictions, save_failures }
+    std::string get_managed_wallets();
+    // The calls of the same names on the module's own wallet, on wallet_id instead. Transfers
+    // are recorded in the transaction journal and account history like the module's own, and
+    // the proof-heavy ones go through the proving scheduler; since each managed wallet has its
+    // own lock, their proofs can use a max_concurrent above 1. The read cache and balance
+    // events follow the module's own wallet only, so managed calls skip them.
+    std::string managed_create_account_public(const std::string& wallet_id);
+    LogosList managed_list_accounts(const std::string& wallet_id);
+    std::string managed_get_balance(const std::string& wallet_id, const std::string& account_id_hex, bool is_public);
+    std::string managed_get_account_public(const std::string& wallet_id, const std::string& account_id_hex);
+    std::string managed_get_account_private(const std::string& wallet_id, const std::string& account_id_hex);
+    std::string managed_transfer_public(const std::string& wallet_id, const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    std::string managed_transfer_shielded(const std::string& wallet_id, const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    std::string managed_transfer_deshielded(const std::string& wallet_id, const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    std::string managed_transfer_private(const std::string& wallet_id, const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    int64_t managed_transfer_public_async(const std::string& wallet_id, const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t managed_transfer_shielded_async(const std::string& wallet_id, const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    int64_t managed_transfer_deshielded_async(const std::string& wallet_id, const std::string& from_hex, const std::string& to_hex, const std::string& amount_le16_hex);
+    int64_t managed_transfer_private_async(const std::string& wallet_id, const std::string& from_hex, const std::string& to_keys_json, const std::string& amount_le16_hex);
+    int64_t managed_sync_to_block(const std::string& wallet_id, int64_t block_id);
+    int64_t managed_save(const std::string& wallet_id);
+
+    // === Diagnostics ===
+    // Snapshot of per-method counters since the module was created:
+    // { methods: [{ method, calls, failed_calls, ffi_errors: { "<WalletFfiError>": n },
+    //   latency, ffi_latency }] }, where each latency is { count, sum_us, max_us, p50_us,
+    // p90_us, p99_us, buckets: [{ lt_us, count }] }, dropped_calls }. ffi_latency is the time
+    // spent inside wallet_ffi; the rest of latency is the module's own work and lock waits.
+    // dropped_calls counts calls of methods the table had no room for (should stay 0).
+    std::string get_metrics();
+
     // === Labels ===
     bool check_label_available(const std::string& label);
     int64_t add_label(const std::string& label, const std::string& account_id_hex, bool is_private);
@@ -102,6 +374,40 @@ public:
 
 private:
     WalletHandle* walletHandle = nullptr;
+    // Guards walletHandle and every wallet_ffi call made through it. The module may be called
+    // from any number of host threads (and runs async submissions and the tx watcher on its
+    // own): read-only queries (balances, accounts, keys, block heights, status polls, labels)
+    // take it shared and run concurrently; everything that changes wallet state (transfers,
+    // claims, account creation, sync, save, labels, open/restore) takes it exclusively.
+    // Fair both ways (see rw_lock.h): a steady read load cannot starve submissions, and reads
+    // get in between back-to-back writes such as background sync chunks.
+    RwLock walletMutex;
+    // Declared before the background workers so it outlives them.
+    MethodMetrics metrics;
+    AccountReadCache readCache;
+    BuiltinElfs builtinElfs;
+    ProgramRegistry programRegistry;
+    RecipientBook recipientBook;
+    IdentityCache identityCache;
+    AccountHistory accountHistory;
+    BalanceTracker balanceTracker;
+    // Declared before txWatcher, whose resolutions it records.
+    TxJournal txJournal;
+    // Declared before asyncRequests: queued jobs hold slots until the pool has drained.
+    ProvingScheduler provingScheduler;
+    // Proofs on the module's own wallet queue here before taking a provingScheduler slot. They
+    // all hold walletMutex exclusively, so one at a time is all they can use, and queueing here
+    // rather than on the lock keeps callers blocked on the call ahead of *_async jobs.
+    ProvingScheduler walletProving{1, 0, &provingScheduler};
+    // Likewise for the leases of managed-wallet jobs.
+    WalletManager managedWallets;
+    AsyncRequests asyncRequests;
+    TxWatcher txWatcher;
+    SyncEngine syncEngine;
+    std::atomic<bool> txJournalOnOpen{false};
+    std::atomic<bool> proverWarmupOnOpen{false};
+    ProverWarmup proverWarmup;
+    Autosave autosave;
 };
 
 #endif // LEZ_CORE_MODULE_H
@@ -0,0 +1,148 @@
+#include "method_metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <string>
+
+namespace {
+
+// FNV-1a; method names are short literals.
+size_t hashName(const char* name) {
+    size_t hash = 14695981039346656037ull;
+    for (const char* p = name; *p; ++p) {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t bucketUpperBoundUs(const size_t bucket) {
+    return uint64_t{1} << bucket;
+}
+
+} // namespace
+
+void MethodMetrics::Histogram::record(const uint64_t nanos) {
+    const uint64_t us = nanos / 1000;
+    const size_t bucket = std::min<size_t>(std::bit_width(us), LatencyBuckets - 1);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+
+    uint64_t seen = maxNanos.load(std::memory_order_relaxed);
+    while (nanos > seen && !maxNanos.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+    }
+}
+
+// Percentiles are bucket upper bounds (capped at the observed max), so they overstate by
+// less than 2x — enough to tell microseconds from milliseconds from seconds.
+nlohmann::json MethodMetrics::Histogram::toJson() const {
+    std::array<uint64_t, LatencyBuckets> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < LatencyBuckets; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    const uint64_t maxUs = maxNanos.load(std::memory_order_relaxed) / 1000;
+
+    const auto percentile = [&](const double p) -> uint64_t {
+        if (total == 0)
+            return 0;
+        const auto rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < LatencyBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(bucketUpperBoundUs(i), maxUs);
+        }
+        return maxUs;
+    };
+
+    nlohmann::json obj = nlohmann::json::object();
+    obj["count"] = total;
+    obj["sum_us"] = sumNanos.load(std::memory_order_relaxed) / 1000;
+    obj["max_us"] = maxUs;
+    obj["p50_us"] = percentile(0.50);
+    obj["p90_us"] = percentile(0.90);
+    obj["p99_us"] = percentile(0.99);
+    nlohmann::json nonEmpty = nlohmann::json::array();
+    for (size_t i = 0; i < LatencyBuckets; ++i) {
+        if (counts[i] != 0)
+            nonEmpty.push_back({{"lt_us", bucketUpperBoundUs(i)}, {"count", counts[i]}});
+    }
+    obj["buckets"] = std::move(nonEmpty);
+    return obj;
+}
+
+MethodMetrics::Slot* MethodMetrics::slotFor(const char* method) {
+    size_t index = hashName(method) % MaxMethods;
+    for (size_t probe = 0; probe < MaxMethods; ++probe, index = (index + 1) % MaxMethods) {
+        Slot& slot = slots[index];
+        const char* current = slot.name.load(std::memory_order_acquire);
+        if (current == nullptr) {
+            if (slot.name.compare_exchange_strong(current, method, std::memory_order_acq_rel))
+                return &slot;
+            // Lost the race for this slot; `current` now holds the winner's name.
+        }
+        if (current == method || std::strcmp(current, method) == 0)
+            return &slot;
+    }
+    droppedCalls.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+nlohmann::json MethodMetrics::snapshot() const {
+    nlohmann::json methods = nlohmann::json::array();
+    for (const Slot& slot : slots) {
+        const char* name = slot.name.load(std::memory_order_acquire);
+        if (name == nullptr)
+            continue;
+
+        nlohmann::json errors = nlohmann::json::object();
+        for (size_t code = 1; code < ErrorCodes; ++code) {
+            if (const uint64_t n = slot.errors[code].load(std::memory_order_relaxed))
+                errors[code + 1 == ErrorCodes ? std::to_string(code) + "+" : std::to_string(code)] = n;
+        }
+
+        nlohmann::json entry = nlohmann::json::object();
+        entry["method"] = name;
+        entry["calls"] = slot.calls.load(std::memory_order_relaxed);
+        entry["failed_calls"] = slot.failedCalls.load(std::memory_order_relaxed);
+        entry["ffi_errors"] = std::move(errors);
+        entry["latency"] = slot.latency.toJson();
+        entry["ffi_latency"] = slot.ffiLatency.toJson();
+        methods.push_back(std::move(entry));
+    }
+    std::sort(methods.begin(), methods.end(), [](const nlohmann::json& a, const nlohmann::json& b) {
+        return a["method"].get_ref<const std::string&>() < b["method"].get_ref<const std::string&>();
+    });
+
+    nlohmann::json obj = nlohmann::json::object();
+    obj["methods"] = std::move(methods);
+    obj["dropped_calls"] = droppedCalls.load(std::memory_order_relaxed);
+    return obj;
+}
+
+MethodMetrics::Call::Call(MethodMetrics& metrics, const char* method)
+    : slot(metrics.slotFor(method)), start(Clock::now()) {}
+
+MethodMetrics::Call::~Call() {
+    if (slot == nullptr)
+        return;
+    const auto nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    slot->calls.fetch_add(1, std::memory_order_relaxed);
+    slot->latency.record(nanos);
+    if (ffiCalled)
+        slot->ffiLatency.record(ffiNanos);
+    if (failed)
+        slot->failedCalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MethodMetrics::Call::ffiError(const int64_t code) {
+    failed = true;
+    if (slot == nullptr)
+        return;
+    const size_t index = code < 0 ? ErrorCodes - 1 : std::min<size_t>(static_cast<size_t>(code), ErrorCodes - 1);
+    slot->errors[index].fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,101 @@
+#ifndef METHOD_METRICS_H
+#define METHOD_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <nlohmann/json.hpp>
+
+// Per-method call counts, latency histograms and wallet_ffi error counters, updated with
+// relaxed atomics only (no locks on the call path). Each public module method opens a
+// Call at its top; FFI invocations made through Call::ffi() are timed separately, so a
+// snapshot shows how much of a method's latency is the wallet library (sequencer RPC,
+// proving) and how much is the module itself (parsing, conversion, lock waits).
+//
+// Methods are keyed by name and get a slot on first use from a fixed open-addressing
+// table, sized at about four times the module's method count to keep probes short. A name
+// that finds the table full is not recorded, only counted in "dropped_calls";
+// tests/test_method_metrics.cpp fails once the sources use more than half the table.
+class MethodMetrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MaxMethods = 512;
+    // Bucket 0 counts calls under 1 us, bucket i calls in [2^(i-1), 2^i) us; the last
+    // bucket is open-ended (~18 min and up).
+    static constexpr size_t LatencyBuckets = 32;
+    // Error counters by WalletFfiError value; the last one also takes every larger code.
+    static constexpr size_t ErrorCodes = 16;
+
+    class Call;
+
+    nlohmann::json snapshot() const;
+
+private:
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, LatencyBuckets> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumNanos{0};
+        std::atomic<uint64_t> maxNanos{0};
+
+        void record(uint64_t nanos);
+        nlohmann::json toJson() const;
+    };
+
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> failedCalls{0};
+        std::array<std::atomic<uint64_t>, ErrorCodes> errors{};
+        Histogram latency;
+        Histogram ffiLatency;
+    };
+
+    Slot* slotFor(const char* method);
+
+    std::array<Slot, MaxMethods> slots;
+    // Calls of methods that found no slot.
+    std::atomic<uint64_t> droppedCalls{0};
+};
+
+// Scope of one public method call: records the call and its latency on destruction.
+class MethodMetrics::Call {
+public:
+    Call(MethodMetrics& metrics, const char* method);
+    ~Call();
+
+    Call(const Call&) = delete;
+    Call& operator=(const Call&) = delete;
+
+    // Runs one wallet_ffi invocation, adding its duration to the call's FFI time and, for
+    // integral / enum results, counting a non-zero value as that error code.
+    template <typename Fn>
+    auto ffi(Fn&& fn) {
+        const Clock::time_point ffiStart = Clock::now();
+        auto result = fn();
+        ffiNanos += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - ffiStart).count());
+        ffiCalled = true;
+        if constexpr (std::is_integral_v<decltype(result)> || std::is_enum_v<decltype(result)>) {
+            if (static_cast<int64_t>(result) != 0)
+                ffiError(static_cast<int64_t>(result));
+        }
+        return result;
+    }
+
+    // Counts a wallet_ffi error reported some other way (e.g. a struct's error field).
+    void ffiError(int64_t code);
+
+private:
+
+    Slot* slot;
+    Clock::time_point start;
+    uint64_t ffiNanos = 0;
+    bool ffiCalled = false;
+    bool failed = false;
+};
+
+#endif // METHOD_METRICS_H
@@ -0,0 +1,117 @@
+#include "program_registry.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#include "hex_codec.h"
+#include "sha256.h"
+
+namespace {
+
+std::string handleOf(const uint8_t* data, const size_t length) {
+    const Sha256::Digest digest = Sha256::digest(data, length);
+    return HexCodec::encode(digest.data(), digest.size());
+}
+
+std::string normalizedHandle(std::string handle) {
+    std::transform(handle.begin(), handle.end(), handle.begin(),
+                   [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return handle;
+}
+
+} // namespace
+
+std::string ProgramRegistry::add(std::vector<uint8_t> elf) {
+    if (elf.empty())
+        return {};
+    const std::string handle = handleOf(elf.data(), elf.size());
+
+    // The FfiProgram lives next to the bytes it points at; the returned pointer aliases it.
+    struct Owned {
+        std::vector<uint8_t> bytes;
+        FfiProgram program{};
+    };
+    auto owned = std::make_shared<Owned>();
+    owned->bytes = std::move(elf);
+    owned->program.elf_data = owned->bytes.data();
+    owned->program.elf_size = static_cast<uintptr_t>(owned->bytes.size());
+    return insert(handle, Program(owned, &owned->program));
+}
+
+std::string ProgramRegistry::add(Program elf) {
+    if (!elf || elf->elf_size == 0)
+        return {};
+    const std::string handle = handleOf(elf->elf_data, elf->elf_size);
+    return insert(handle, std::move(elf));
+}
+
+std::string ProgramRegistry::insert(const std::string& handle, Program elf) {
+    std::lock_guard lock(mutex);
+    if (programs.count(handle) > 0)
+        return handle;
+    if (bytes + elf->elf_size > MaxBytes) {
+        fprintf(stderr, "ProgramRegistry: full (%zu bytes registered)\n", bytes);
+        return {};
+    }
+    bytes += elf->elf_size;
+    programs.emplace(handle, std::move(elf));
+    return handle;
+}
+
+bool ProgramRegistry::remove(const std::string& handle) {
+    std::lock_guard lock(mutex);
+    const auto it = programs.find(normalizedHandle(handle));
+    if (it == programs.end())
+        return false;
+    bytes -= it->second->elf_size;
+    programs.erase(it);
+    // Prepared entries hold their own references; drop them so the bytes can go.
+    prepared.clear();
+    return true;
+}
+
+std::shared_ptr<const ProgramRegistry::Prepared> ProgramRegistry::prepare(
+    const std::string& program, const std::vector<std::string>& dependencies, std::string& missing) {
+    std::string key = normalizedHandle(program);
+    for (const std::string& dependency : dependencies)
+        key += ',' + normalizedHandle(dependency);
+
+    std::lock_guard lock(mutex);
+    const auto cached = prepared.find(key);
+    if (cached != prepared.end())
+        return cached->second;
+
+    auto entry = std::make_shared<Prepared>();
+    entry->programs.reserve(1 + dependencies.size());
+    for (size_t i = 0; i <= dependencies.size(); ++i) {
+        const std::string handle = normalizedHandle(i == 0 ? program : dependencies[i - 1]);
+        const auto it = programs.find(handle);
+        if (it == programs.end()) {
+            missing = handle;
+            return nullptr;
+        }
+        entry->programs.push_back(it->second);
+    }
+    entry->dependencies.reserve(dependencies.size());
+    for (size_t i = 1; i < entry->programs.size(); ++i)
+        entry->dependencies.push_back(*entry->programs[i]);
+    entry->ffi.program = *entry->programs[0];
+    entry->ffi.deps = entry->dependencies.data();
+    entry->ffi.deps_size = static_cast<uintptr_t>(entry->dependencies.size());
+
+    if (prepared.size() >= MaxPrepared)
+        prepared.clear();
+    prepared.emplace(std::move(key), entry);
+    return entry;
+}
+
+size_t ProgramRegistry::size() const {
+    std::lock_guard lock(mutex);
+    return programs.size();
+}
+
+size_t ProgramRegistry::totalBytes() const {
+    std::lock_guard lock(mutex);
+    return bytes;
+}
@@ -0,0 +1,64 @@
+#ifndef PROGRAM_REGISTRY_H
+#define PROGRAM_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Content-addressed store of program ELFs for private transactions. An ELF is registered
+// once under its handle, the lowercase hex SHA-256 of its bytes, and later submissions name
+// it by handle instead of carrying the bytes again. Registering the same bytes twice yields
+// the same handle and keeps a single copy.
+//
+// Each distinct (program, dependencies) combination that gets submitted is also kept
+// prepared: the FfiProgramWithDependencies, its dependency array and references to every
+// ELF involved, ready to hand to wallet_ffi as is.
+class ProgramRegistry {
+public:
+    // An ELF in wallet_ffi's layout; the pointer keeps the bytes alive.
+    using Program = std::shared_ptr<const FfiProgram>;
+
+    struct Prepared {
+        std::vector<Program> programs;
+        std::vector<FfiProgram> dependencies;
+        // Points into `programs` / `dependencies`.
+        FfiProgramWithDependencies ffi{};
+    };
+
+    // Upper bound on the registered ELF bytes; registrations past it are refused.
+    static constexpr size_t MaxBytes = size_t{256} << 20;
+    // Upper bound on prepared combinations; the set is simply dropped when it grows past it.
+    static constexpr size_t MaxPrepared = 256;
+
+    // Both return the handle, or "" for an empty ELF or when the registry is full.
+    std::string add(std::vector<uint8_t> elf);
+    // Registers a buffer owned elsewhere (e.g. a built-in ELF) without copying it.
+    std::string add(Program elf);
+
+    bool remove(const std::string& handle);
+
+    // Null if `program` or any dependency is not registered; `missing` then names it.
+    std::shared_ptr<const Prepared> prepare(const std::string& program, const std::vector<std::string>& dependencies, std::string& missing);
+
+    size_t size() const;
+    size_t totalBytes() const;
+
+private:
+    std::string insert(const std::string& handle, Program elf);
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Program> programs;
+    // Keyed by the handles joined with ','.
+    std::unordered_map<std::string, std::shared_ptr<const Prepared>> prepared;
+    size_t bytes = 0;
+};
+
+#endif // PROGRAM_REGISTRY_H
@@ -0,0 +1,79 @@
+#include "prover_warmup.h"
+
+ProverWarmup::ProverWarmup(Callbacks callbacks) : callbacks(std::move(callbacks)) {}
+
+ProverWarmup::~ProverWarmup() {
+    stop();
+}
+
+bool ProverWarmup::start() {
+    std::lock_guard lock(mutex);
+    if (current.state == State::Warming)
+        return false;
+    // The previous run has published its final state, so its thread is about to exit.
+    if (thread.joinable())
+        thread.join();
+
+    current = Progress{};
+    current.state = State::Warming;
+    startedAt = Clock::now();
+    stopping = false;
+    thread = std::thread([this] { run(); });
+    return true;
+}
+
+ProverWarmup::Progress ProverWarmup::progress() const {
+    std::lock_guard lock(mutex);
+    Progress snapshot = current;
+    if (snapshot.state == State::Warming)
+        snapshot.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startedAt).count();
+    return snapshot;
+}
+
+void ProverWarmup::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    if (thread.joinable())
+        thread.join();
+}
+
+void ProverWarmup::run() {
+    for (size_t i = 0; i < callbacks.elfCount; ++i) {
+        if (stopRequested())
+            return finish(State::Cold);
+        if (const int error = callbacks.loadElf(i); error != 0)
+            return finish(State::Failed, "builtin ELF fetch: wallet FFI error " + std::to_string(error));
+        std::lock_guard lock(mutex);
+        ++current.elfsLoaded;
+    }
+
+    std::vector<FfiBytes32> ids;
+    if (const int error = callbacks.privateAccounts(ids); error != 0)
+        return finish(State::Failed, "list_accounts: wallet FFI error " + std::to_string(error));
+
+    for (const FfiBytes32& id : ids) {
+        if (stopRequested())
+            return finish(State::Cold);
+        const int error = callbacks.resolveIdentity(id);
+        std::lock_guard lock(mutex);
+        if (error == 0)
+            ++current.identitiesResolved;
+        else
+            ++current.identitiesFailed;
+    }
+    finish(State::Ready);
+}
+
+bool ProverWarmup::stopRequested() {
+    std::lock_guard lock(mutex);
+    return stopping;
+}
+
+void ProverWarmup::finish(const State state, const std::string& error) {
+    std::lock_guard lock(mutex);
+    current.state = state;
+    current.error = error;
+    current.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startedAt).count();
+}
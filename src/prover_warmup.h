@@ -0,0 +1,73 @@
+#ifndef PROVER_WARMUP_H
+#define PROVER_WARMUP_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Background preparation for the first private operation after a wallet is opened: fetches
+// the built-in program ELFs and resolves the identities of the wallet's own private accounts,
+// so that the first private or shielded call does not pay for either. Each step goes through
+// a callback that takes whatever lock it needs for just that step, so the wallet stays usable
+// throughout. Readiness is advisory: calls made before it are served as before, only slower.
+class ProverWarmup {
+public:
+    enum class State { Cold, Warming, Ready, Failed };
+
+    struct Progress {
+        State state = State::Cold;
+        size_t elfsLoaded = 0;
+        size_t identitiesResolved = 0;
+        // Private accounts whose identity could not be resolved; they resolve on first use.
+        size_t identitiesFailed = 0;
+        int64_t elapsedMs = 0;
+        std::string error;
+    };
+
+    // Each callback returns a WalletFfiError-style code, 0 on success.
+    struct Callbacks {
+        size_t elfCount = 0;
+        std::function<int(size_t index)> loadElf;
+        std::function<int(std::vector<FfiBytes32>& ids)> privateAccounts;
+        std::function<int(const FfiBytes32& id)> resolveIdentity;
+    };
+
+    explicit ProverWarmup(Callbacks callbacks);
+    ~ProverWarmup();
+
+    ProverWarmup(const ProverWarmup&) = delete;
+    ProverWarmup& operator=(const ProverWarmup&) = delete;
+
+    // Returns false if a warm-up is already running.
+    bool start();
+    Progress progress() const;
+
+    // Abandons a running warm-up after its current step and joins it.
+    void stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    bool stopRequested();
+    void finish(State state, const std::string& error = {});
+
+    const Callbacks callbacks;
+
+    mutable std::mutex mutex;
+    Progress current;
+    Clock::time_point startedAt;
+    bool stopping = false;
+    std::thread thread;
+};
+
+#endif // PROVER_WARMUP_H
@@ -0,0 +1,138 @@
+#include "proving_scheduler.h"
+
+#include <algorithm>
+
+namespace {
+
+size_t concurrencyOrDefault(const size_t maxConcurrent) {
+    if (maxConcurrent > 0)
+        return maxConcurrent;
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+ProvingScheduler::Slot::Slot(Slot&& other) noexcept : scheduler(other.scheduler) {
+    other.scheduler = nullptr;
+}
+
+ProvingScheduler::Slot& ProvingScheduler::Slot::operator=(Slot&& other) noexcept {
+    if (this != &other) {
+        if (scheduler)
+            scheduler->release();
+        scheduler = other.scheduler;
+        other.scheduler = nullptr;
+    }
+    return *this;
+}
+
+ProvingScheduler::Slot::~Slot() {
+    if (scheduler)
+        scheduler->release();
+}
+
+ProvingScheduler::ProvingScheduler(const size_t maxConcurrent, const size_t maxQueued, ProvingScheduler* parent)
+    : parent(parent), maxConcurrent(concurrencyOrDefault(maxConcurrent)), maxQueued(maxQueued) {}
+
+ProvingScheduler::Slot ProvingScheduler::acquire(const Priority priority) {
+    const Clock::time_point start = Clock::now();
+    std::unique_lock lock(mutex);
+    const uint64_t ticket = nextTicket++;
+    std::deque<uint64_t>& queue = waiting[static_cast<size_t>(priority)];
+    queue.push_back(ticket);
+
+    if (!mayRunLocked(priority, ticket)) {
+        if (maxQueued > 0 && queuedLocked() > maxQueued) {
+            queue.pop_back();
+            ++rejectedCount;
+            return Slot();
+        }
+        peakQueued = std::max(peakQueued, queuedLocked());
+        admitted.wait(lock, [&] { return mayRunLocked(priority, ticket); });
+    }
+
+    queue.pop_front();
+    ++running;
+    ++admittedCount;
+    const auto waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    waitSumMicros += waited;
+    waitMaxMicros = std::max(waitMaxMicros, waited);
+    lock.unlock();
+    // The next in line may be admissible too (a free slot, or a raised limit).
+    admitted.notify_all();
+
+    if (parent) {
+        // Our release() hands the parent's slot back along with ours.
+        Slot outer = parent->acquire(priority);
+        if (!outer) {
+            {
+                std::lock_guard relock(mutex);
+                --admittedCount;
+                ++rejectedCount;
+            }
+            releaseOwn();
+            return Slot();
+        }
+        outer.scheduler = nullptr;
+    }
+    return Slot(this);
+}
+
+void ProvingScheduler::configure(const size_t newMaxConcurrent, const size_t newMaxQueued) {
+    {
+        std::lock_guard lock(mutex);
+        maxConcurrent = concurrencyOrDefault(newMaxConcurrent);
+        maxQueued = newMaxQueued;
+    }
+    admitted.notify_all();
+}
+
+nlohmann::json ProvingScheduler::snapshot() const {
+    std::lock_guard lock(mutex);
+    nlohmann::json obj = nlohmann::json::object();
+    obj["max_concurrent"] = maxConcurrent;
+    obj["max_queued"] = maxQueued;
+    obj["running"] = running;
+    obj["queued"] = queuedLocked();
+    obj["queued_interactive"] = waiting[static_cast<size_t>(Priority::Interactive)].size();
+    obj["queued_background"] = waiting[static_cast<size_t>(Priority::Background)].size();
+    obj["peak_queued"] = peakQueued;
+    obj["admitted"] = admittedCount;
+    obj["rejected"] = rejectedCount;
+    obj["wait_sum_us"] = waitSumMicros;
+    obj["wait_max_us"] = waitMaxMicros;
+    return obj;
+}
+
+void ProvingScheduler::release() {
+    releaseOwn();
+    if (parent)
+        parent->release();
+}
+
+void ProvingScheduler::releaseOwn() {
+    {
+        std::lock_guard lock(mutex);
+        --running;
+    }
+    admitted.notify_all();
+}
+
+// A waiter runs once a slot is free, it heads its own queue and no higher priority is waiting.
+bool ProvingScheduler::mayRunLocked(const Priority priority, const uint64_t ticket) const {
+    if (running >= maxConcurrent)
+        return false;
+    const size_t level = static_cast<size_t>(priority);
+    for (size_t higher = 0; higher < level; ++higher) {
+        if (!waiting[higher].empty())
+            return false;
+    }
+    return waiting[level].front() == ticket;
+}
+
+size_t ProvingScheduler::queuedLocked() const {
+    size_t total = 0;
+    for (const std::deque<uint64_t>& queue : waiting)
+        total += queue.size();
+    return total;
+}
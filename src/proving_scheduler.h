@@ -0,0 +1,84 @@
+#ifndef PROVING_SCHEDULER_H
+#define PROVING_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+// Admission control for the wallet_ffi calls that build a ZK proof (private, shielded and
+// deshielded transfers, private generic transactions and claims). At most maxConcurrent of
+// them are let through at a time; the rest wait in line, interactive callers ahead of
+// background work and first come, first served within a priority. With maxQueued > 0 a call
+// that would have to wait behind that many others is turned away instead, so a burst fails
+// fast rather than stretching every caller's latency.
+//
+// A scheduler may have a parent: its slots are then only granted once the parent admits the
+// call too, so a narrow per-wallet queue can order its own callers while a shared parent caps
+// the proofs of every wallet together.
+class ProvingScheduler {
+public:
+    enum class Priority { Interactive, Background };
+    static constexpr size_t PriorityCount = 2;
+
+    // Held for the duration of one proof-heavy call; releases its slot on destruction. An
+    // empty Slot means the call was not admitted.
+    class Slot {
+    public:
+        Slot() = default;
+        Slot(Slot&& other) noexcept;
+        Slot& operator=(Slot&& other) noexcept;
+        ~Slot();
+
+        explicit operator bool() const { return scheduler != nullptr; }
+
+    private:
+        friend class ProvingScheduler;
+        explicit Slot(ProvingScheduler* scheduler) : scheduler(scheduler) {}
+
+        ProvingScheduler* scheduler = nullptr;
+    };
+
+    // maxConcurrent 0: one per hardware thread. maxQueued 0: no limit.
+    explicit ProvingScheduler(size_t maxConcurrent = 0, size_t maxQueued = 0, ProvingScheduler* parent = nullptr);
+
+    // Blocks until admitted, here and then by the parent; empty if either queue is full.
+    Slot acquire(Priority priority);
+
+    // Takes effect for the next admission; calls already running keep their slots.
+    void configure(size_t maxConcurrent, size_t maxQueued);
+
+    // { max_concurrent, max_queued, running, queued, queued_interactive, queued_background,
+    //   peak_queued, admitted, rejected, wait_sum_us, wait_max_us }
+    nlohmann::json snapshot() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void release();
+    // Gives back this scheduler's slot only, not the parent's.
+    void releaseOwn();
+    bool mayRunLocked(Priority priority, uint64_t ticket) const;
+    size_t queuedLocked() const;
+
+    ProvingScheduler* const parent;
+    mutable std::mutex mutex;
+    std::condition_variable admitted;
+    std::deque<uint64_t> waiting[PriorityCount];
+    uint64_t nextTicket = 0;
+    size_t maxConcurrent;
+    size_t maxQueued;
+    size_t running = 0;
+    size_t peakQueued = 0;
+    uint64_t admittedCount = 0;
+    uint64_t rejectedCount = 0;
+    uint64_t waitSumMicros = 0;
+    uint64_t waitMaxMicros = 0;
+};
+
+#endif // PROVING_SCHEDULER_H
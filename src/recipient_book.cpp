@@ -0,0 +1,76 @@
+#include "recipient_book.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+#include "hex_codec.h"
+#include "lez_codec.h"
+#include "sha256.h"
+
+namespace {
+
+// npk[32] || has_identifier[1] || identifier[16] || vpk[...]
+std::string handleOf(const RecipientBook::Recipient& recipient) {
+    std::vector<uint8_t> material(32 + 1 + 16 + recipient.viewingPublicKey.size());
+    memcpy(material.data(), recipient.keys.nullifier_public_key.data, 32);
+    material[32] = recipient.hasIdentifier ? 1 : 0;
+    if (recipient.hasIdentifier)
+        memcpy(material.data() + 33, recipient.identifier.data, 16);
+    if (!recipient.viewingPublicKey.empty())
+        memcpy(material.data() + 49, recipient.viewingPublicKey.data(), recipient.viewingPublicKey.size());
+    const Sha256::Digest digest = Sha256::digest(material.data(), material.size());
+    return HexCodec::encode(digest.data(), digest.size());
+}
+
+std::string normalizedHandle(std::string handle) {
+    std::transform(handle.begin(), handle.end(), handle.begin(),
+                   [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return handle;
+}
+
+} // namespace
+
+RecipientBook::Entry RecipientBook::parse(const std::string& toKeysJson) {
+    auto recipient = std::make_shared<Recipient>();
+    if (!LEZCodec::jsonToRecipientKeys(toKeysJson, &recipient->keys.nullifier_public_key, recipient->viewingPublicKey,
+                                       &recipient->identifier, &recipient->hasIdentifier))
+        return nullptr;
+    if (!recipient->viewingPublicKey.empty()) {
+        recipient->keys.viewing_public_key = recipient->viewingPublicKey.data();
+        recipient->keys.viewing_public_key_len = static_cast<uintptr_t>(recipient->viewingPublicKey.size());
+    }
+    return recipient;
+}
+
+std::string RecipientBook::add(const Entry& recipient) {
+    const std::string handle = handleOf(*recipient);
+    std::lock_guard lock(mutex);
+    if (recipients.count(handle) > 0)
+        return handle;
+    if (recipients.size() >= MaxRecipients) {
+        fprintf(stderr, "RecipientBook: full (%zu recipients)\n", recipients.size());
+        return {};
+    }
+    recipients.emplace(handle, recipient);
+    return handle;
+}
+
+RecipientBook::Entry RecipientBook::get(const std::string& handle) const {
+    std::lock_guard lock(mutex);
+    auto it = recipients.find(handle);
+    if (it == recipients.end())
+        it = recipients.find(normalizedHandle(handle));
+    return it == recipients.end() ? nullptr : it->second;
+}
+
+bool RecipientBook::remove(const std::string& handle) {
+    std::lock_guard lock(mutex);
+    return recipients.erase(normalizedHandle(handle)) > 0;
+}
+
+size_t RecipientBook::size() const {
+    std::lock_guard lock(mutex);
+    return recipients.size();
+}
@@ -0,0 +1,51 @@
+#ifndef RECIPIENT_BOOK_H
+#define RECIPIENT_BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Private-transfer recipients parsed once and kept ready for wallet_ffi. A recipient is added
+// from its to_keys_json (nullifier public key, optional viewing public key and identifier) and
+// named afterwards by handle, the lowercase hex SHA-256 of those keys, so recurring transfers
+// to the same recipient skip the JSON parse and the viewing key copy. The same keys always get
+// the same handle.
+class RecipientBook {
+public:
+    struct Recipient {
+        std::vector<uint8_t> viewingPublicKey;
+        // Unset: every transfer picks a fresh random identifier.
+        bool hasIdentifier = false;
+        FfiU128 identifier{};
+        // viewing_public_key points into viewingPublicKey.
+        FfiPrivateAccountKeys keys{};
+    };
+    using Entry = std::shared_ptr<const Recipient>;
+
+    static constexpr size_t MaxRecipients = size_t{1} << 18;
+
+    // Parses to_keys_json as transfer_shielded / transfer_private take it; null if malformed.
+    static Entry parse(const std::string& toKeysJson);
+
+    // Returns the handle, or "" when the book is full.
+    std::string add(const Entry& recipient);
+    // Null for an unknown handle.
+    Entry get(const std::string& handle) const;
+    bool remove(const std::string& handle);
+
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> recipients;
+};
+
+#endif // RECIPIENT_BOOK_H
@@ -0,0 +1,59 @@
+#include "rw_lock.h"
+
+void RwLock::lock() {
+    std::unique_lock guard(mutex);
+    ++waitingWriters;
+    writerCanEnter.wait(guard, [this] { return !writerActive && activeReaders == 0 && readerSlots == 0; });
+    --waitingWriters;
+    writerActive = true;
+}
+
+bool RwLock::try_lock() {
+    std::lock_guard guard(mutex);
+    if (writerActive || activeReaders > 0 || readerSlots > 0)
+        return false;
+    writerActive = true;
+    return true;
+}
+
+void RwLock::unlock() {
+    {
+        std::lock_guard guard(mutex);
+        writerActive = false;
+        // Everyone who queued behind this writer goes before the next one.
+        readerSlots = waitingReaders;
+    }
+    readersCanEnter.notify_all();
+    writerCanEnter.notify_one();
+}
+
+bool RwLock::admitReaderLocked() {
+    if (writerActive || (waitingWriters > 0 && readerSlots == 0))
+        return false;
+    if (readerSlots > 0)
+        --readerSlots;
+    ++activeReaders;
+    return true;
+}
+
+void RwLock::lock_shared() {
+    std::unique_lock guard(mutex);
+    ++waitingReaders;
+    readersCanEnter.wait(guard, [this] { return admitReaderLocked(); });
+    --waitingReaders;
+}
+
+bool RwLock::try_lock_shared() {
+    std::lock_guard guard(mutex);
+    return admitReaderLocked();
+}
+
+void RwLock::unlock_shared() {
+    bool wakeWriter = false;
+    {
+        std::lock_guard guard(mutex);
+        wakeWriter = --activeReaders == 0 && readerSlots == 0;
+    }
+    if (wakeWriter)
+        writerCanEnter.notify_one();
+}
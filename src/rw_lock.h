@@ -0,0 +1,42 @@
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+// Reader/writer lock usable with std::shared_lock / std::lock_guard, fair in both
+// directions. std::shared_mutex makes no fairness promise (glibc prefers readers), so a
+// steady stream of read queries could hold off a transfer indefinitely; a plain
+// writer-preferring lock has the opposite problem when writers queue back to back (e.g.
+// background sync chunks). Here:
+//   - a waiting writer stops new readers from entering, so it goes next once the readers
+//     already inside finish;
+//   - when a writer unlocks, every reader queued behind it is let in before the next
+//     writer, so reads interleave between consecutive writes.
+class RwLock {
+public:
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+private:
+    // Whether a reader may enter now; consumes a reader slot if it does. Requires `mutex`.
+    bool admitReaderLocked();
+
+    std::mutex mutex;
+    std::condition_variable readersCanEnter;
+    std::condition_variable writerCanEnter;
+    int activeReaders = 0;
+    int waitingReaders = 0;
+    int waitingWriters = 0;
+    // Readers admitted ahead of waiting writers by the last writer's unlock.
+    int readerSlots = 0;
+    bool writerActive = false;
+};
+
+#endif // RW_LOCK_H
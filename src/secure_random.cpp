@@ -0,0 +1,179 @@
+#include "secure_random.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace {
+
+constexpr size_t KeySize = 32;
+constexpr size_t BlockSize = 64;
+constexpr size_t BlocksPerRefill = 16;
+constexpr size_t BufferSize = BlockSize * BlocksPerRefill;
+
+// Bumped in the child after every fork(); a thread whose generator was seeded under an older
+// generation reseeds before drawing.
+std::atomic<uint64_t> forkGeneration{0};
+std::once_flag forkHandlerOnce;
+
+inline uint32_t rotl(const uint32_t x, const int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline uint32_t loadLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline void storeLe32(uint8_t* p, const uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+inline void quarterRound(uint32_t (&x)[16], const int a, const int b, const int c, const int d) {
+    x[a] += x[b];
+    x[d] = rotl(x[d] ^ x[a], 16);
+    x[c] += x[d];
+    x[b] = rotl(x[b] ^ x[c], 12);
+    x[a] += x[b];
+    x[d] = rotl(x[d] ^ x[a], 8);
+    x[c] += x[d];
+    x[b] = rotl(x[b] ^ x[c], 7);
+}
+
+void osRandom(uint8_t* out, size_t length) {
+#if defined(__linux__)
+    while (length > 0) {
+        const ssize_t n = getrandom(out, length, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break; // ENOSYS on very old kernels: fall through to random_device
+        }
+        out += n;
+        length -= static_cast<size_t>(n);
+    }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    arc4random_buf(out, length);
+    length = 0;
+#endif
+    if (length == 0)
+        return;
+    try {
+        std::random_device device;
+        while (length > 0) {
+            const uint32_t word = device();
+            const size_t n = length < sizeof(word) ? length : sizeof(word);
+            memcpy(out, &word, n);
+            out += n;
+            length -= n;
+        }
+    } catch (const std::exception& e) {
+        // Handing out predictable identifiers is worse than not running at all.
+        fprintf(stderr, "secure_random: no entropy source available: %s\n", e.what());
+        abort();
+    }
+}
+
+void onForkChild() {
+    forkGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+class Generator {
+public:
+    void fill(uint8_t* out, size_t length) {
+        const uint64_t generation = forkGeneration.load(std::memory_order_relaxed);
+        if (!seeded || generation != seededGeneration || sinceSeed >= SecureRandom::ReseedBytes)
+            reseed(generation);
+
+        sinceSeed += length;
+        while (length > 0) {
+            if (position == BufferSize)
+                refill();
+            const size_t n = length < BufferSize - position ? length : BufferSize - position;
+            memcpy(out, buffer + position, n);
+            memset(buffer + position, 0, n);
+            position += n;
+            out += n;
+            length -= n;
+        }
+    }
+
+private:
+    void reseed(const uint64_t generation) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::call_once(forkHandlerOnce, [] { pthread_atfork(nullptr, nullptr, onForkChild); });
+#endif
+        osRandom(key, KeySize);
+        seeded = true;
+        seededGeneration = generation;
+        sinceSeed = 0;
+        refill();
+    }
+
+    // Fast key erasure: the first KeySize bytes of each fresh block of keystream become the
+    // next key and are never handed out.
+    void refill() {
+        static constexpr uint8_t nonce[12] = {};
+        for (size_t i = 0; i < BlocksPerRefill; ++i)
+            SecureRandom::chacha20Block(key, static_cast<uint32_t>(i), nonce, buffer + i * BlockSize);
+        memcpy(key, buffer, KeySize);
+        memset(buffer, 0, KeySize);
+        position = KeySize;
+    }
+
+    uint8_t key[KeySize] = {};
+    uint8_t buffer[BufferSize] = {};
+    size_t position = BufferSize;
+    size_t sinceSeed = 0;
+    uint64_t seededGeneration = 0;
+    bool seeded = false;
+};
+
+} // namespace
+
+namespace SecureRandom {
+
+void fill(uint8_t* out, const size_t length) {
+    thread_local Generator generator;
+    generator.fill(out, length);
+}
+
+void chacha20Block(const uint8_t* key, const uint32_t counter, const uint8_t* nonce, uint8_t* out) {
+    uint32_t input[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+    for (int i = 0; i < 8; ++i)
+        input[4 + i] = loadLe32(key + i * 4);
+    input[12] = counter;
+    for (int i = 0; i < 3; ++i)
+        input[13 + i] = loadLe32(nonce + i * 4);
+
+    uint32_t x[16];
+    memcpy(x, input, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        quarterRound(x, 0, 4, 8, 12);
+        quarterRound(x, 1, 5, 9, 13);
+        quarterRound(x, 2, 6, 10, 14);
+        quarterRound(x, 3, 7, 11, 15);
+        quarterRound(x, 0, 5, 10, 15);
+        quarterRound(x, 1, 6, 11, 12);
+        quarterRound(x, 2, 7, 8, 13);
+        quarterRound(x, 3, 4, 9, 14);
+    }
+    for (int i = 0; i < 16; ++i)
+        storeLe32(out + i * 4, x[i] + input[i]);
+}
+
+} // namespace SecureRandom
@@ -0,0 +1,26 @@
+#ifndef SECURE_RANDOM_H
+#define SECURE_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Cryptographically secure random bytes (recipient identifiers and anything else an observer
+// must not be able to predict). Every thread has its own ChaCha20 generator, so draws take no
+// lock: it is seeded from the OS (getrandom / arc4random_buf) on first use and hands out bytes
+// from a block of keystream, refilled as it runs out. Each refill rekeys the generator from
+// its own output and handed-out bytes are wiped from the block, so a later state does not
+// reveal earlier output. A forked child reseeds before its first draw instead of repeating
+// the parent's stream, and every thread reseeds from the OS again after ReseedBytes.
+namespace SecureRandom {
+
+    constexpr size_t ReseedBytes = size_t{1} << 20;
+
+    void fill(uint8_t* out, size_t length);
+
+    // One RFC 8439 ChaCha20 block (32-byte key, 12-byte nonce, 64 bytes out); exposed for the
+    // known-answer tests.
+    void chacha20Block(const uint8_t* key, uint32_t counter, const uint8_t* nonce, uint8_t* out);
+
+} // namespace SecureRandom
+
+#endif // SECURE_RANDOM_H
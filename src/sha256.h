@@ -0,0 +1,18 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Plain FIPS 180-4 SHA-256, for content-addressing program ELFs. Not constant-time and not
+// meant for secrets.
+namespace Sha256 {
+
+    using Digest = std::array<uint8_t, 32>;
+
+    Digest digest(const uint8_t* data, size_t length);
+
+} // namespace Sha256
+
+#endif // SHA256_H
@@ -0,0 +1,124 @@
+#include "sync_engine.h"
+
+#include <algorithm>
+
+SyncEngine::SyncEngine(Callbacks callbacks) : callbacks(std::move(callbacks)) {}
+
+SyncEngine::~SyncEngine() {
+    stop();
+}
+
+bool SyncEngine::start(const uint64_t targetBlock, const uint64_t chunkSize) {
+    std::lock_guard lock(mutex);
+    if (stopping || current.state == State::Running)
+        return false;
+    // The previous run has published its final state, so its thread is about to exit.
+    if (thread.joinable())
+        thread.join();
+
+    current = Progress{};
+    current.state = State::Running;
+    current.targetBlock = targetBlock;
+    startedAt = Clock::now();
+    cancelRequested = false;
+    thread = std::thread([this, targetBlock, chunkSize] {
+        run(targetBlock, chunkSize > 0 ? chunkSize : DefaultChunkSize);
+    });
+    return true;
+}
+
+bool SyncEngine::cancel() {
+    std::lock_guard lock(mutex);
+    if (current.state != State::Running)
+        return false;
+    cancelRequested = true;
+    return true;
+}
+
+SyncEngine::Progress SyncEngine::progress() const {
+    std::lock_guard lock(mutex);
+    return current;
+}
+
+void SyncEngine::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        cancelRequested = true;
+    }
+    if (thread.joinable())
+        thread.join();
+}
+
+void SyncEngine::run(uint64_t targetBlock, const uint64_t chunkSize) {
+    const bool followHead = targetBlock == 0;
+
+    uint64_t block = 0;
+    if (const int error = callbacks.lastSyncedBlock(block); error != 0) {
+        finish(State::Failed, "get_last_synced_block: wallet FFI error " + std::to_string(error));
+        return;
+    }
+    if (followHead) {
+        if (const int error = callbacks.currentBlockHeight(targetBlock); error != 0) {
+            finish(State::Failed, "get_current_block_height: wallet FFI error " + std::to_string(error));
+            return;
+        }
+    }
+    {
+        std::lock_guard lock(mutex);
+        current.startBlock = block;
+        current.currentBlock = block;
+        current.targetBlock = targetBlock;
+    }
+
+    while (true) {
+        {
+            std::lock_guard lock(mutex);
+            if (cancelRequested)
+                break;
+        }
+
+        if (block >= targetBlock) {
+            if (!followHead)
+                break;
+            // The chain kept growing while we synced: chase the new head.
+            uint64_t head = 0;
+            if (const int error = callbacks.currentBlockHeight(head); error != 0) {
+                finish(State::Failed, "get_current_block_height: wallet FFI error " + std::to_string(error));
+                return;
+            }
+            if (head <= targetBlock)
+                break;
+            targetBlock = head;
+            std::lock_guard lock(mutex);
+            current.targetBlock = head;
+            continue;
+        }
+
+        const uint64_t next = block + std::min(chunkSize, targetBlock - block);
+        if (const int error = callbacks.syncTo(next); error != 0) {
+            finish(State::Failed, "sync_to_block(" + std::to_string(next) + "): wallet FFI error " + std::to_string(error));
+            return;
+        }
+        block = next;
+
+        std::lock_guard lock(mutex);
+        current.currentBlock = block;
+        const double seconds = std::chrono::duration<double>(Clock::now() - startedAt).count();
+        if (seconds > 0)
+            current.blocksPerSecond = static_cast<double>(block - current.startBlock) / seconds;
+    }
+
+    bool cancelled = false;
+    {
+        std::lock_guard lock(mutex);
+        cancelled = cancelRequested && block < current.targetBlock;
+    }
+    finish(cancelled ? State::Cancelled : State::Done);
+}
+
+void SyncEngine::finish(const State state, const std::string& error) {
+    std::lock_guard lock(mutex);
+    current.state = state;
+    current.error = error;
+}
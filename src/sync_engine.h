@@ -0,0 +1,70 @@
+#ifndef SYNC_ENGINE_H
+#define SYNC_ENGINE_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Background block sync in bounded chunks. A single wallet_ffi_sync_to_block call over a long
+// range holds the wallet for minutes; the engine instead advances at most `chunkSize` blocks
+// per call, so whatever lock the callbacks take is released between chunks and other calls
+// interleave. Progress is published after every chunk and a cancel takes effect at the next
+// chunk boundary.
+class SyncEngine {
+public:
+    enum class State { Idle, Running, Done, Cancelled, Failed };
+
+    struct Progress {
+        State state = State::Idle;
+        uint64_t startBlock = 0;
+        uint64_t currentBlock = 0;
+        uint64_t targetBlock = 0;
+        double blocksPerSecond = 0;
+        std::string error;
+    };
+
+    // Each callback returns a WalletFfiError-style code, 0 on success.
+    struct Callbacks {
+        std::function<int(uint64_t& block)> lastSyncedBlock;
+        std::function<int(uint64_t& height)> currentBlockHeight;
+        std::function<int(uint64_t block)> syncTo;
+    };
+
+    static constexpr uint64_t DefaultChunkSize = 500;
+
+    explicit SyncEngine(Callbacks callbacks);
+    ~SyncEngine();
+
+    SyncEngine(const SyncEngine&) = delete;
+    SyncEngine& operator=(const SyncEngine&) = delete;
+
+    // Starts syncing toward `targetBlock`; 0 follows the chain head, re-reading it whenever
+    // the previous head is reached. A `chunkSize` of 0 uses DefaultChunkSize. Returns false if
+    // a sync is already running.
+    bool start(uint64_t targetBlock, uint64_t chunkSize);
+    // Returns false if no sync was running.
+    bool cancel();
+    Progress progress() const;
+
+    void stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run(uint64_t targetBlock, uint64_t chunkSize);
+    void finish(State state, const std::string& error = {});
+
+    const Callbacks callbacks;
+
+    mutable std::mutex mutex;
+    Progress current;
+    Clock::time_point startedAt;
+    bool cancelRequested = false;
+    bool stopping = false;
+    std::thread thread;
+};
+
+#endif // SYNC_ENGINE_H
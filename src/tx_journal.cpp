@@ -0,0 +1,352 @@
+#include "tx_journal.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Header: magic, format version, record size.
+constexpr uint8_t Magic[8] = {'L', 'E', 'Z', 'T', 'X', 'J', 'N', 'L'};
+constexpr uint32_t FormatVersion = 1;
+
+enum RecordKind : uint8_t { Empty = 0, Submission = 1, StatusChange = 2 };
+
+// Record layout; integers little-endian.
+constexpr size_t KindOffset = 0;
+constexpr size_t StatusOffset = 1;
+constexpr size_t AccountCountOffset = 2;
+constexpr size_t HasAmountOffset = 3;
+constexpr size_t ChecksumOffset = 4;
+constexpr size_t SubmitBlockOffset = 8;
+constexpr size_t TimeOffset = 16;
+constexpr size_t HashOffset = 24;
+constexpr size_t AmountOffset = 56;
+constexpr size_t MethodOffset = 72;
+constexpr size_t AccountsOffset = 128;
+static_assert(AccountsOffset + 32 * TxJournal::MaxAccounts <= TxJournal::RecordSize);
+static_assert(MethodOffset + TxJournal::MaxMethodLength + 1 <= AccountsOffset);
+
+void storeU32(uint8_t* out, const uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+void storeU64(uint8_t* out, const uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint32_t loadU32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+uint64_t loadU64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+// FNV-1a over everything but the checksum field itself.
+uint32_t recordChecksum(const uint8_t* record) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < TxJournal::RecordSize; ++i) {
+        if (i >= ChecksumOffset && i < ChecksumOffset + 4)
+            continue;
+        hash = (hash ^ record[i]) * 16777619u;
+    }
+    // Zero marks an empty slot, so it is never a valid checksum.
+    return hash == 0 ? 1 : hash;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+size_t TxJournal::KeyHash::operator()(const Key& key) const {
+    // Hashes and account ids are uniformly distributed already.
+    uint64_t h = 0;
+    memcpy(&h, key.data(), sizeof(h));
+    return static_cast<size_t>(h);
+}
+
+TxJournal::Key TxJournal::makeKey(const FfiBytes32& id) {
+    Key key{};
+    memcpy(key.data(), id.data, 32);
+    return key;
+}
+
+TxJournal::TxJournal(Track track) : track(std::move(track)) {}
+
+TxJournal::~TxJournal() {
+    close();
+}
+
+bool TxJournal::open(const std::string& path) {
+    std::vector<FfiBytes32> pending;
+    {
+        std::lock_guard lock(mutex);
+        closeLocked();
+
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            perror("TxJournal: open");
+            return false;
+        }
+        if (!replayLocked()) {
+            closeLocked();
+            return false;
+        }
+        for (const size_t index : byStatus[static_cast<size_t>(Status::Pending)])
+            pending.push_back(entries[index].txHash);
+    }
+
+    for (const FfiBytes32& hash : pending)
+        track(hash);
+    return true;
+}
+
+void TxJournal::close() {
+    std::lock_guard lock(mutex);
+    closeLocked();
+}
+
+bool TxJournal::isOpen() const {
+    std::lock_guard lock(mutex);
+    return mapping != nullptr;
+}
+
+bool TxJournal::recordSubmission(
+        const std::string& method,
+        const std::vector<FfiBytes32>& accounts,
+        const uint8_t* amount,
+        const FfiBytes32& txHash,
+        const uint64_t submitBlock
+) {
+    Entry entry;
+    entry.method = method.substr(0, MaxMethodLength);
+    entry.accounts.assign(accounts.begin(), accounts.begin() + std::min(accounts.size(), MaxAccounts));
+    entry.hasAmount = amount != nullptr;
+    if (amount)
+        memcpy(entry.amount.data(), amount, 16);
+    entry.txHash = txHash;
+    entry.submitBlock = submitBlock;
+    entry.submittedAtMs = nowMs();
+
+    uint8_t record[RecordSize] = {0};
+    record[KindOffset] = Submission;
+    record[StatusOffset] = static_cast<uint8_t>(Status::Pending);
+    record[AccountCountOffset] = static_cast<uint8_t>(entry.accounts.size());
+    record[HasAmountOffset] = entry.hasAmount ? 1 : 0;
+    storeU64(record + SubmitBlockOffset, entry.submitBlock);
+    storeU64(record + TimeOffset, static_cast<uint64_t>(entry.submittedAtMs));
+    memcpy(record + HashOffset, txHash.data, 32);
+    memcpy(record + AmountOffset, entry.amount.data(), 16);
+    memcpy(record + MethodOffset, entry.method.data(), entry.method.size());
+    for (size_t i = 0; i < entry.accounts.size(); ++i)
+        memcpy(record + AccountsOffset + 32 * i, entry.accounts[i].data, 32);
+
+    {
+        std::lock_guard lock(mutex);
+        if (!mapping || byHash.count(makeKey(txHash)) != 0)
+            return false;
+        if (!appendLocked(record))
+            return false;
+        indexSubmissionLocked(std::move(entry));
+    }
+    track(txHash);
+    return true;
+}
+
+bool TxJournal::recordStatus(const FfiBytes32& txHash, const Status status) {
+    std::lock_guard lock(mutex);
+    const auto it = byHash.find(makeKey(txHash));
+    if (!mapping || it == byHash.end())
+        return false;
+    Entry& entry = entries[it->second];
+    if (entry.status == status)
+        return false;
+
+    uint8_t record[RecordSize] = {0};
+    record[KindOffset] = StatusChange;
+    record[StatusOffset] = static_cast<uint8_t>(status);
+    storeU64(record + TimeOffset, static_cast<uint64_t>(nowMs()));
+    memcpy(record + HashOffset, txHash.data, 32);
+    if (!appendLocked(record))
+        return false;
+
+    byStatus[static_cast<size_t>(entry.status)].erase(it->second);
+    entry.status = status;
+    byStatus[static_cast<size_t>(status)].insert(it->second);
+    return true;
+}
+
+std::vector<TxJournal::Entry> TxJournal::query(const FfiBytes32* account, const std::optional<Status> status, const size_t limit) const {
+    std::lock_guard lock(mutex);
+    std::vector<Entry> result;
+    const auto matches = [&](const size_t index) {
+        return !status || entries[index].status == *status;
+    };
+
+    if (account) {
+        const auto it = byAccount.find(makeKey(*account));
+        if (it == byAccount.end())
+            return result;
+        for (auto index = it->second.rbegin(); index != it->second.rend() && result.size() < limit; ++index) {
+            if (matches(*index))
+                result.push_back(entries[*index]);
+        }
+    } else if (status) {
+        const std::set<size_t>& indices = byStatus[static_cast<size_t>(*status)];
+        for (auto index = indices.rbegin(); index != indices.rend() && result.size() < limit; ++index)
+            result.push_back(entries[*index]);
+    } else {
+        for (auto entry = entries.rbegin(); entry != entries.rend() && result.size() < limit; ++entry)
+            result.push_back(*entry);
+    }
+    return result;
+}
+
+size_t TxJournal::size() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+bool TxJournal::replayLocked() {
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        perror("TxJournal: fstat");
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(st.st_size);
+    if (fileSize == 0 || fileSize % RecordSize != 0) {
+        // New file, or one cut short mid-growth: round up to whole records.
+        fileSize = fileSize == 0 ? RecordSize * (1 + GrowRecords) : (fileSize / RecordSize + 1) * RecordSize;
+        if (ftruncate(fd, static_cast<off_t>(fileSize)) != 0) {
+            perror("TxJournal: ftruncate");
+            return false;
+        }
+    }
+
+    void* mapped = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        perror("TxJournal: mmap");
+        return false;
+    }
+    mapping = static_cast<uint8_t*>(mapped);
+    mappedSize = fileSize;
+
+    // A header that was never written (a crash right after creation) counts as new too.
+    if (std::all_of(mapping, mapping + 16, [](const uint8_t byte) { return byte == 0; })) {
+        memcpy(mapping, Magic, sizeof(Magic));
+        storeU32(mapping + 8, FormatVersion);
+        storeU32(mapping + 12, static_cast<uint32_t>(RecordSize));
+    } else if (memcmp(mapping, Magic, sizeof(Magic)) != 0 || loadU32(mapping + 8) != FormatVersion ||
+               loadU32(mapping + 12) != RecordSize) {
+        fprintf(stderr, "TxJournal: not a transaction journal (or an unsupported version)\n");
+        return false;
+    }
+
+    end = RecordSize;
+    for (; end + RecordSize <= mappedSize; end += RecordSize) {
+        const uint8_t* record = mapping + end;
+        if (record[KindOffset] == Empty || loadU32(record + ChecksumOffset) != recordChecksum(record))
+            break;
+
+        FfiBytes32 hash{};
+        memcpy(hash.data, record + HashOffset, 32);
+        if (record[KindOffset] == Submission) {
+            Entry entry;
+            const size_t methodLength = strnlen(reinterpret_cast<const char*>(record + MethodOffset), MaxMethodLength);
+            entry.method.assign(reinterpret_cast<const char*>(record + MethodOffset), methodLength);
+            entry.accounts.resize(std::min<size_t>(record[AccountCountOffset], MaxAccounts));
+            for (size_t i = 0; i < entry.accounts.size(); ++i)
+                memcpy(entry.accounts[i].data, record + AccountsOffset + 32 * i, 32);
+            entry.hasAmount = record[HasAmountOffset] != 0;
+            memcpy(entry.amount.data(), record + AmountOffset, 16);
+            entry.txHash = hash;
+            entry.submitBlock = loadU64(record + SubmitBlockOffset);
+            entry.submittedAtMs = static_cast<int64_t>(loadU64(record + TimeOffset));
+            if (byHash.count(makeKey(hash)) == 0)
+                indexSubmissionLocked(std::move(entry));
+        } else if (record[KindOffset] == StatusChange && record[StatusOffset] < StatusCount) {
+            const auto it = byHash.find(makeKey(hash));
+            if (it == byHash.end())
+                continue;
+            Entry& entry = entries[it->second];
+            byStatus[static_cast<size_t>(entry.status)].erase(it->second);
+            entry.status = static_cast<Status>(record[StatusOffset]);
+            byStatus[static_cast<size_t>(entry.status)].insert(it->second);
+        }
+    }
+    return true;
+}
+
+bool TxJournal::appendLocked(const uint8_t* record) {
+    if (end + RecordSize > mappedSize) {
+        const size_t grown = mappedSize + RecordSize * GrowRecords;
+        if (ftruncate(fd, static_cast<off_t>(grown)) != 0) {
+            perror("TxJournal: ftruncate");
+            return false;
+        }
+        void* mapped = mmap(nullptr, grown, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            perror("TxJournal: mmap");
+            return false;
+        }
+        munmap(mapping, mappedSize);
+        mapping = static_cast<uint8_t*>(mapped);
+        mappedSize = grown;
+    }
+
+    // The checksum goes in last: until it matches, replay treats the slot as the end.
+    uint8_t* slot = mapping + end;
+    memcpy(slot + ChecksumOffset + 4, record + ChecksumOffset + 4, RecordSize - ChecksumOffset - 4);
+    memcpy(slot, record, ChecksumOffset);
+    storeU32(slot + ChecksumOffset, recordChecksum(slot));
+    end += RecordSize;
+    return true;
+}
+
+void TxJournal::indexSubmissionLocked(Entry entry) {
+    const size_t index = entries.size();
+    entry.sequence = index + 1;
+    byHash.emplace(makeKey(entry.txHash), index);
+    for (const FfiBytes32& account : entry.accounts) {
+        std::vector<size_t>& list = byAccount[makeKey(account)];
+        // The same account twice in one transaction is still one entry.
+        if (list.empty() || list.back() != index)
+            list.push_back(index);
+    }
+    byStatus[static_cast<size_t>(entry.status)].insert(index);
+    entries.push_back(std::move(entry));
+}
+
+void TxJournal::closeLocked() {
+    if (mapping) {
+        msync(mapping, mappedSize, MS_SYNC);
+        munmap(mapping, mappedSize);
+    }
+    if (fd >= 0)
+        ::close(fd);
+    mapping = nullptr;
+    mappedSize = 0;
+    fd = -1;
+    end = 0;
+    entries.clear();
+    byHash.clear();
+    byAccount.clear();
+    for (std::set<size_t>& indices : byStatus)
+        indices.clear();
+}
@@ -0,0 +1,114 @@
+#ifndef TX_JOURNAL_H
+#define TX_JOURNAL_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Append-only journal of the transactions the module submitted, kept in a memory-mapped
+// file next to the wallet storage so that in-flight transactions survive a restart.
+//
+// The file is a 256-byte header followed by fixed 256-byte records: a submission (method,
+// up to MaxAccounts account ids, optional amount, tx hash, last synced block, time) or a
+// later status change for a hash. Each record carries a checksum, so a record torn by a
+// crash mid-append ends the replay instead of corrupting it; the next append overwrites it.
+// Writes land in the shared mapping and survive a crash of the process, not of the machine.
+//
+// Replaying folds the records into an in-memory index by hash, by account and by status,
+// which every query is served from. Transactions still pending after the replay, and each
+// new submission, are handed to the `track` callback so their status is followed again.
+class TxJournal {
+public:
+    enum class Status : uint8_t { Pending, Confirmed, TimedOut };
+    static constexpr size_t StatusCount = 3;
+
+    static constexpr size_t MaxAccounts = 4;
+    static constexpr size_t MaxMethodLength = 55;
+    static constexpr size_t RecordSize = 256;
+    // The file grows by this many records at a time.
+    static constexpr size_t GrowRecords = 4096;
+    // How long a journaled transaction is tracked after submission or replay.
+    static constexpr std::chrono::minutes TrackingTimeout{10};
+
+    struct Entry {
+        // 1-based position in submission order.
+        uint64_t sequence = 0;
+        std::string method;
+        std::vector<FfiBytes32> accounts;
+        bool hasAmount = false;
+        std::array<uint8_t, 16> amount{};
+        FfiBytes32 txHash{};
+        uint64_t submitBlock = 0;
+        // Milliseconds since the Unix epoch.
+        int64_t submittedAtMs = 0;
+        Status status = Status::Pending;
+    };
+
+    using Track = std::function<void(const FfiBytes32& txHash)>;
+
+    explicit TxJournal(Track track);
+    ~TxJournal();
+
+    TxJournal(const TxJournal&) = delete;
+    TxJournal& operator=(const TxJournal&) = delete;
+
+    // Opens (creating if needed) the journal at `path`, replays it and resumes tracking of
+    // pending transactions. A journal already open is closed first. False if the file cannot
+    // be opened or mapped, or is not a journal.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Journals a submission and starts tracking it. Accounts past MaxAccounts and method
+    // characters past MaxMethodLength are dropped. False if the journal is closed, the hash
+    // is already journaled or the file cannot grow.
+    bool recordSubmission(const std::string& method, const std::vector<FfiBytes32>& accounts, const uint8_t* amount, const FfiBytes32& txHash, uint64_t submitBlock);
+    // Journals a status change; false if the hash is unknown or already has that status.
+    bool recordStatus(const FfiBytes32& txHash, Status status);
+
+    // Newest first, at most `limit`. Null `account` / no `status`: any.
+    std::vector<Entry> query(const FfiBytes32* account, std::optional<Status> status, size_t limit) const;
+    size_t size() const;
+
+private:
+    using Key = std::array<uint8_t, 32>;
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key makeKey(const FfiBytes32& id);
+
+    bool replayLocked();
+    bool appendLocked(const uint8_t* record);
+    void indexSubmissionLocked(Entry entry);
+    void closeLocked();
+
+    const Track track;
+
+    mutable std::mutex mutex;
+    int fd = -1;
+    uint8_t* mapping = nullptr;
+    size_t mappedSize = 0;
+    // Offset where the next record goes.
+    size_t end = 0;
+
+    std::vector<Entry> entries;
+    std::unordered_map<Key, size_t, KeyHash> byHash;
+    std::unordered_map<Key, std::vector<size_t>, KeyHash> byAccount;
+    std::array<std::set<size_t>, StatusCount> byStatus;
+};
+
+#endif // TX_JOURNAL_H
@@ -0,0 +1,163 @@
+#include "tx_watcher.h"
+
+#include <algorithm>
+
+TxWatcher::TxWatcher(PollBatch poll) : TxWatcher(std::move(poll), Config{}) {}
+
+TxWatcher::TxWatcher(PollBatch poll, Config config) : TxWatcher(std::move(poll), nullptr, config) {}
+
+TxWatcher::TxWatcher(PollBatch poll, Resolved onResolved) : TxWatcher(std::move(poll), std::move(onResolved), Config{}) {}
+
+TxWatcher::TxWatcher(PollBatch poll, Resolved onResolved, Config config)
+    : poll(std::move(poll)), onResolved(std::move(onResolved)), config(config) {}
+
+TxWatcher::~TxWatcher() {
+    stop();
+}
+
+void TxWatcher::watch(const std::string& key, const FfiBytes32& hash, const std::chrono::milliseconds timeout) {
+    {
+        std::lock_guard lock(mutex);
+        if (stopping)
+            return;
+
+        const Clock::time_point now = Clock::now();
+        const auto it = watching.find(key);
+        if (it != watching.end()) {
+            it->second.deadline = std::max(it->second.deadline, now + timeout);
+        } else {
+            outcomes.erase(key);
+            Watch& watch = watching[key];
+            watch.hash = hash;
+            watch.deadline = now + timeout;
+            watch.nextPoll = now;
+            watch.interval = config.initialInterval;
+        }
+
+        // The polling thread only exists once something has been watched.
+        if (!thread.joinable())
+            thread = std::thread([this] { run(); });
+    }
+    wake.notify_all();
+}
+
+TxWatcher::State TxWatcher::wait(const std::string& key, const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex);
+    resolved.wait_for(lock, timeout, [this, &key] { return stopping || outcomes.count(key) > 0; });
+    const auto it = outcomes.find(key);
+    if (it != outcomes.end())
+        return it->second;
+
+    // The waiter can wake on its own timeout just before the poll thread expires the watch.
+    const auto watch = watching.find(key);
+    if (watch != watching.end() && watch->second.deadline <= Clock::now()) {
+        resolveLocked(key, State::TimedOut);
+        return State::TimedOut;
+    }
+    return State::Pending;
+}
+
+std::vector<TxWatcher::Event> TxWatcher::eventsSince(const int64_t sequence) const {
+    std::lock_guard lock(mutex);
+    std::vector<Event> result;
+    for (const Event& event : events) {
+        if (event.sequence > sequence)
+            result.push_back(event);
+    }
+    return result;
+}
+
+size_t TxWatcher::watchedCount() const {
+    std::lock_guard lock(mutex);
+    return watching.size();
+}
+
+void TxWatcher::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    resolved.notify_all();
+    if (thread.joinable())
+        thread.join();
+}
+
+void TxWatcher::resolveLocked(const std::string& key, const State state) {
+    watching.erase(key);
+
+    outcomes[key] = state;
+    outcomeOrder.push_back(key);
+    while (outcomeOrder.size() > config.maxResolved) {
+        // A key may have been re-watched and resolved again; only the latest entry counts.
+        const std::string oldest = std::move(outcomeOrder.front());
+        outcomeOrder.pop_front();
+        if (std::find(outcomeOrder.begin(), outcomeOrder.end(), oldest) == outcomeOrder.end())
+            outcomes.erase(oldest);
+    }
+
+    events.push_back(Event{nextSequence++, key, state});
+    if (onResolved)
+        onResolved(events.back());
+    while (events.size() > config.maxEvents)
+        events.pop_front();
+}
+
+void TxWatcher::run() {
+    std::unique_lock lock(mutex);
+    while (!stopping) {
+        if (watching.empty()) {
+            wake.wait(lock, [this] { return stopping || !watching.empty(); });
+            continue;
+        }
+
+        Clock::time_point next = Clock::time_point::max();
+        for (const auto& [key, watch] : watching)
+            next = std::min({next, watch.nextPoll, watch.deadline});
+        if (next > Clock::now()) {
+            // Woken early by a new watch (or stop): recompute the schedule.
+            wake.wait_until(lock, next);
+            continue;
+        }
+
+        // Expire first, then poll everything that is due in one batch.
+        Clock::time_point now = Clock::now();
+        std::vector<std::string> expired;
+        std::vector<std::string> dueKeys;
+        std::vector<FfiBytes32> dueHashes;
+        for (const auto& [key, watch] : watching) {
+            if (watch.deadline <= now) {
+                expired.push_back(key);
+            } else if (watch.nextPoll <= now) {
+                dueKeys.push_back(key);
+                dueHashes.push_back(watch.hash);
+            }
+        }
+        for (const std::string& key : expired)
+            resolveLocked(key, State::TimedOut);
+
+        if (!dueHashes.empty()) {
+            std::vector<std::optional<bool>> found(dueHashes.size());
+            lock.unlock();
+            poll(dueHashes, found);
+            lock.lock();
+
+            now = Clock::now();
+            for (size_t i = 0; i < dueKeys.size(); ++i) {
+                const auto it = watching.find(dueKeys[i]);
+                if (it == watching.end())
+                    continue;
+                if (found[i].value_or(false)) {
+                    resolveLocked(dueKeys[i], State::Confirmed);
+                    continue;
+                }
+                Watch& watch = it->second;
+                watch.nextPoll = now + watch.interval;
+                watch.interval = std::min(watch.interval * 2, config.maxInterval);
+            }
+        }
+
+        if (!expired.empty() || !dueHashes.empty())
+            resolved.notify_all();
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef TX_WATCHER_H
+#define TX_WATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Background transaction-status watcher. Callers watch() tx hashes; a single thread polls
+// every due hash in one batch, backing off exponentially per hash, until the hash is found
+// on chain (Confirmed) or its deadline passes (TimedOut). Each outcome is appended to a
+// bounded event log that callers read with a sequence cursor, and wakes any wait()ers.
+class TxWatcher {
+public:
+    enum class State { Pending, Confirmed, TimedOut };
+
+    struct Event {
+        int64_t sequence = 0;
+        std::string txHash;
+        State state = State::Pending;
+    };
+
+    // Polls hashes[i] into found[i]: true/false, or nullopt when the FFI call failed (the
+    // hash then simply stays pending and is retried on its next backoff step).
+    using PollBatch = std::function<void(const std::vector<FfiBytes32>& hashes, std::vector<std::optional<bool>>& found)>;
+
+    // Called for every resolution, with the watcher's lock held: it must not call back into
+    // the watcher.
+    using Resolved = std::function<void(const Event& event)>;
+
+    struct Config {
+        std::chrono::milliseconds initialInterval{250};
+        std::chrono::milliseconds maxInterval{8000};
+        size_t maxEvents = 1024;
+        size_t maxResolved = 4096;
+    };
+
+    explicit TxWatcher(PollBatch poll);
+    TxWatcher(PollBatch poll, Config config);
+    TxWatcher(PollBatch poll, Resolved onResolved);
+    TxWatcher(PollBatch poll, Resolved onResolved, Config config);
+    ~TxWatcher();
+
+    TxWatcher(const TxWatcher&) = delete;
+    TxWatcher& operator=(const TxWatcher&) = delete;
+
+    // `key` is the canonical hash spelling reported back in events. Watching an already
+    // watched hash only pushes its deadline out; a resolved hash is watched afresh.
+    void watch(const std::string& key, const FfiBytes32& hash, std::chrono::milliseconds timeout);
+
+    // Waits until `key` resolves or `timeout` elapses and returns its state at that point.
+    // A key that was never watched just reports Pending once the timeout elapses.
+    State wait(const std::string& key, std::chrono::milliseconds timeout);
+
+    std::vector<Event> eventsSince(int64_t sequence) const;
+    size_t watchedCount() const;
+
+    void stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Watch {
+        FfiBytes32 hash{};
+        Clock::time_point deadline;
+        Clock::time_point nextPoll;
+        std::chrono::milliseconds interval{0};
+    };
+
+    void run();
+    void resolveLocked(const std::string& key, State state);
+
+    const PollBatch poll;
+    const Resolved onResolved;
+    const Config config;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable resolved;
+    std::unordered_map<std::string, Watch> watching;
+    std::unordered_map<std::string, State> outcomes;
+    std::deque<std::string> outcomeOrder;
+    std::deque<Event> events;
+    int64_t nextSequence = 1;
+    bool stopping = false;
+    std::thread thread;
+};
+
+#endif // TX_WATCHER_H
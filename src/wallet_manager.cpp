@@ -0,0 +1,246 @@
+#include "wallet_manager.h"
+
+#include <cstdio>
+
+namespace {
+
+size_t maxOpenOrDefault(const size_t maxOpen) {
+    return maxOpen > 0 ? maxOpen : WalletManager::DefaultMaxOpen;
+}
+
+} // namespace
+
+WalletManager::Lease::Lease(WalletManager* manager, std::shared_ptr<Wallet> wallet)
+    : manager(manager), wallet(std::move(wallet)) {}
+
+WalletManager::Lease::Lease(Lease&& other) noexcept : manager(other.manager), wallet(std::move(other.wallet)) {
+    other.manager = nullptr;
+}
+
+WalletManager::Lease& WalletManager::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        manager = other.manager;
+        wallet = std::move(other.wallet);
+        other.manager = nullptr;
+    }
+    return *this;
+}
+
+WalletManager::Lease::~Lease() {
+    release();
+}
+
+WalletHandle* WalletManager::Lease::handle() const {
+    return wallet->handle;
+}
+
+RwLock& WalletManager::Lease::lock() const {
+    return wallet->lock;
+}
+
+void WalletManager::Lease::release() {
+    if (wallet)
+        manager->releaseLease(*wallet);
+    wallet.reset();
+    manager = nullptr;
+}
+
+WalletManager::WalletManager(const size_t maxOpen) : maxOpen(maxOpenOrDefault(maxOpen)) {}
+
+WalletManager::~WalletManager() {
+    // No lease outlives the module, so nothing else can touch the wallets any more.
+    for (const auto& [id, wallet] : wallets) {
+        if (wallet->state != State::Open)
+            continue;
+        if (const int error = wallet_ffi_save(wallet->handle); error != SUCCESS)
+            fprintf(stderr, "WalletManager: saving wallet %s failed: wallet FFI error %d\n", id.c_str(), error);
+        wallet_ffi_destroy(wallet->handle);
+    }
+}
+
+WalletFfiError WalletManager::add(
+        const std::string& walletId,
+        const std::string& configPath,
+        const std::string& storagePath,
+        const std::string& statisticsPath
+) {
+    std::shared_ptr<Wallet> wallet;
+    {
+        std::lock_guard lock(mutex);
+        if (wallets.size() >= MaxWallets || wallets.count(walletId) != 0)
+            return INTERNAL_ERROR;
+        wallet = std::make_shared<Wallet>();
+        wallet->id = walletId;
+        wallet->configPath = configPath;
+        wallet->storagePath = storagePath;
+        wallet->statisticsPath = statisticsPath;
+        wallets.emplace(walletId, wallet);
+    }
+
+    if (acquire(walletId))
+        return SUCCESS;
+
+    std::lock_guard lock(mutex);
+    const auto it = wallets.find(walletId);
+    if (it != wallets.end() && it->second == wallet && wallet->state == State::Closed && wallet->leases == 0)
+        wallets.erase(it);
+    return INTERNAL_ERROR;
+}
+
+WalletFfiError WalletManager::remove(const std::string& walletId) {
+    std::unique_lock lock(mutex);
+    const auto it = wallets.find(walletId);
+    if (it == wallets.end() || it->second->removing)
+        return INTERNAL_ERROR;
+    const std::shared_ptr<Wallet> wallet = it->second;
+    wallet->removing = true;
+    changed.notify_all();
+    changed.wait(lock, [&] {
+        return wallet->leases == 0 && (wallet->state == State::Open || wallet->state == State::Closed);
+    });
+
+    WalletHandle* handle = nullptr;
+    if (wallet->state == State::Open) {
+        // Closing keeps everyone else off the handle while it is saved without the mutex.
+        wallet->state = State::Closing;
+        lru.erase(wallet->lruPosition);
+        --openCount;
+        lock.unlock();
+        const int error = wallet_ffi_save(wallet->handle);
+        lock.lock();
+        if (error != SUCCESS) {
+            wallet->state = State::Open;
+            wallet->removing = false;
+            lru.push_front(wallet);
+            wallet->lruPosition = lru.begin();
+            ++openCount;
+            ++saveFailures;
+            changed.notify_all();
+            fprintf(stderr, "WalletManager: saving wallet %s failed: wallet FFI error %d\n", walletId.c_str(), error);
+            return static_cast<WalletFfiError>(error);
+        }
+        handle = wallet->handle;
+        wallet->handle = nullptr;
+        wallet->state = State::Closed;
+    }
+    wallets.erase(walletId);
+    changed.notify_all();
+    lock.unlock();
+    if (handle)
+        wallet_ffi_destroy(handle);
+    return SUCCESS;
+}
+
+WalletManager::Lease WalletManager::acquire(const std::string& walletId) {
+    std::unique_lock lock(mutex);
+    const auto it = wallets.find(walletId);
+    if (it == wallets.end())
+        return Lease();
+    const std::shared_ptr<Wallet> wallet = it->second;
+    changed.wait(lock, [&] {
+        return wallet->removing || wallet->state == State::Open || wallet->state == State::Closed;
+    });
+    if (wallet->removing)
+        return Lease();
+
+    if (wallet->state == State::Closed) {
+        wallet->state = State::Opening;
+        lock.unlock();
+        WalletHandle* handle = wallet_ffi_open(wallet->configPath.c_str(), wallet->storagePath.c_str(), wallet->statisticsPath.c_str());
+        lock.lock();
+        if (!handle) {
+            wallet->state = State::Closed;
+            changed.notify_all();
+            fprintf(stderr, "WalletManager: wallet_ffi_open returned null for wallet %s\n", walletId.c_str());
+            return Lease();
+        }
+        wallet->handle = handle;
+        wallet->state = State::Open;
+        lru.push_front(wallet);
+        wallet->lruPosition = lru.begin();
+        ++openCount;
+        ++opens;
+        changed.notify_all();
+    } else {
+        lru.splice(lru.begin(), lru, wallet->lruPosition);
+    }
+    if (wallet->leases++ == 0)
+        ++leasedCount;
+
+    const std::vector<std::shared_ptr<Wallet>> victims = takeEvictionVictimsLocked();
+    lock.unlock();
+    closeEvicted(victims);
+    return Lease(this, wallet);
+}
+
+void WalletManager::setMaxOpen(const size_t maxOpen) {
+    std::vector<std::shared_ptr<Wallet>> victims;
+    {
+        std::lock_guard lock(mutex);
+        this->maxOpen = maxOpenOrDefault(maxOpen);
+        victims = takeEvictionVictimsLocked();
+    }
+    closeEvicted(victims);
+}
+
+nlohmann::json WalletManager::snapshot() const {
+    std::lock_guard lock(mutex);
+    nlohmann::json result;
+    result["registered"] = wallets.size();
+    result["open"] = openCount;
+    result["leased"] = leasedCount;
+    result["max_open"] = maxOpen;
+    result["opens"] = opens;
+    result["evictions"] = evictions;
+    result["save_failures"] = saveFailures;
+    return result;
+}
+
+void WalletManager::releaseLease(Wallet& wallet) {
+    std::lock_guard lock(mutex);
+    if (--wallet.leases == 0) {
+        --leasedCount;
+        changed.notify_all();
+    }
+}
+
+std::vector<std::shared_ptr<WalletManager::Wallet>> WalletManager::takeEvictionVictimsLocked() {
+    std::vector<std::shared_ptr<Wallet>> victims;
+    auto it = lru.end();
+    while (openCount > maxOpen && it != lru.begin()) {
+        --it;
+        if ((*it)->leases > 0)
+            continue;
+        (*it)->state = State::Closing;
+        victims.push_back(*it);
+        it = lru.erase(it);
+        --openCount;
+    }
+    return victims;
+}
+
+void WalletManager::closeEvicted(const std::vector<std::shared_ptr<Wallet>>& victims) {
+    for (const std::shared_ptr<Wallet>& wallet : victims) {
+        const int error = wallet_ffi_save(wallet->handle);
+        if (error == SUCCESS)
+            wallet_ffi_destroy(wallet->handle);
+        else
+            fprintf(stderr, "WalletManager: saving wallet %s failed, keeping it open: wallet FFI error %d\n", wallet->id.c_str(), error);
+
+        std::lock_guard lock(mutex);
+        if (error == SUCCESS) {
+            wallet->handle = nullptr;
+            wallet->state = State::Closed;
+            ++evictions;
+        } else {
+            // Back in as most recently used, so the next eviction tries other wallets first.
+            wallet->state = State::Open;
+            lru.push_front(wallet);
+            wallet->lruPosition = lru.begin();
+            ++openCount;
+            ++saveFailures;
+        }
+        changed.notify_all();
+    }
+}
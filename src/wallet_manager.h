@@ -0,0 +1,127 @@
+#ifndef WALLET_MANAGER_H
+#define WALLET_MANAGER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "rw_lock.h"
+
+extern "C" {
+#include <wallet_ffi.h>
+}
+
+// Many wallets hosted by one module, keyed by a caller-chosen id. Each registered wallet
+// remembers its paths; at most maxOpen of them hold an open WalletHandle at a time. When
+// another one has to be opened, the least recently used wallet that no call is using is
+// saved with wallet_ffi_save and destroyed, and is reopened transparently on its next use.
+// A wallet whose save fails stays open, so nothing unsaved is dropped.
+//
+// Every wallet has its own lock, so calls on different wallets run in parallel; the
+// manager's own mutex only covers bookkeeping, never a wallet_ffi call.
+class WalletManager {
+public:
+    static constexpr size_t DefaultMaxOpen = 256;
+    static constexpr size_t MaxWallets = size_t{1} << 16;
+
+private:
+    struct Wallet;
+
+public:
+    // Pins one open wallet for the duration of a call: a leased wallet is never evicted.
+    // Callers take lock() around their wallet_ffi calls, shared or exclusive as for the
+    // module's own wallet. An empty Lease means the wallet is unknown or failed to open.
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        explicit operator bool() const { return wallet != nullptr; }
+
+        WalletHandle* handle() const;
+        RwLock& lock() const;
+
+    private:
+        friend class WalletManager;
+        Lease(WalletManager* manager, std::shared_ptr<Wallet> wallet);
+
+        void release();
+
+        WalletManager* manager = nullptr;
+        std::shared_ptr<Wallet> wallet;
+    };
+
+    explicit WalletManager(size_t maxOpen = DefaultMaxOpen);
+    // Saves and closes every open wallet.
+    ~WalletManager();
+
+    WalletManager(const WalletManager&) = delete;
+    WalletManager& operator=(const WalletManager&) = delete;
+
+    // Registers walletId and opens it. INTERNAL_ERROR if the id is taken, the manager is
+    // full or wallet_ffi_open fails (the id is then not kept).
+    WalletFfiError add(const std::string& walletId, const std::string& configPath, const std::string& storagePath, const std::string& statisticsPath);
+    // Waits for calls still using walletId, saves and closes it, and forgets it. Returns the
+    // wallet_ffi_save result (SUCCESS if it was not open), INTERNAL_ERROR if unknown or
+    // already being removed. If the save fails the wallet stays registered and open.
+    WalletFfiError remove(const std::string& walletId);
+
+    // Blocks while walletId is being opened or evicted; reopens it if it was evicted.
+    Lease acquire(const std::string& walletId);
+
+    // 0: DefaultMaxOpen. Lowering it evicts idle wallets right away.
+    void setMaxOpen(size_t maxOpen);
+
+    // { registered, open, leased, max_open, opens, evictions, save_failures }
+    nlohmann::json snapshot() const;
+
+private:
+    enum class State { Closed, Opening, Open, Closing };
+
+    struct Wallet {
+        std::string id;
+        std::string configPath;
+        std::string storagePath;
+        std::string statisticsPath;
+        // Guards the wallet_ffi calls made through handle.
+        RwLock lock;
+
+        // The rest is guarded by the manager's mutex; handle only changes while Opening or
+        // Closing, when no lease can exist.
+        WalletHandle* handle = nullptr;
+        State state = State::Closed;
+        size_t leases = 0;
+        bool removing = false;
+        std::list<std::shared_ptr<Wallet>>::iterator lruPosition;
+    };
+
+    void releaseLease(Wallet& wallet);
+    // Picks idle open wallets past maxOpen, least recently used first, and marks them
+    // Closing; the caller closes them with closeEvicted() after dropping the mutex.
+    std::vector<std::shared_ptr<Wallet>> takeEvictionVictimsLocked();
+    void closeEvicted(const std::vector<std::shared_ptr<Wallet>>& victims);
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::unordered_map<std::string, std::shared_ptr<Wallet>> wallets;
+    // Open wallets, most recently used first.
+    std::list<std::shared_ptr<Wallet>> lru;
+    size_t maxOpen;
+    size_t openCount = 0;
+    size_t leasedCount = 0;
+    uint64_t opens = 0;
+    uint64_t evictions = 0;
+    uint64_t saveFailures = 0;
+};
+
+#endif // WALLET_MANAGER_H
@@ -0,0 +1,59 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(const size_t threadCount) : threadCount(std::max<size_t>(1, threadCount)) {}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::post(std::function<void()> task) {
+    {
+        std::lock_guard lock(mutex);
+        if (stopping)
+            return false;
+        tasks.push_back(std::move(task));
+        if (threads.size() < threadCount && idleThreads < tasks.size())
+            threads.emplace_back([this] { run(); });
+    }
+    wake.notify_one();
+    return true;
+}
+
+void WorkerPool::shutdown() {
+    std::vector<std::thread> joining;
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        joining.swap(threads);
+    }
+    wake.notify_all();
+    for (std::thread& thread : joining) {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+size_t WorkerPool::queuedTasks() const {
+    std::lock_guard lock(mutex);
+    return tasks.size();
+}
+
+void WorkerPool::run() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            ++idleThreads;
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            --idleThreads;
+            // Drain before exiting: a queued task is work a caller already holds a ticket for.
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size FIFO thread pool owned by the module. Threads are started on the first
+// post() so that a module which never submits background work never spawns any.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Queues `task`; returns false once shutdown() has begun.
+    bool post(std::function<void()> task);
+
+    // Runs every task already queued, then joins the threads. Idempotent.
+    void shutdown();
+
+    size_t queuedTasks() const;
+
+private:
+    void run();
+
+    const size_t threadCount;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    size_t idleThreads = 0;
+    bool stopping = false;
+};
+
+#endif // WORKER_POOL_H
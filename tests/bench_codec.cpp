@@ -0,0 +1,373 @@
+// Microbenchmark for the codec and JSON layers (src/lez_codec.h, src/hex_codec.h).
+//
+//   lez_codec_bench [--filter <substr>] [--min-time-ms <n>] [--out <file>]
+//                   [--baseline <file>] [--tolerance <fraction>]
+//
+// Prints one JSON document with time, throughput and heap allocations per operation for
+// every case. Pass an earlier run as --baseline to compare against it: the exit code is 1
+// if any case got slower than the tolerance (default 0.10) or allocates more per call.
+
+#include "hex_codec.h"
+#include "lez_codec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+// ---------------------------------------------------------------------------
+// Allocation counting: every global new in the process goes through here. The deletes are
+// kept out of line so GCC does not pair an inlined free() with a new it cannot see through.
+// ---------------------------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> allocCount{0};
+std::atomic<uint64_t> allocBytes{0};
+} // namespace
+
+void* operator new(const size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+template <typename T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Options {
+    std::string filter;
+    std::string outPath;
+    std::string baselinePath;
+    double tolerance = 0.10;
+    std::chrono::milliseconds minTime{200};
+};
+
+struct Case {
+    std::string name;
+    std::string param;
+    size_t bytesPerOp; // input size used for throughput; 0 = not meaningful
+    std::function<void()> run;
+};
+
+nlohmann::json measure(const Case& c, const Options& options) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < 100; ++i)
+        c.run();
+
+    // Grow the batch until one batch takes ~1/10 of the budget, then repeat it until the
+    // budget is spent so the clock reads stay out of the per-op figure.
+    uint64_t batch = 1;
+    for (;;) {
+        const auto start = Clock::now();
+        for (uint64_t i = 0; i < batch; ++i)
+            c.run();
+        if (Clock::now() - start >= options.minTime / 10 || batch >= (uint64_t{1} << 30))
+            break;
+        batch *= 2;
+    }
+
+    uint64_t iterations = 0;
+    const uint64_t allocsBefore = allocCount.load(std::memory_order_relaxed);
+    const uint64_t bytesBefore = allocBytes.load(std::memory_order_relaxed);
+    const auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    while (elapsed < options.minTime) {
+        for (uint64_t i = 0; i < batch; ++i)
+            c.run();
+        iterations += batch;
+        elapsed = Clock::now() - start;
+    }
+    const uint64_t allocs = allocCount.load(std::memory_order_relaxed) - allocsBefore;
+    const uint64_t bytes = allocBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    const double nsPerOp = ns / static_cast<double>(iterations);
+
+    nlohmann::json result = nlohmann::json::object();
+    result["name"] = c.name;
+    result["param"] = c.param;
+    result["iterations"] = iterations;
+    result["ns_per_op"] = nsPerOp;
+    result["bytes_per_sec"] = c.bytesPerOp ? static_cast<double>(c.bytesPerOp) * 1e9 / nsPerOp : 0.0;
+    result["allocs_per_op"] = static_cast<double>(allocs) / static_cast<double>(iterations);
+    result["alloc_bytes_per_op"] = static_cast<double>(bytes) / static_cast<double>(iterations);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+std::vector<uint8_t> patternBytes(const size_t length) {
+    std::vector<uint8_t> bytes(length);
+    for (size_t i = 0; i < length; ++i)
+        bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+    return bytes;
+}
+
+std::string patternHex(const size_t length) {
+    const std::vector<uint8_t> bytes = patternBytes(length);
+    return LEZCodec::bytesToHex(bytes.data(), bytes.size());
+}
+
+std::vector<Case> buildCases() {
+    std::vector<Case> cases;
+
+    // Hex: 16/32 are the u128 and account-id hot path, the rest are account data blobs.
+    for (const size_t size : {16, 32, 256, 4096, 65536}) {
+        auto bytes = std::make_shared<std::vector<uint8_t>>(patternBytes(size));
+        cases.push_back({"bytesToHex", std::to_string(size), size, [bytes] {
+                             doNotOptimize(LEZCodec::bytesToHex(bytes->data(), bytes->size()));
+                         }});
+    }
+    for (const size_t size : {16, 32, 256, 4096, 65536}) {
+        auto hex = std::make_shared<std::string>("0x" + patternHex(size));
+        auto out = std::make_shared<std::vector<uint8_t>>();
+        cases.push_back({"hexToBytes", std::to_string(size), size, [hex, out] {
+                             doNotOptimize(LEZCodec::hexToBytes(*hex, *out));
+                             doNotOptimize(out->data());
+                         }});
+    }
+
+    {
+        uint8_t small[16] = {0x40, 0x42, 0x0f}; // 1000000
+        uint8_t max[16];
+        memset(max, 0xff, sizeof(max));
+        cases.push_back({"balanceLe16ToDecimalString", "small", 16, [small] {
+                             doNotOptimize(LEZCodec::balanceLe16ToDecimalString(small));
+                         }});
+        cases.push_back({"balanceLe16ToDecimalString", "u128_max", 16, [max] {
+                             doNotOptimize(LEZCodec::balanceLe16ToDecimalString(max));
+                         }});
+        for (const char* decimal : {"1000000", "340282366920938463463374607431768211455"}) {
+            const std::string input = decimal;
+            cases.push_back({"decimalToU128", input.size() < 20 ? "small" : "u128_max", input.size(), [input] {
+                                 uint8_t out[16];
+                                 doNotOptimize(LEZCodec::decimalToU128(input, &out));
+                                 doNotOptimize(out);
+                             }});
+        }
+    }
+
+    for (const size_t dataLen : {0, 256, 4096}) {
+        auto data = std::make_shared<std::vector<uint8_t>>(patternBytes(dataLen));
+        FfiAccount account{};
+        memset(account.program_owner.data, 0x11, sizeof(account.program_owner.data));
+        memset(account.balance.data, 0x22, sizeof(account.balance.data));
+        memset(account.nonce.data, 0x33, sizeof(account.nonce.data));
+        account.data = dataLen ? data->data() : nullptr;
+        account.data_len = dataLen;
+        cases.push_back({"ffiAccountToJson", "data_" + std::to_string(dataLen), 64 + dataLen, [account, data] {
+                             doNotOptimize(LEZCodec::ffiAccountToJson(account));
+                         }});
+        cases.push_back({"ffiAccountToRecord", "data_" + std::to_string(dataLen), 64 + dataLen, [account, data] {
+                             doNotOptimize(LEZCodec::ffiAccountToRecord(account));
+                         }});
+    }
+
+    {
+        auto txHash = std::make_shared<std::string>(patternHex(32));
+        cases.push_back({"transferResultToJson", "success", 0, [txHash] {
+                             FfiTransferResult result{};
+                             result.tx_hash = txHash->data();
+                             result.success = true;
+                             doNotOptimize(LEZCodec::transferResultToJson(&result, ""));
+                         }});
+        cases.push_back({"transferResultToRecord", "success", 0, [txHash] {
+                             FfiTransferResult result{};
+                             result.tx_hash = txHash->data();
+                             result.success = true;
+                             doNotOptimize(LEZCodec::transferResultToRecord(&result, 0));
+                         }});
+        cases.push_back({"transferResultToJson", "error", 0, [] {
+                             doNotOptimize(LEZCodec::transferResultToJson(nullptr, "wallet FFI error 7"));
+                         }});
+
+        auto secrets = std::make_shared<std::vector<FfiBytes32>>(4);
+        for (FfiBytes32& secret : *secrets)
+            memset(secret.data, 0x44, sizeof(secret.data));
+        cases.push_back({"genericTransactionResultToJson", "secrets_4", 0, [txHash, secrets] {
+                             FfiTransactionResult result{};
+                             result.tx_hash = txHash->data();
+                             result.success = true;
+                             result.secrets_data = secrets->data();
+                             result.secrets_size = secrets->size();
+                             doNotOptimize(LEZCodec::genericTransactionResultToJson(&result, ""));
+                         }});
+    }
+
+    // Viewing keys: 33-byte compressed point, and a 1184-byte lattice public key.
+    for (const size_t vpkLen : {33, 1184}) {
+        nlohmann::json doc = nlohmann::json::object();
+        doc[LEZCodec::JsonKeys::NullifierPublicKey] = patternHex(32);
+        doc[LEZCodec::JsonKeys::ViewingPublicKey] = patternHex(vpkLen);
+        auto json = std::make_shared<std::string>(doc.dump());
+        cases.push_back({"jsonToFfiPrivateAccountKeys", "vpk_" + std::to_string(vpkLen), json->size(), [json] {
+                             FfiPrivateAccountKeys keys{};
+                             doNotOptimize(LEZCodec::jsonToFfiPrivateAccountKeys(*json, &keys));
+                             free(const_cast<uint8_t*>(keys.viewing_public_key));
+                         }});
+    }
+
+    // Merkle proof depths.
+    for (const size_t depth : {16, 32, 64}) {
+        nlohmann::json doc = nlohmann::json::array();
+        for (size_t i = 0; i < depth; ++i)
+            doc.push_back(patternHex(32));
+        auto json = std::make_shared<std::string>(doc.dump());
+        auto out = std::make_shared<std::vector<uint8_t>>();
+        cases.push_back({"jsonArrayHexToSiblings32", "depth_" + std::to_string(depth), json->size(), [json, out] {
+                             uintptr_t len = 0;
+                             doNotOptimize(LEZCodec::jsonArrayHexToSiblings32(*json, *out, len));
+                             doNotOptimize(len);
+                         }});
+    }
+
+    return cases;
+}
+
+// ---------------------------------------------------------------------------
+// Baseline comparison
+// ---------------------------------------------------------------------------
+
+// Returns false if any case regressed.
+bool compareToBaseline(const nlohmann::json& results, const nlohmann::json& baseline, const double tolerance) {
+    bool ok = true;
+    fprintf(stderr, "%-30s %-12s %12s %12s %8s %s\n", "case", "param", "base ns/op", "ns/op", "ratio", "allocs");
+    for (const auto& current : results) {
+        const auto match = std::find_if(baseline.begin(), baseline.end(), [&current](const nlohmann::json& b) {
+            return b.value("name", "") == current["name"] && b.value("param", "") == current["param"];
+        });
+        if (match == baseline.end()) {
+            fprintf(stderr, "%-30s %-12s %12s\n", current["name"].get<std::string>().c_str(),
+                    current["param"].get<std::string>().c_str(), "(new)");
+            continue;
+        }
+
+        const double baseNs = match->value("ns_per_op", 0.0);
+        const double ns = current["ns_per_op"].get<double>();
+        const double ratio = baseNs > 0 ? ns / baseNs : 1.0;
+        const double baseAllocs = match->value("allocs_per_op", 0.0);
+        const double allocs = current["allocs_per_op"].get<double>();
+
+        const bool slower = ratio > 1.0 + tolerance;
+        // Allow for rounding in the per-op average; a real regression is at least one per call.
+        const bool moreAllocs = allocs > baseAllocs + 0.5;
+        ok = ok && !slower && !moreAllocs;
+
+        fprintf(stderr, "%-30s %-12s %12.1f %12.1f %7.2fx %.1f -> %.1f%s\n", current["name"].get<std::string>().c_str(),
+                current["param"].get<std::string>().c_str(), baseNs, ns, ratio, baseAllocs, allocs,
+                slower || moreAllocs ? "  REGRESSED" : "");
+    }
+    return ok;
+}
+
+bool parseArgs(const int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--out") {
+            options.outPath = value;
+        } else if (arg == "--baseline") {
+            options.baselinePath = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::atof(value.c_str());
+        } else if (arg == "--min-time-ms") {
+            options.minTime = std::chrono::milliseconds(std::atoll(value.c_str()));
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 2;
+
+    nlohmann::json baseline;
+    if (!options.baselinePath.empty()) {
+        std::ifstream in(options.baselinePath);
+        baseline = nlohmann::json::parse(in, nullptr, false);
+        if (baseline.is_discarded() || !baseline.contains("results") || !baseline["results"].is_array()) {
+            fprintf(stderr, "cannot read baseline %s\n", options.baselinePath.c_str());
+            return 2;
+        }
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+    for (const Case& c : buildCases()) {
+        if (!options.filter.empty() && (c.name + "/" + c.param).find(options.filter) == std::string::npos)
+            continue;
+        results.push_back(measure(c, options));
+    }
+
+    nlohmann::json report = nlohmann::json::object();
+    report["schema"] = 1;
+    report["hex_kernel"] = HexCodec::kernelName(HexCodec::activeKernel());
+    report["min_time_ms"] = options.minTime.count();
+    report["results"] = results;
+
+    if (options.outPath.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream out(options.outPath);
+        out << report.dump(2) << std::endl;
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", options.outPath.c_str());
+            return 2;
+        }
+    }
+
+    if (!options.baselinePath.empty() && !compareToBaseline(results, baseline["results"], options.tolerance))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,294 @@
+// End-to-end throughput benchmark: drives LEZCoreModule from several threads against the
+// mock wallet_ffi with realistic per-function latency (mocks/mock_wallet_ffi_behavior.h).
+//
+//   lez_module_bench [--threads <n>] [--duration-ms <n>] [--accounts <n>]
+//                    [--mix read=70,public=15,private=5,poll=10]
+//                    [--latency-scale <x>] [--serial-reads] [--out <file>]
+//
+// Prints one JSON document with overall throughput and per-operation count, errors and
+// p50/p90/p99/max latency. The exit code is 1 if the mock saw wallet calls overlap that
+// the module should have serialised (or if nothing completed), so the smoke run in ctest
+// doubles as a thread-safety check. --serial-reads also counts overlapping reads, i.e.
+// checks the stricter "one wallet call at a time" contract.
+//
+// Mock latencies are the library's orders of magnitude (RPC reads in the sub-ms to ms
+// range, public submits in ms, proving in tens of ms — seconds in reality, scaled down so
+// a run finishes quickly). --latency-scale multiplies all of them.
+
+#include "lez_core_module.h"
+#include "mocks/mock_wallet_ffi_behavior.h"
+
+#include <logos_test.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::microseconds;
+
+enum Operation { Read, PublicTransfer, PrivateTransfer, Poll, OperationCount };
+
+const char* const OPERATION_NAMES[OperationCount] = {"read", "public", "private", "poll"};
+
+struct Options {
+    int threads = 8;
+    std::chrono::milliseconds duration{2000};
+    int accounts = 64;
+    int weights[OperationCount] = {70, 15, 5, 10};
+    double latencyScale = 1.0;
+    bool serialReads = false;
+    std::string outPath;
+};
+
+struct ThreadStats {
+    std::vector<int64_t> latencyUs[OperationCount];
+    uint64_t errors[OperationCount] = {};
+};
+
+microseconds scaled(const int64_t us, const double scale) {
+    return microseconds(static_cast<int64_t>(static_cast<double>(us) * scale));
+}
+
+void configureMock(const Options& options) {
+    using MockWalletFfiBehavior::FunctionBehavior;
+    using MockWalletFfiBehavior::Latency;
+    const double s = options.latencyScale;
+
+    MockWalletFfiBehavior::reset();
+    MockWalletFfiBehavior::setAllowConcurrentReads(!options.serialReads);
+
+    FunctionBehavior read;
+    read.latency = Latency::logNormal(scaled(300, s), scaled(3000, s));
+    MockWalletFfiBehavior::configure("wallet_ffi_get_balance", read);
+    MockWalletFfiBehavior::configure("wallet_ffi_get_account_public", read);
+    MockWalletFfiBehavior::configure("wallet_ffi_get_account_private", read);
+
+    FunctionBehavior poll;
+    poll.latency = Latency::logNormal(scaled(500, s), scaled(4000, s));
+    MockWalletFfiBehavior::configure("wallet_ffi_poll_transaction_status", poll);
+
+    FunctionBehavior publicSubmit;
+    publicSubmit.latency = Latency::logNormal(scaled(5000, s), scaled(25000, s));
+    publicSubmit.failureRate = 0.01;
+    MockWalletFfiBehavior::configure("wallet_ffi_transfer_public", publicSubmit);
+
+    FunctionBehavior privateSubmit;
+    privateSubmit.latency = Latency::logNormal(scaled(40000, s), scaled(120000, s));
+    privateSubmit.failureRate = 0.01;
+    MockWalletFfiBehavior::configure("wallet_ffi_transfer_private", privateSubmit);
+}
+
+// 32-byte id: a fixed prefix with the index in the low 8 bytes, so every index is distinct.
+std::string accountIdHex(const int index) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(index));
+    return std::string(48, 'c') + buf;
+}
+
+bool succeeded(const std::string& json) {
+    const nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
+    return doc.is_object() && doc.value("success", false);
+}
+
+void runWorker(LEZCoreModule& module, const Options& options, const std::vector<std::string>& ids,
+               const Clock::time_point deadline, ThreadStats& stats) {
+    std::mt19937_64 rng(std::random_device{}());
+    std::discrete_distribution<int> pickOperation(std::begin(options.weights), std::end(options.weights));
+    std::uniform_int_distribution<size_t> pickAccount(0, ids.size() - 1);
+    const std::string amount = "01000000000000000000000000000000";
+    const std::string toKeys = nlohmann::json{{"nullifier_public_key", accountIdHex(1)},
+                                              {"viewing_public_key", std::string(66, 'b')}}
+                                   .dump();
+
+    while (Clock::now() < deadline) {
+        const int op = pickOperation(rng);
+        const std::string& from = ids[pickAccount(rng)];
+        const std::string& to = ids[pickAccount(rng)];
+
+        const auto start = Clock::now();
+        bool ok = false;
+        switch (op) {
+        case Read:
+            ok = !module.get_balance(from, true).empty();
+            break;
+        case PublicTransfer:
+            ok = succeeded(module.transfer_public(from, to, amount));
+            break;
+        case PrivateTransfer:
+            ok = succeeded(module.transfer_private(from, toKeys, amount));
+            break;
+        case Poll:
+            ok = module.poll_transaction_status(from);
+            break;
+        }
+        const auto elapsed = std::chrono::duration_cast<microseconds>(Clock::now() - start);
+
+        stats.latencyUs[op].push_back(elapsed.count());
+        if (!ok)
+            ++stats.errors[op];
+    }
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, const double p) {
+    if (sorted.empty())
+        return 0;
+    return sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))];
+}
+
+bool parseMix(const std::string& mix, int (&weights)[OperationCount]) {
+    std::fill(std::begin(weights), std::end(weights), 0);
+    size_t pos = 0;
+    while (pos < mix.size()) {
+        const size_t comma = std::min(mix.find(',', pos), mix.size());
+        const std::string item = mix.substr(pos, comma - pos);
+        const size_t eq = item.find('=');
+        const auto name = std::find_if(std::begin(OPERATION_NAMES), std::end(OPERATION_NAMES),
+                                       [&item, eq](const char* n) { return item.compare(0, eq, n) == 0; });
+        if (eq == std::string::npos || name == std::end(OPERATION_NAMES))
+            return false;
+        weights[name - std::begin(OPERATION_NAMES)] = std::atoi(item.c_str() + eq + 1);
+        pos = comma + 1;
+    }
+    return std::any_of(std::begin(weights), std::end(weights), [](const int w) { return w > 0; });
+}
+
+bool parseArgs(const int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--serial-reads") {
+            options.serialReads = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--threads") {
+            options.threads = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--duration-ms") {
+            options.duration = std::chrono::milliseconds(std::atoll(value.c_str()));
+        } else if (arg == "--accounts") {
+            options.accounts = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--mix") {
+            if (!parseMix(value, options.weights)) {
+                fprintf(stderr, "bad --mix %s\n", value.c_str());
+                return false;
+            }
+        } else if (arg == "--latency-scale") {
+            options.latencyScale = std::atof(value.c_str());
+        } else if (arg == "--out") {
+            options.outPath = value;
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options))
+        return 2;
+
+    // Defaults elsewhere are all SUCCESS; only open needs a non-null handle.
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    configureMock(options);
+
+    nlohmann::json report = nlohmann::json::object();
+    {
+        LEZCoreModule module;
+        if (module.open("/bench/cfg", "/bench/store", "/bench/stats") != SUCCESS) {
+            fprintf(stderr, "cannot open mock wallet\n");
+            return 2;
+        }
+
+        std::vector<std::string> ids;
+        for (int i = 0; i < options.accounts; ++i)
+            ids.push_back(accountIdHex(i));
+
+        std::vector<ThreadStats> stats(options.threads);
+        std::vector<std::thread> workers;
+        const auto start = Clock::now();
+        const auto deadline = start + options.duration;
+        for (int i = 0; i < options.threads; ++i)
+            workers.emplace_back(runWorker, std::ref(module), std::cref(options), std::cref(ids), deadline,
+                                 std::ref(stats[i]));
+        for (std::thread& worker : workers)
+            worker.join();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        uint64_t totalOps = 0;
+        nlohmann::json operations = nlohmann::json::array();
+        for (int op = 0; op < OperationCount; ++op) {
+            std::vector<int64_t> latencies;
+            uint64_t errors = 0;
+            for (const ThreadStats& s : stats) {
+                latencies.insert(latencies.end(), s.latencyUs[op].begin(), s.latencyUs[op].end());
+                errors += s.errors[op];
+            }
+            if (latencies.empty())
+                continue;
+            std::sort(latencies.begin(), latencies.end());
+            totalOps += latencies.size();
+
+            nlohmann::json entry = nlohmann::json::object();
+            entry["name"] = OPERATION_NAMES[op];
+            entry["count"] = latencies.size();
+            entry["errors"] = errors;
+            entry["ops_per_sec"] = static_cast<double>(latencies.size()) / seconds;
+            entry["p50_us"] = percentile(latencies, 0.50);
+            entry["p90_us"] = percentile(latencies, 0.90);
+            entry["p99_us"] = percentile(latencies, 0.99);
+            entry["max_us"] = latencies.back();
+            operations.push_back(entry);
+        }
+
+        report["schema"] = 1;
+        report["threads"] = options.threads;
+        report["duration_ms"] = options.duration.count();
+        report["accounts"] = options.accounts;
+        report["latency_scale"] = options.latencyScale;
+        report["total_ops"] = totalOps;
+        report["ops_per_sec"] = static_cast<double>(totalOps) / seconds;
+        report["operations"] = operations;
+        // The module's own view: per-method FFI time vs. total time.
+        report["module_metrics"] = nlohmann::json::parse(module.get_metrics(), nullptr, false);
+    }
+    report["injected_failures"] = MockWalletFfiBehavior::injectedFailures();
+    report["overlap_violations"] = MockWalletFfiBehavior::overlapViolations();
+
+    if (options.outPath.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream out(options.outPath);
+        out << report.dump(2) << std::endl;
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", options.outPath.c_str());
+            return 2;
+        }
+    }
+
+    if (report["overlap_violations"].get<int>() > 0) {
+        fprintf(stderr, "wallet_ffi calls overlapped that must be serialised\n");
+        return 1;
+    }
+    return report["total_ops"].get<uint64_t>() > 0 ? 0 : 1;
+}
@@ -3,8 +3,11 @@
 // Return codes and out-parameter contents are controlled via LogosCMockStore.
 //
 // Conventions:
-//  - Functions returning WalletFfiError use LOGOS_CMOCK_RETURN(int, "<fn>"); an
-//    unset mock defaults to 0 (SUCCESS), so the happy path needs no setup.
+//  - Functions returning WalletFfiError use mockError("<fn>"), i.e. the
+//    LOGOS_CMOCK_RETURN(int, "<fn>") value; an unset mock defaults to 0 (SUCCESS), so
+//    the happy path needs no setup.
+//  - mockError() first applies any latency / failure injection configured through
+//    MockWalletFfiBehavior (benchmarks only; a no-op in the unit tests).
 //  - Out-parameters are filled with deterministic bytes only on success so tests
 //    can assert on the resulting hex/JSON.
 
@@ -14,6 +17,7 @@ extern "C" {
 #include <wallet_ffi.h>
 }
 
+#include "mock_wallet_ffi_behavior.h"
 #include "mock_wallet_ffi_capture.h"
 
 #include <cstdlib>
@@ -22,6 +26,22 @@ extern "C" {
 namespace MockWalletFfiCapture {
 uint8_t lastTransferShieldedIdentifier[16] = {0};
 uint8_t lastTransferPrivateIdentifier[16] = {0};
+const FfiPrivateAccountKeys* lastTransferPrivateKeys = nullptr;
+
+std::atomic<int> getBalanceCalls{0};
+std::atomic<int> getAccountPublicCalls{0};
+std::atomic<int> getVaultBalanceCalls{0};
+std::atomic<int> pollTransactionStatusCalls{0};
+std::atomic<int> syncToBlockCalls{0};
+std::atomic<uint64_t> lastSyncToBlock{0};
+std::atomic<int> builtinElfFetchCalls{0};
+const uint8_t* lastPrivateProgramElf = nullptr;
+uintptr_t lastPrivateProgramDependencies = 0;
+uint32_t lastGenericPublicInstruction[4] = {0};
+uintptr_t lastGenericPublicAccounts = 0;
+std::atomic<int> sendGenericPublicCalls{0};
+std::atomic<int> resolvePublicAccountCalls{0};
+std::atomic<int> resolvePrivateAccountCalls{0};
 } // namespace MockWalletFfiCapture
 
 namespace {
@@ -32,9 +52,16 @@ char g_fakeWallet = 0;
 // Backing storage for list_accounts (returned by pointer to the caller).
 FfiAccountListEntry g_accountEntries[8];
 
+// Error code for `fn`: an injected failure if MockWalletFfiBehavior produced one, else the
+// LogosCMockStore value. usesWallet = false for functions that take no WalletHandle.
+int mockError(const char* fn, const bool usesWallet = true) {
+    const int injected = MockWalletFfiBehavior::onCall(fn, usesWallet);
+    return injected != 0 ? injected : LogosCMockStore::instance().getReturn<int>(fn);
+}
+
 // Fill a transfer result based on the mocked error code for `key`.
 WalletFfiError fillTransferResult(const char* key, FfiTransferResult* out_result) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key);
     if (out_result) {
         out_result->success = (err == 0);
         if (err == 0) {
@@ -73,7 +100,7 @@ WalletHandle* wallet_ffi_open(const char*, const char*, const char*) {
 
 int wallet_ffi_save(WalletHandle*) {
     LOGOS_CMOCK_RECORD("wallet_ffi_save");
-    return LOGOS_CMOCK_RETURN(int, "wallet_ffi_save");
+    return mockError("wallet_ffi_save");
 }
 
 void wallet_ffi_destroy(WalletHandle*) {
@@ -82,7 +109,7 @@ void wallet_ffi_destroy(WalletHandle*) {
 
 WalletFfiError wallet_ffi_restore_data(WalletHandle*, const char*, const char*, uint32_t) {
     LOGOS_CMOCK_RECORD("wallet_ffi_restore_data");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_restore_data");
+    const int err = mockError("wallet_ffi_restore_data");
     return static_cast<WalletFfiError>(err);
 }
 
@@ -90,7 +117,7 @@ WalletFfiError wallet_ffi_restore_data(WalletHandle*, const char*, const char*,
 
 WalletFfiError wallet_ffi_create_account_public(WalletHandle*, FfiBytes32* out_id) {
     LOGOS_CMOCK_RECORD("wallet_ffi_create_account_public");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_create_account_public");
+    const int err = mockError("wallet_ffi_create_account_public");
     if (err == 0 && out_id) {
         memset(out_id->data, 0xAB, sizeof(out_id->data));
     }
@@ -99,7 +126,7 @@ WalletFfiError wallet_ffi_create_account_public(WalletHandle*, FfiBytes32* out_i
 
 WalletFfiError wallet_ffi_create_account_private(WalletHandle*, FfiBytes32* out_id) {
     LOGOS_CMOCK_RECORD("wallet_ffi_create_account_private");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_create_account_private");
+    const int err = mockError("wallet_ffi_create_account_private");
     if (err == 0 && out_id) {
         memset(out_id->data, 0xCD, sizeof(out_id->data));
     }
@@ -108,7 +135,7 @@ WalletFfiError wallet_ffi_create_account_private(WalletHandle*, FfiBytes32* out_
 
 WalletFfiError wallet_ffi_list_accounts(WalletHandle*, FfiAccountList* out_list) {
     LOGOS_CMOCK_RECORD("wallet_ffi_list_accounts");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_list_accounts");
+    const int err = mockError("wallet_ffi_list_accounts");
     if (!out_list) {
         return static_cast<WalletFfiError>(err);
     }
@@ -141,7 +168,8 @@ void wallet_ffi_free_account_list(FfiAccountList* list) {
 
 WalletFfiError wallet_ffi_get_balance(WalletHandle*, const FfiBytes32*, bool, uint8_t (*out_balance)[16]) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_balance");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_balance");
+    ++MockWalletFfiCapture::getBalanceCalls;
+    const int err = mockError("wallet_ffi_get_balance");
     if (err == 0 && out_balance) {
         const uint64_t value = static_cast<uint64_t>(LOGOS_CMOCK_RETURN(int, "get_balance_value"));
         memset(*out_balance, 0, 16);
@@ -153,22 +181,29 @@ WalletFfiError wallet_ffi_get_balance(WalletHandle*, const FfiBytes32*, bool, ui
 }
 
 static WalletFfiError fillProgram(const char* key, FfiProgram *ffi_program) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key, false);
+    ++MockWalletFfiCapture::builtinElfFetchCalls;
     if (err == 0 && ffi_program) {
-        memset(const_cast<uint8_t*>(ffi_program->elf_data), 0xAA, 100);
+        // Released by wallet_ffi_free_ffi_program, like the library's own buffers.
+        uint8_t* elf = static_cast<uint8_t*>(malloc(100));
+        memset(elf, 0xAA, 100);
+        ffi_program->elf_data = elf;
         ffi_program->elf_size = 100;
     }
     return static_cast<WalletFfiError>(err);
 }
 
 static WalletFfiError fillAccount(const char* key, FfiAccount* out_account) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key);
     if (err == 0 && out_account) {
         memset(out_account->program_owner.data, 0xAA, sizeof(out_account->program_owner.data));
+        // "account_balance_value" / "account_nonce_value" override the defaults of 7 and 1.
+        const int balance = LOGOS_CMOCK_RETURN(int, "account_balance_value");
+        const int nonce = LOGOS_CMOCK_RETURN(int, "account_nonce_value");
         memset(out_account->balance.data, 0, sizeof(out_account->balance.data));
-        out_account->balance.data[0] = 0x07;
+        out_account->balance.data[0] = static_cast<uint8_t>(balance != 0 ? balance : 0x07);
         memset(out_account->nonce.data, 0, sizeof(out_account->nonce.data));
-        out_account->nonce.data[0] = 0x01;
+        out_account->nonce.data[0] = static_cast<uint8_t>(nonce != 0 ? nonce : 0x01);
         out_account->data = nullptr;
         out_account->data_len = 0;
     }
@@ -176,7 +211,7 @@ static WalletFfiError fillAccount(const char* key, FfiAccount* out_account) {
 }
 
 static WalletFfiError fillPublicAccountIdentity(const char* key, FfiAccountIdentity *out_account_identity) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key, false);
     if (err == 0 && out_account_identity) {
         out_account_identity->kind = FfiAccountIdentityKind::PUBLIC;
         memset(out_account_identity->account_id.data, 0xAA, sizeof(out_account_identity->account_id));
@@ -191,7 +226,7 @@ static WalletFfiError fillPublicAccountIdentity(const char* key, FfiAccountIdent
 }
 
 static WalletFfiError fillPrivateAccountIdentity(const char* key, FfiAccountIdentity *out_account_identity) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key);
     if (err == 0 && out_account_identity) {
         out_account_identity->kind = FfiAccountIdentityKind::PRIVATE_OWNED;
         memset(out_account_identity->account_id.data, 0xAB, sizeof(out_account_identity->account_id));
@@ -206,7 +241,7 @@ static WalletFfiError fillPrivateAccountIdentity(const char* key, FfiAccountIden
 }
 
 static WalletFfiError fillTransactionResult(const char* key, FfiTransactionResult *out_result) {
-    const int err = LogosCMockStore::instance().getReturn<int>(key);
+    const int err = mockError(key);
     if (out_result) {
         out_result->success = (err == 0);
         if (err == 0) {
@@ -224,6 +259,7 @@ static WalletFfiError fillTransactionResult(const char* key, FfiTransactionResul
 
 WalletFfiError wallet_ffi_get_account_public(WalletHandle*, const FfiBytes32*, FfiAccount* out_account) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_account_public");
+    ++MockWalletFfiCapture::getAccountPublicCalls;
     return fillAccount("wallet_ffi_get_account_public", out_account);
 }
 
@@ -243,7 +279,7 @@ void wallet_ffi_free_account_data(FfiAccount* account) {
 
 WalletFfiError wallet_ffi_get_public_account_key(WalletHandle*, const FfiBytes32*, FfiPublicAccountKey* out_key) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_public_account_key");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_public_account_key");
+    const int err = mockError("wallet_ffi_get_public_account_key");
     if (err == 0 && out_key) {
         memset(out_key->public_key.data, 0xBE, sizeof(out_key->public_key.data));
     }
@@ -252,7 +288,7 @@ WalletFfiError wallet_ffi_get_public_account_key(WalletHandle*, const FfiBytes32
 
 WalletFfiError wallet_ffi_get_private_account_keys(WalletHandle*, const FfiBytes32*, FfiPrivateAccountKeys* out_keys) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_private_account_keys");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_private_account_keys");
+    const int err = mockError("wallet_ffi_get_private_account_keys");
     if (err == 0 && out_keys) {
         memset(out_keys->nullifier_public_key.data, 0xEF, sizeof(out_keys->nullifier_public_key.data));
         out_keys->viewing_public_key = nullptr;
@@ -280,7 +316,7 @@ char* wallet_ffi_account_id_to_base58(const FfiBytes32*) {
 
 WalletFfiError wallet_ffi_account_id_from_base58(const char*, FfiBytes32* out_id) {
     LOGOS_CMOCK_RECORD("wallet_ffi_account_id_from_base58");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_account_id_from_base58");
+    const int err = mockError("wallet_ffi_account_id_from_base58", false);
     if (err == 0 && out_id) {
         memset(out_id->data, 0x5A, sizeof(out_id->data));
     }
@@ -296,14 +332,16 @@ void wallet_ffi_free_string(char* s) {
 
 // === Blockchain synchronisation ===
 
-int wallet_ffi_sync_to_block(WalletHandle*, uint64_t) {
+int wallet_ffi_sync_to_block(WalletHandle*, uint64_t block_id) {
     LOGOS_CMOCK_RECORD("wallet_ffi_sync_to_block");
-    return LOGOS_CMOCK_RETURN(int, "wallet_ffi_sync_to_block");
+    ++MockWalletFfiCapture::syncToBlockCalls;
+    MockWalletFfiCapture::lastSyncToBlock = block_id;
+    return mockError("wallet_ffi_sync_to_block");
 }
 
 WalletFfiError wallet_ffi_get_last_synced_block(WalletHandle*, uint64_t* out_block_id) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_last_synced_block");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_last_synced_block");
+    const int err = mockError("wallet_ffi_get_last_synced_block");
     if (err == 0 && out_block_id) {
         *out_block_id = static_cast<uint64_t>(LOGOS_CMOCK_RETURN(int, "last_synced_block_value"));
     }
@@ -312,7 +350,7 @@ WalletFfiError wallet_ffi_get_last_synced_block(WalletHandle*, uint64_t* out_blo
 
 WalletFfiError wallet_ffi_get_current_block_height(WalletHandle*, uint64_t* out_block_height) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_current_block_height");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_current_block_height");
+    const int err = mockError("wallet_ffi_get_current_block_height");
     if (err == 0 && out_block_height) {
         *out_block_height = static_cast<uint64_t>(LOGOS_CMOCK_RETURN(int, "current_block_height_value"));
     }
@@ -367,9 +405,10 @@ WalletFfiError wallet_ffi_transfer_deshielded(
 }
 
 WalletFfiError wallet_ffi_transfer_private(
-    WalletHandle*, const FfiBytes32*, const FfiPrivateAccountKeys*, const FfiU128* identifier,
+    WalletHandle*, const FfiBytes32*, const FfiPrivateAccountKeys* to_keys, const FfiU128* identifier,
     const uint8_t (*)[16], FfiTransferResult* out_result) {
     LOGOS_CMOCK_RECORD("wallet_ffi_transfer_private");
+    MockWalletFfiCapture::lastTransferPrivateKeys = to_keys;
     if (identifier) {
         memcpy(MockWalletFfiCapture::lastTransferPrivateIdentifier, identifier->data, 16);
     }
@@ -427,11 +466,13 @@ WalletFfiError wallet_ffi_amm_elf(FfiProgram *ffi_program) {
 
 WalletFfiError wallet_ffi_resolve_public_account(FfiBytes32 account_id, bool needs_sign, FfiAccountIdentity *out_account_identity) {
     LOGOS_CMOCK_RECORD("wallet_ffi_resolve_public_account");
+    ++MockWalletFfiCapture::resolvePublicAccountCalls;
     return fillPublicAccountIdentity("wallet_ffi_resolve_public_account", out_account_identity);
 }
 
 WalletFfiError wallet_ffi_resolve_private_account(WalletHandle *handle, FfiBytes32 account_id, FfiAccountIdentity *out_account_identity){
     LOGOS_CMOCK_RECORD("wallet_ffi_resolve_private_account");
+    ++MockWalletFfiCapture::resolvePrivateAccountCalls;
     return fillPrivateAccountIdentity("wallet_ffi_resolve_private_account", out_account_identity);
 }
 
@@ -474,6 +515,10 @@ WalletFfiError wallet_ffi_send_generic_public_transaction(WalletHandle *handle,
 uintptr_t account_identities_size, const uint32_t *instruction_words, uintptr_t instruction_words_size,
 FfiProgramId program_id, FfiTransactionResult *out_result) {
     LOGOS_CMOCK_RECORD("wallet_ffi_send_generic_public_transaction");
+    ++MockWalletFfiCapture::sendGenericPublicCalls;
+    MockWalletFfiCapture::lastGenericPublicAccounts = account_identities_size;
+    if (instruction_words && instruction_words_size >= 4)
+        memcpy(MockWalletFfiCapture::lastGenericPublicInstruction, instruction_words, sizeof(MockWalletFfiCapture::lastGenericPublicInstruction));
     return fillTransactionResult("wallet_ffi_send_generic_public_transaction", out_result);
 }
 
@@ -481,6 +526,10 @@ WalletFfiError wallet_ffi_send_generic_private_transaction(WalletHandle *handle,
 uintptr_t account_identities_size, const uint32_t *instruction_words, uintptr_t instruction_words_size,
 const FfiProgramWithDependencies *program_with_dependencies, FfiTransactionResult *out_result){
     LOGOS_CMOCK_RECORD("wallet_ffi_send_generic_private_transaction");
+    if (program_with_dependencies) {
+        MockWalletFfiCapture::lastPrivateProgramElf = program_with_dependencies->program.elf_data;
+        MockWalletFfiCapture::lastPrivateProgramDependencies = program_with_dependencies->deps_size;
+    }
     return fillTransactionResult("wallet_ffi_send_generic_private_transaction", out_result);
 }    
 
@@ -492,8 +541,11 @@ FfiTransactionResult *out_result) {
 
 WalletFfiError wallet_ffi_poll_transaction_status(WalletHandle *handle, FfiBytes32 tx_hash, bool *transaction_status) {
     LOGOS_CMOCK_RECORD("wallet_ffi_poll_transaction_status");
-    const int err = LogosCMockStore::instance().getReturn<int>("wallet_ffi_program_deployment");
-    *transaction_status = (err == 0);
+    ++MockWalletFfiCapture::pollTransactionStatusCalls;
+    const int err = mockError("wallet_ffi_poll_transaction_status");
+    // "poll_transaction_pending" != 0 keeps the transaction unconfirmed without an FFI error.
+    const int pending = LOGOS_CMOCK_RETURN(int, "poll_transaction_pending");
+    *transaction_status = (err == 0 && pending == 0);
     return static_cast<WalletFfiError>(err);
 }
 
@@ -509,7 +561,8 @@ WalletFfiError wallet_ffi_bridge_withdraw(
 
 WalletFfiError wallet_ffi_get_vault_balance(WalletHandle*, const FfiBytes32*, uint8_t (*out_balance)[16]) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_vault_balance");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_vault_balance");
+    ++MockWalletFfiCapture::getVaultBalanceCalls;
+    const int err = mockError("wallet_ffi_get_vault_balance");
     if (err == 0 && out_balance) {
         const uint64_t value = static_cast<uint64_t>(LOGOS_CMOCK_RETURN(int, "get_vault_balance_value"));
         memset(*out_balance, 0, 16);
@@ -544,7 +597,7 @@ char* wallet_ffi_get_sequencer_addr(WalletHandle*) {
 
 LabelAvailability wallet_ffi_check_label_available(WalletHandle *handle, const char *label) {
     LOGOS_CMOCK_RECORD("wallet_ffi_check_label_available");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_check_label_available");
+    const int err = mockError("wallet_ffi_check_label_available");
 
     LabelAvailability label_availablility;
 
@@ -561,13 +614,13 @@ LabelAvailability wallet_ffi_check_label_available(WalletHandle *handle, const c
 
 WalletFfiError wallet_ffi_add_label(WalletHandle *handle, const char *label, FfiAccountIdWithPrivacy account_id_with_privacy) {
     LOGOS_CMOCK_RECORD("wallet_ffi_add_label");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_add_label");
+    const int err = mockError("wallet_ffi_add_label");
     return static_cast<WalletFfiError>(err);
 }
 
 AccountIdResolvedFromLabel wallet_ffi_resolve_label(WalletHandle *handle, const char *label) {
     LOGOS_CMOCK_RECORD("wallet_ffi_resolve_label");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_resolve_label");
+    const int err = mockError("wallet_ffi_resolve_label");
     FfiAccountIdWithPrivacy acc_id_with_privacy;
     AccountIdResolvedFromLabel acc_id_res;
 
@@ -588,15 +641,18 @@ AccountIdResolvedFromLabel wallet_ffi_resolve_label(WalletHandle *handle, const
 
 LabelList wallet_ffi_get_all_labels_for_account(WalletHandle *handle, FfiAccountIdWithPrivacy account_id_with_privacy) {
     LOGOS_CMOCK_RECORD("wallet_ffi_get_all_labels_for_account");
-    const int err = LOGOS_CMOCK_RETURN(int, "wallet_ffi_get_all_labels_for_account");
+    const int err = mockError("wallet_ffi_get_all_labels_for_account");
 
     LabelList label_list;
 
     if (err == 0) {
-        static std::vector<const char*> labelsData = { "Label1", "Label2" };
+        // Heap-allocated like the real list, since wallet_ffi_free_label_list frees it.
+        auto** labelsData = static_cast<const char**>(malloc(2 * sizeof(const char*)));
+        labelsData[0] = "Label1";
+        labelsData[1] = "Label2";
 
-        label_list.labels_data = labelsData.data();
-        label_list.labels_size = labelsData.size();
+        label_list.labels_data = labelsData;
+        label_list.labels_size = 2;
     } else {
         label_list.labels_data = nullptr;
         label_list.labels_size = 0;
@@ -614,6 +670,7 @@ WalletFfiError wallet_ffi_free_label_list(LabelList *label_list) {
         label_list->labels_data = nullptr;
         label_list->labels_size = 0;
     }
+    return SUCCESS;
 }
 
 } // extern "C"
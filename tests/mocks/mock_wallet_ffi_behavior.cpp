@@ -0,0 +1,168 @@
+// See mock_wallet_ffi_behavior.h.
+
+#include "mock_wallet_ffi_behavior.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace MockWalletFfiBehavior {
+
+namespace {
+
+std::atomic<bool> configured{false};
+std::shared_mutex behaviorsMutex;
+std::unordered_map<std::string, FunctionBehavior> behaviors;
+
+std::atomic<bool> concurrentReads{true};
+std::atomic<int> activeExclusive{0};
+std::atomic<int> activeShared{0};
+std::atomic<int> peakShared{0};
+std::atomic<int> violations{0};
+std::atomic<int> failures{0};
+
+std::mt19937_64& rng() {
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine;
+}
+
+std::chrono::microseconds sample(const Latency& latency) {
+    switch (latency.kind) {
+    case Latency::Kind::None:
+        return std::chrono::microseconds(0);
+    case Latency::Kind::Fixed:
+        return latency.a;
+    case Latency::Kind::Uniform:
+        return std::chrono::microseconds(
+            std::uniform_int_distribution<int64_t>(latency.a.count(), latency.b.count())(rng()));
+    case Latency::Kind::LogNormal: {
+        // z(0.99) = 2.3263: pick sigma so that exp(mu + 2.3263 sigma) lands on the p99.
+        const double mu = std::log(static_cast<double>(std::max<int64_t>(1, latency.a.count())));
+        const double p99 = std::log(static_cast<double>(std::max(latency.a.count(), latency.b.count()) + 1));
+        const double sigma = std::max(0.0, (p99 - mu) / 2.3263);
+        return std::chrono::microseconds(
+            static_cast<int64_t>(std::lognormal_distribution<double>(mu, sigma)(rng())));
+    }
+    }
+    return std::chrono::microseconds(0);
+}
+
+// Mirrors the calls LEZCoreModule makes under a shared lock.
+const char* const READ_ONLY_FUNCTIONS[] = {
+    "wallet_ffi_list_accounts",
+    "wallet_ffi_get_balance",
+    "wallet_ffi_get_account_public",
+    "wallet_ffi_get_account_private",
+    "wallet_ffi_get_public_account_key",
+    "wallet_ffi_get_private_account_keys",
+    "wallet_ffi_get_last_synced_block",
+    "wallet_ffi_get_current_block_height",
+    "wallet_ffi_get_vault_balance",
+    "wallet_ffi_poll_transaction_status",
+    "wallet_ffi_get_sequencer_addr",
+    "wallet_ffi_check_label_available",
+    "wallet_ffi_resolve_label",
+    "wallet_ffi_get_all_labels_for_account",
+};
+
+} // namespace
+
+bool isReadOnly(const char* function) {
+    return std::any_of(std::begin(READ_ONLY_FUNCTIONS), std::end(READ_ONLY_FUNCTIONS),
+                       [function](const char* name) { return std::strcmp(name, function) == 0; });
+}
+
+Latency Latency::fixed(const std::chrono::microseconds value) {
+    return Latency{Kind::Fixed, value, value};
+}
+
+Latency Latency::uniform(const std::chrono::microseconds min, const std::chrono::microseconds max) {
+    return Latency{Kind::Uniform, min, max};
+}
+
+Latency Latency::logNormal(const std::chrono::microseconds median, const std::chrono::microseconds p99) {
+    return Latency{Kind::LogNormal, median, p99};
+}
+
+void configure(const std::string& function, const FunctionBehavior& behavior) {
+    std::unique_lock lock(behaviorsMutex);
+    behaviors[function] = behavior;
+    configured = true;
+}
+
+void reset() {
+    std::unique_lock lock(behaviorsMutex);
+    behaviors.clear();
+    configured = false;
+    concurrentReads = true;
+    peakShared = 0;
+    violations = 0;
+    failures = 0;
+}
+
+void setAllowConcurrentReads(const bool allow) {
+    concurrentReads = allow;
+}
+
+int overlapViolations() {
+    return violations.load();
+}
+
+int peakConcurrentReads() {
+    return peakShared.load();
+}
+
+int injectedFailures() {
+    return failures.load();
+}
+
+int onCall(const char* function, const bool usesWallet) {
+    if (!configured.load(std::memory_order_relaxed))
+        return 0;
+
+    FunctionBehavior behavior;
+    {
+        std::shared_lock lock(behaviorsMutex);
+        const auto it = behaviors.find(function);
+        if (it != behaviors.end())
+            behavior = it->second;
+    }
+
+    // The call "holds" the wallet for the whole injected latency, so two calls the module
+    // failed to serialise are very likely to be caught overlapping here.
+    const bool readOnly = isReadOnly(function);
+    if (usesWallet) {
+        if (readOnly) {
+            const int shared = activeShared.fetch_add(1) + 1;
+            int peak = peakShared.load();
+            while (shared > peak && !peakShared.compare_exchange_weak(peak, shared)) {
+            }
+            if (activeExclusive.load() > 0 || (shared > 1 && !concurrentReads.load()))
+                ++violations;
+        } else {
+            if (activeExclusive.fetch_add(1) > 0 || activeShared.load() > 0)
+                ++violations;
+        }
+    }
+
+    const std::chrono::microseconds delay = sample(behavior.latency);
+    if (delay.count() > 0)
+        std::this_thread::sleep_for(delay);
+
+    if (usesWallet)
+        --(readOnly ? activeShared : activeExclusive);
+
+    if (behavior.failureRate > 0.0 && std::bernoulli_distribution(behavior.failureRate)(rng())) {
+        ++failures;
+        return behavior.failureCode;
+    }
+    return 0;
+}
+
+} // namespace MockWalletFfiBehavior
@@ -0,0 +1,62 @@
+#ifndef MOCK_WALLET_FFI_BEHAVIOR_H
+#define MOCK_WALLET_FFI_BEHAVIOR_H
+
+// Optional "realistic library" behaviour for the wallet_ffi mock, used by the end-to-end
+// benchmark (tests/bench_module.cpp). Per function it can inject latency drawn from a
+// distribution and fail a fraction of calls with a given error code. It also checks the
+// module's locking contract: a wallet call that changes state must not overlap any other
+// wallet call, while read-only ones (isReadOnly) may overlap each other.
+//
+// Nothing is configured by default, and then onCall() is a single atomic load: the unit
+// tests see the mock exactly as before.
+
+#include <chrono>
+#include <string>
+
+namespace MockWalletFfiBehavior {
+
+struct Latency {
+    enum class Kind { None, Fixed, Uniform, LogNormal };
+    Kind kind = Kind::None;
+    // Fixed: a. Uniform: [a, b]. LogNormal: median a, 99th percentile b.
+    std::chrono::microseconds a{0};
+    std::chrono::microseconds b{0};
+
+    static Latency fixed(std::chrono::microseconds value);
+    static Latency uniform(std::chrono::microseconds min, std::chrono::microseconds max);
+    static Latency logNormal(std::chrono::microseconds median, std::chrono::microseconds p99);
+};
+
+struct FunctionBehavior {
+    Latency latency;
+    double failureRate = 0.0;
+    int failureCode = 1; // INTERNAL_ERROR
+};
+
+// Whether `function` only reads wallet state, i.e. may run concurrently with other reads.
+bool isReadOnly(const char* function);
+
+// Behaviour for one wallet_ffi function (by its C name), replacing any earlier one.
+void configure(const std::string& function, const FunctionBehavior& behavior);
+// Drops all behaviour and zeroes the counters.
+void reset();
+
+// Whether two read-only calls may be in flight at once without counting as a violation
+// (default: yes).
+void setAllowConcurrentReads(bool allow);
+
+// Number of calls that overlapped a call they must not overlap with.
+int overlapViolations();
+// Most read-only calls seen in flight at once.
+int peakConcurrentReads();
+// Number of calls failed by failureRate.
+int injectedFailures();
+
+// Called by the mock before it produces a return code: sleeps for the sampled latency
+// while tracking overlap (unless the function takes no wallet handle), then returns the
+// injected error code or 0.
+int onCall(const char* function, bool usesWallet);
+
+} // namespace MockWalletFfiBehavior
+
+#endif // MOCK_WALLET_FFI_BEHAVIOR_H
@@ -4,13 +4,37 @@
 // LogosCMockStore (logos_clib_mock.h) only lets tests control return values, not
 // inspect call arguments. The transfer_shielded/transfer_private identifier logic
 // needs the latter, so capture the relevant args here in plain static storage.
+// Call counters cover what cFunctionCalled() can't: how many times a function ran
+// (e.g. to prove a cached read did not reach the FFI). They are atomic because module
+// worker threads call into the mock too. Tests reset them explicitly.
 
+#include <atomic>
 #include <cstdint>
 
+extern "C" {
+#include <wallet_ffi.h>
+}
+
 namespace MockWalletFfiCapture {
 
 extern uint8_t lastTransferShieldedIdentifier[16];
 extern uint8_t lastTransferPrivateIdentifier[16];
+extern const FfiPrivateAccountKeys* lastTransferPrivateKeys;
+extern const uint8_t* lastPrivateProgramElf;
+extern uintptr_t lastPrivateProgramDependencies;
+extern uint32_t lastGenericPublicInstruction[4];
+extern uintptr_t lastGenericPublicAccounts;
+
+extern std::atomic<int> getBalanceCalls;
+extern std::atomic<int> getAccountPublicCalls;
+extern std::atomic<int> getVaultBalanceCalls;
+extern std::atomic<int> pollTransactionStatusCalls;
+extern std::atomic<int> syncToBlockCalls;
+extern std::atomic<uint64_t> lastSyncToBlock;
+extern std::atomic<int> builtinElfFetchCalls;
+extern std::atomic<int> sendGenericPublicCalls;
+extern std::atomic<int> resolvePublicAccountCalls;
+extern std::atomic<int> resolvePrivateAccountCalls;
 
 } // namespace MockWalletFfiCapture
 
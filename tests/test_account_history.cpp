@@ -0,0 +1,120 @@
+// Unit tests for AccountHistory: cursor paging, both record kinds, the on/off switch and the
+// per-account cap.
+
+#include <logos_test.h>
+#include "account_history.h"
+
+#include <vector>
+
+namespace {
+
+FfiBytes32 filled(const uint8_t byte) {
+    FfiBytes32 id{};
+    for (uint8_t& b : id.data)
+        b = byte;
+    return id;
+}
+
+std::array<uint8_t, 16> value16(const uint8_t low) {
+    std::array<uint8_t, 16> value{};
+    value[0] = low;
+    return value;
+}
+
+} // namespace
+
+LOGOS_TEST(account_history_pages_newest_first) {
+    AccountHistory history;
+    history.setEnabled(true);
+    for (uint8_t i = 1; i <= 10; ++i)
+        history.recordSubmission("transfer_public", {filled(0xa1), filled(0xb1)}, nullptr, filled(i), i, 1000 + i);
+
+    std::vector<uint64_t> ids;
+    uint64_t cursor = 0;
+    int pages = 0;
+    do {
+        const AccountHistory::Page page = history.query(filled(0xa1), cursor, 4);
+        for (const AccountHistory::Record& record : page.records)
+            ids.push_back(record.id);
+        cursor = page.nextCursor;
+        ++pages;
+    } while (cursor != 0);
+
+    LOGOS_ASSERT_EQ(pages, 3);
+    LOGOS_ASSERT_EQ(ids.size(), size_t{10});
+    for (size_t i = 0; i < ids.size(); ++i)
+        LOGOS_ASSERT_EQ(ids[i], uint64_t{10 - i});
+
+    const AccountHistory::Page newest = history.query(filled(0xb1), 0, 1);
+    LOGOS_ASSERT_EQ(newest.records.size(), size_t{1});
+    LOGOS_ASSERT_EQ(*newest.records[0].method, std::string("transfer_public"));
+    LOGOS_ASSERT_EQ(newest.records[0].txHash.data[0], 10);
+    LOGOS_ASSERT_EQ(newest.records[0].block, uint64_t{10});
+    LOGOS_ASSERT_EQ(newest.records[0].timeMs, int64_t{1010});
+    LOGOS_ASSERT_TRUE(history.query(filled(0xcc), 0, 10).records.empty());
+}
+
+LOGOS_TEST(account_history_lists_a_transaction_once_per_account) {
+    AccountHistory history;
+    history.setEnabled(true);
+    const uint8_t amount[16] = {3};
+    history.recordSubmission("transfer_public", {filled(0xa1), filled(0xa1)}, amount, filled(0x01), 1, 1);
+
+    const AccountHistory::Page page = history.query(filled(0xa1), 0, 10);
+    LOGOS_ASSERT_EQ(page.records.size(), size_t{1});
+    LOGOS_ASSERT_TRUE(page.records[0].hasAmount);
+    LOGOS_ASSERT_EQ(page.records[0].amount[0], 3);
+    LOGOS_ASSERT_EQ(page.nextCursor, uint64_t{0});
+}
+
+LOGOS_TEST(account_history_interleaves_changes_and_submissions) {
+    AccountHistory history;
+    history.setEnabled(true);
+    history.recordChange(filled(0xa1), 7, value16(7), value16(9), value16(1));
+    history.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x01), 7, 1);
+    history.recordChange(filled(0xa1), 8, value16(9), value16(4), value16(2));
+
+    const AccountHistory::Page page = history.query(filled(0xa1), 0, 10);
+    LOGOS_ASSERT_EQ(page.records.size(), size_t{3});
+    LOGOS_ASSERT_TRUE(page.records[0].kind == AccountHistory::Kind::BalanceChange);
+    LOGOS_ASSERT_EQ(page.records[0].block, uint64_t{8});
+    LOGOS_ASSERT_EQ(page.records[0].nonce[0], 2);
+    LOGOS_ASSERT_TRUE(page.records[1].kind == AccountHistory::Kind::Submission);
+    LOGOS_ASSERT_EQ(page.records[2].previousBalance[0], 7);
+    LOGOS_ASSERT_EQ(page.records[2].balance[0], 9);
+    LOGOS_ASSERT_GT(page.records[2].timeMs, int64_t{0});
+}
+
+LOGOS_TEST(account_history_records_nothing_while_off) {
+    AccountHistory history;
+    history.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x01), 1, 1);
+    history.recordChange(filled(0xa1), 1, value16(7), value16(9), value16(1));
+    LOGOS_ASSERT_TRUE(history.query(filled(0xa1), 0, 10).records.empty());
+
+    history.setEnabled(true);
+    history.recordChange(filled(0xa1), 2, value16(7), value16(9), value16(1));
+    LOGOS_ASSERT_EQ(history.query(filled(0xa1), 0, 10).records.size(), size_t{1});
+}
+
+LOGOS_TEST(account_history_keeps_the_newest_records_per_account) {
+    AccountHistory history;
+    history.setEnabled(true);
+    const size_t total = AccountHistory::MaxRecordsPerAccount + 5;
+    for (size_t i = 0; i < total; ++i)
+        history.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x01), i, 0);
+
+    size_t count = 0;
+    uint64_t cursor = 0;
+    uint64_t oldest = 0;
+    do {
+        const AccountHistory::Page page = history.query(filled(0xa1), cursor, 1000);
+        count += page.records.size();
+        oldest = page.records.back().id;
+        cursor = page.nextCursor;
+    } while (cursor != 0);
+    LOGOS_ASSERT_EQ(count, AccountHistory::MaxRecordsPerAccount);
+    LOGOS_ASSERT_EQ(oldest, uint64_t{6});
+
+    history.clear();
+    LOGOS_ASSERT_TRUE(history.query(filled(0xa1), 0, 10).records.empty());
+}
@@ -0,0 +1,53 @@
+// Unit tests for AsyncRequests: results handed out once, and uncollected results expiring by
+// count and by age.
+
+#include <logos_test.h>
+#include "async_requests.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using State = AsyncRequests::State;
+
+LOGOS_TEST(async_requests_hands_a_result_out_once) {
+    AsyncRequests requests(1);
+    const int64_t ticket = requests.submit("transfer_public", [] { return std::string("done"); });
+    LOGOS_ASSERT_GT(ticket, int64_t{0});
+
+    const AsyncRequests::Status status = requests.await(ticket, std::chrono::seconds(5));
+    LOGOS_ASSERT_TRUE(status.state == State::Done);
+    LOGOS_ASSERT_EQ(status.method, std::string("transfer_public"));
+    LOGOS_ASSERT_EQ(status.result, std::string("done"));
+    LOGOS_ASSERT_TRUE(requests.poll(ticket).state == State::Unknown);
+    LOGOS_ASSERT_EQ(requests.finishedCount(), size_t{0});
+    requests.shutdown();
+}
+
+LOGOS_TEST(async_requests_keeps_the_newest_uncollected_results) {
+    AsyncRequests requests(1, 3, std::chrono::hours(1));
+    std::vector<int64_t> tickets;
+    for (int i = 0; i < 5; ++i)
+        tickets.push_back(requests.submit("transfer_public", [i] { return std::to_string(i); }));
+    // Runs every queued job to completion.
+    requests.shutdown();
+
+    LOGOS_ASSERT_EQ(requests.finishedCount(), size_t{3});
+    LOGOS_ASSERT_TRUE(requests.poll(tickets[0]).state == State::Unknown);
+    LOGOS_ASSERT_TRUE(requests.poll(tickets[1]).state == State::Unknown);
+    for (int i = 2; i < 5; ++i)
+        LOGOS_ASSERT_EQ(requests.poll(tickets[i]).result, std::to_string(i));
+    LOGOS_ASSERT_EQ(requests.finishedCount(), size_t{0});
+}
+
+LOGOS_TEST(async_requests_expires_old_results) {
+    AsyncRequests requests(1, 100, std::chrono::milliseconds(20));
+    const int64_t ticket = requests.submit("transfer_public", [] { return std::string("done"); });
+    requests.shutdown();
+    LOGOS_ASSERT_EQ(requests.finishedCount(), size_t{1});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    LOGOS_ASSERT_TRUE(requests.poll(ticket).state == State::Unknown);
+    LOGOS_ASSERT_EQ(requests.finishedCount(), size_t{0});
+}
@@ -0,0 +1,93 @@
+// Unit tests for Autosave: both triggers, the flush() barrier, the final save on stop() and
+// retrying after a failed save. The save callback only counts calls.
+
+#include <logos_test.h>
+#include "autosave.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static void waitForSaves(const std::atomic<int>& saves, const int count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (saves.load() < count && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(1ms);
+}
+
+LOGOS_TEST(autosave_saves_once_per_full_batch) {
+    std::atomic<int> saves{0};
+    Autosave autosave([&] { ++saves; return 0; });
+    autosave.configure(5, 0ms);
+
+    for (int i = 0; i < 4; ++i)
+        autosave.markDirty();
+    std::this_thread::sleep_for(20ms);
+    LOGOS_ASSERT_EQ(saves.load(), 0);
+
+    autosave.markDirty();
+    waitForSaves(saves, 1);
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+    LOGOS_ASSERT_EQ(autosave.snapshot()["pending_mutations"].get<int>(), 0);
+}
+
+LOGOS_TEST(autosave_saves_after_delay) {
+    std::atomic<int> saves{0};
+    Autosave autosave([&] { ++saves; return 0; });
+    autosave.configure(0, 20ms);
+
+    for (int i = 0; i < 10; ++i)
+        autosave.markDirty();
+    waitForSaves(saves, 1);
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+    LOGOS_ASSERT_EQ(autosave.snapshot()["mutations"].get<int>(), 10);
+}
+
+LOGOS_TEST(autosave_flush_is_a_barrier) {
+    std::atomic<int> saves{0};
+    Autosave autosave([&] { ++saves; return 0; });
+
+    LOGOS_ASSERT_EQ(autosave.flush(), 0);
+    LOGOS_ASSERT_EQ(saves.load(), 0);
+    autosave.markDirty();
+    autosave.markDirty();
+    LOGOS_ASSERT_EQ(autosave.flush(), 0);
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+    LOGOS_ASSERT_EQ(autosave.flush(), 0);
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+    LOGOS_ASSERT_EQ(autosave.flush(true), 0);
+    LOGOS_ASSERT_EQ(saves.load(), 2);
+}
+
+LOGOS_TEST(autosave_stop_saves_pending_changes_only_when_enabled) {
+    std::atomic<int> saves{0};
+    {
+        Autosave autosave([&] { ++saves; return 0; });
+        autosave.configure(1000, 60000ms);
+        autosave.markDirty();
+    }
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+
+    {
+        Autosave autosave([&] { ++saves; return 0; });
+        autosave.markDirty();
+    }
+    LOGOS_ASSERT_EQ(saves.load(), 1);
+}
+
+LOGOS_TEST(autosave_failed_save_keeps_changes_pending) {
+    std::atomic<int> result{7};
+    std::atomic<int> attempts{0};
+    Autosave autosave([&] { ++attempts; return result.load(); });
+
+    autosave.markDirty();
+    LOGOS_ASSERT_EQ(autosave.flush(), 7);
+    LOGOS_ASSERT_EQ(autosave.snapshot()["pending_mutations"].get<int>(), 1);
+    LOGOS_ASSERT_EQ(autosave.snapshot()["save_failures"].get<int>(), 1);
+
+    result = 0;
+    LOGOS_ASSERT_EQ(autosave.flush(), 0);
+    LOGOS_ASSERT_EQ(autosave.snapshot()["pending_mutations"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(attempts.load(), 2);
+}
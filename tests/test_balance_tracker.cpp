@@ -0,0 +1,83 @@
+// Unit tests for BalanceTracker: the first snapshot as baseline, diffs of moved accounts only,
+// the event log and its cursor, and reset().
+
+#include <logos_test.h>
+#include "balance_tracker.h"
+
+#include <vector>
+
+namespace {
+
+BalanceTracker::Account account(const uint8_t id, const uint8_t balance, const uint8_t nonce) {
+    BalanceTracker::Account tracked;
+    for (uint8_t& b : tracked.id.data)
+        b = id;
+    tracked.isPublic = id % 2 == 0;
+    tracked.balance[0] = balance;
+    tracked.nonce[0] = nonce;
+    return tracked;
+}
+
+} // namespace
+
+LOGOS_TEST(balance_tracker_reports_only_moved_accounts) {
+    BalanceTracker tracker;
+    LOGOS_ASSERT_FALSE(tracker.hasBaseline());
+    LOGOS_ASSERT_TRUE(tracker.update({account(1, 7, 1), account(2, 7, 1)}, 5).empty());
+    LOGOS_ASSERT_TRUE(tracker.hasBaseline());
+    LOGOS_ASSERT_TRUE(tracker.update({account(1, 7, 1), account(2, 7, 1)}, 6).empty());
+
+    // A new account joins the baseline; a missing one keeps its values.
+    const std::vector<BalanceTracker::Change> changes = tracker.update({account(2, 9, 2), account(3, 5, 1)}, 7);
+    LOGOS_ASSERT_EQ(changes.size(), size_t{1});
+    LOGOS_ASSERT_EQ(changes[0].id.data[0], 2);
+    LOGOS_ASSERT_TRUE(changes[0].isPublic);
+    LOGOS_ASSERT_EQ(changes[0].previousBalance[0], 7);
+    LOGOS_ASSERT_EQ(changes[0].balance[0], 9);
+    LOGOS_ASSERT_EQ(changes[0].nonce[0], 2);
+    LOGOS_ASSERT_TRUE(tracker.update({account(1, 7, 1), account(3, 5, 1)}, 8).empty());
+}
+
+LOGOS_TEST(balance_tracker_logs_events_when_enabled) {
+    BalanceTracker tracker;
+    tracker.update({account(1, 7, 1)}, 5);
+    tracker.update({account(1, 8, 1)}, 6);
+    LOGOS_ASSERT_TRUE(tracker.eventsSince(0).empty());
+
+    tracker.setEvents(true);
+    tracker.update({account(1, 9, 1)}, 7);
+    tracker.update({account(1, 9, 1)}, 8);
+    tracker.update({account(1, 9, 2)}, 9);
+
+    const std::vector<BalanceTracker::Event> events = tracker.eventsSince(0);
+    LOGOS_ASSERT_EQ(events.size(), size_t{2});
+    LOGOS_ASSERT_EQ(events[0].block, uint64_t{7});
+    LOGOS_ASSERT_EQ(events[0].changes.size(), size_t{1});
+    LOGOS_ASSERT_EQ(events[1].block, uint64_t{9});
+    LOGOS_ASSERT_EQ(tracker.eventsSince(events[0].sequence).size(), size_t{1});
+    LOGOS_ASSERT_TRUE(tracker.eventsSince(events[1].sequence).empty());
+}
+
+LOGOS_TEST(balance_tracker_reset_starts_a_new_baseline) {
+    BalanceTracker tracker;
+    tracker.setEvents(true);
+    tracker.update({account(1, 7, 1)}, 5);
+    tracker.reset();
+    LOGOS_ASSERT_FALSE(tracker.hasBaseline());
+    LOGOS_ASSERT_TRUE(tracker.update({account(1, 9, 1)}, 6).empty());
+    LOGOS_ASSERT_TRUE(tracker.eventsSince(0).empty());
+}
+
+LOGOS_TEST(balance_tracker_keeps_the_latest_events) {
+    BalanceTracker tracker;
+    tracker.setEvents(true);
+    tracker.update({account(1, 0, 0)}, 0);
+    const size_t total = BalanceTracker::MaxEvents + 10;
+    for (size_t i = 1; i <= total; ++i)
+        tracker.update({account(1, static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8))}, i);
+
+    const std::vector<BalanceTracker::Event> events = tracker.eventsSince(0);
+    LOGOS_ASSERT_EQ(events.size(), BalanceTracker::MaxEvents);
+    LOGOS_ASSERT_EQ(events.front().sequence, int64_t{11});
+    LOGOS_ASSERT_EQ(events.back().block, uint64_t{total});
+}
@@ -0,0 +1,109 @@
+// Unit tests for the HexCodec kernels behind bytesToHex / hexToBytes.
+// Every kernel the build machine supports is checked against the scalar one.
+
+#include <logos_test.h>
+#include "hex_codec.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const HexCodec::Kernel ALL_KERNELS[] = {
+    HexCodec::Kernel::Scalar,
+    HexCodec::Kernel::Sse2,
+    HexCodec::Kernel::Avx2,
+};
+
+// Deterministic bytes covering every nibble value.
+static std::vector<uint8_t> patternBytes(const size_t length) {
+    std::vector<uint8_t> bytes(length);
+    for (size_t i = 0; i < length; ++i)
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    return bytes;
+}
+
+static std::string referenceHex(const std::vector<uint8_t>& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (const uint8_t b : bytes) {
+        out.push_back(digits[b >> 4]);
+        out.push_back(digits[b & 0xF]);
+    }
+    return out;
+}
+
+LOGOS_TEST(hex_codec_encode_matches_reference_for_all_lengths) {
+    for (const HexCodec::Kernel kernel : ALL_KERNELS) {
+        if (!HexCodec::kernelSupported(kernel))
+            continue;
+        // Lengths straddle the 16- and 32-byte SIMD blocks and their scalar tails.
+        for (size_t length = 0; length <= 130; ++length) {
+            const std::vector<uint8_t> bytes = patternBytes(length);
+            std::string out(length * 2, '?');
+            HexCodec::encode(kernel, bytes.data(), length, out.data());
+            LOGOS_ASSERT_EQ(out, referenceHex(bytes));
+        }
+    }
+}
+
+LOGOS_TEST(hex_codec_decode_round_trips_both_cases) {
+    for (const HexCodec::Kernel kernel : ALL_KERNELS) {
+        if (!HexCodec::kernelSupported(kernel))
+            continue;
+        for (size_t length = 0; length <= 130; ++length) {
+            const std::vector<uint8_t> bytes = patternBytes(length);
+            std::string hex = referenceHex(bytes);
+            std::vector<uint8_t> decoded(length);
+            LOGOS_ASSERT_TRUE(HexCodec::decode(kernel, hex.data(), length, decoded.data()));
+            LOGOS_ASSERT(decoded == bytes);
+
+            for (char& c : hex)
+                c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+            std::fill(decoded.begin(), decoded.end(), 0);
+            LOGOS_ASSERT_TRUE(HexCodec::decode(kernel, hex.data(), length, decoded.data()));
+            LOGOS_ASSERT(decoded == bytes);
+        }
+    }
+}
+
+// One bad char anywhere — inside a SIMD block or in the scalar tail — must be rejected.
+LOGOS_TEST(hex_codec_decode_rejects_non_hex_at_every_position) {
+    static const char badChars[] = {'g', 'G', 'x', ' ', '/', ':', '@', '`', '\x80', '\xff', '\0'};
+    const size_t length = 70;
+    const std::string good = referenceHex(patternBytes(length));
+    std::vector<uint8_t> decoded(length);
+
+    for (const HexCodec::Kernel kernel : ALL_KERNELS) {
+        if (!HexCodec::kernelSupported(kernel))
+            continue;
+        for (size_t pos = 0; pos < good.size(); ++pos) {
+            for (const char bad : badChars) {
+                std::string hex = good;
+                hex[pos] = bad;
+                LOGOS_ASSERT_FALSE(HexCodec::decode(kernel, hex.data(), length, decoded.data()));
+            }
+        }
+    }
+}
+
+LOGOS_TEST(hex_codec_parse_fixed_validates_input) {
+    uint8_t out[16];
+    const std::string digits(32, 'a');
+
+    LOGOS_ASSERT_TRUE(HexCodec::parseFixed(digits, out, 16));
+    LOGOS_ASSERT_EQ(static_cast<int>(out[0]), 0xAA);
+    LOGOS_ASSERT_TRUE(HexCodec::parseFixed(" \t0x" + digits + "\n", out, 16));
+    LOGOS_ASSERT_TRUE(HexCodec::parseFixed("0X" + digits, out, 16));
+
+    LOGOS_ASSERT_FALSE(HexCodec::parseFixed(digits.substr(1), out, 16)); // odd length
+    LOGOS_ASSERT_FALSE(HexCodec::parseFixed(digits + "aa", out, 16));    // too long
+    LOGOS_ASSERT_FALSE(HexCodec::parseFixed("0x 0x" + digits, out, 16)); // prefix stripped once
+    LOGOS_ASSERT_FALSE(HexCodec::parseFixed("   ", out, 16));
+}
+
+LOGOS_TEST(hex_codec_strip_input) {
+    LOGOS_ASSERT_EQ(HexCodec::stripInput("  0xab \r\n"), std::string_view("ab"));
+    LOGOS_ASSERT_EQ(HexCodec::stripInput("0x"), std::string_view(""));
+    LOGOS_ASSERT_EQ(HexCodec::stripInput(" \t"), std::string_view(""));
+    LOGOS_ASSERT_EQ(HexCodec::stripInput("x0ab"), std::string_view("x0ab"));
+}
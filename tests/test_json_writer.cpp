@@ -0,0 +1,147 @@
+// Unit tests for JsonObjectWriter and the LEZCodec result serialisers built on it.
+// Every output is compared byte for byte with nlohmann::json::dump() of the same object,
+// which is what the serialisers produced before the writer replaced the DOM.
+
+#include <logos_test.h>
+#include "json_writer.h"
+#include "lez_codec.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using namespace LEZCodec;
+
+static std::string referenceString(const std::string& value) {
+    return nlohmann::json(value).dump();
+}
+
+static std::string writtenString(const std::string& value) {
+    JsonObjectWriter writer(0);
+    writer.string("k", value);
+    const std::string object = writer.finish();
+    // Strip {"k": ... }
+    return object.substr(5, object.size() - 6);
+}
+
+LOGOS_TEST(json_writer_escapes_every_ascii_char_like_dump) {
+    for (int c = 0; c < 0x80; ++c) {
+        const std::string value = std::string("a") + static_cast<char>(c) + "b";
+        LOGOS_ASSERT_EQ(writtenString(value), referenceString(value));
+    }
+    LOGOS_ASSERT_EQ(writtenString(""), referenceString(""));
+    LOGOS_ASSERT_EQ(writtenString("\"\\\n\x01\x1f"), referenceString("\"\\\n\x01\x1f"));
+}
+
+LOGOS_TEST(json_writer_passes_utf8_through_like_dump) {
+    const std::string value = "caf\xc3\xa9 \xe2\x82\xac \"q\"";
+    LOGOS_ASSERT_EQ(writtenString(value), referenceString(value));
+}
+
+LOGOS_TEST(json_writer_rejects_invalid_utf8_like_dump) {
+    bool threw = false;
+    try {
+        writtenString("bad \xff byte");
+    } catch (const nlohmann::json::exception&) {
+        threw = true;
+    }
+    LOGOS_ASSERT(threw);
+}
+
+LOGOS_TEST(json_writer_keys_sorted_check) {
+    static_assert(JsonObjectWriter::keysSorted({"a", "b", "c"}));
+    static_assert(!JsonObjectWriter::keysSorted({"b", "a"}));
+    static_assert(!JsonObjectWriter::keysSorted({"a", "a"}));
+    LOGOS_ASSERT(JsonObjectWriter::keysSorted({"error", "success", "tx_hash"}));
+}
+
+LOGOS_TEST(transfer_result_json_matches_dom) {
+    char txHash[] = "0xabc\"def";
+    FfiTransferResult result{};
+    result.success = true;
+    result.tx_hash = txHash;
+
+    nlohmann::json expected = nlohmann::json::object();
+    expected["success"] = true;
+    expected["tx_hash"] = std::string(txHash);
+    expected["error"] = "";
+    LOGOS_ASSERT_EQ(transferResultToJson(&result, ""), expected.dump());
+
+    expected["success"] = false;
+    expected["tx_hash"] = "";
+    expected["error"] = "transfer_public: wallet FFI error 1\n";
+    LOGOS_ASSERT_EQ(transferResultToJson(nullptr, "transfer_public: wallet FFI error 1\n"), expected.dump());
+}
+
+LOGOS_TEST(generic_transaction_result_json_matches_dom) {
+    FfiBytes32 secrets[3];
+    for (int i = 0; i < 3; ++i)
+        memset(secrets[i].data, 0x10 * (i + 1) + 1, 32);
+    char txHash[] = "0x1234";
+    FfiTransactionResult result{};
+    result.success = true;
+    result.tx_hash = txHash;
+    result.secrets_data = secrets;
+
+    for (uintptr_t count = 0; count <= 3; ++count) {
+        result.secrets_size = count;
+        nlohmann::json expected = nlohmann::json::object();
+        expected["success"] = true;
+        expected["tx_hash"] = std::string(txHash);
+        std::vector<std::string> hexes;
+        for (uintptr_t i = 0; i < count; ++i)
+            hexes.push_back(bytes32ToHex(secrets[i]));
+        expected["secrets"] = hexes;
+        expected["error"] = "";
+        LOGOS_ASSERT_EQ(genericTransactionResultToJson(&result, ""), expected.dump());
+    }
+
+    nlohmann::json failed = nlohmann::json::object();
+    failed["success"] = false;
+    failed["tx_hash"] = "";
+    failed["secrets"] = std::vector<std::string>();
+    failed["error"] = "boom";
+    LOGOS_ASSERT_EQ(genericTransactionResultToJson(nullptr, "boom"), failed.dump());
+}
+
+LOGOS_TEST(account_json_matches_dom) {
+    std::vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 7);
+
+    for (const size_t length : {size_t{0}, size_t{1}, data.size()}) {
+        FfiAccount account{};
+        for (int i = 0; i < 8; ++i)
+            account.program_owner.data[i] = 0x01020304u * (i + 1);
+        memset(account.balance.data, 0xFE, 16);
+        memset(account.nonce.data, 0x01, 16);
+        account.data = length ? data.data() : nullptr;
+        account.data_len = length;
+
+        nlohmann::json expected = nlohmann::json::object();
+        expected["program_owner"] = bytesToHex(reinterpret_cast<const uint8_t*>(account.program_owner.data), 32);
+        expected["balance"] = bytesToHex(account.balance.data, 16);
+        expected["nonce"] = bytesToHex(account.nonce.data, 16);
+        expected["data"] = length ? bytesToHex(data.data(), length) : "";
+        LOGOS_ASSERT_EQ(ffiAccountToJson(account), expected.dump());
+    }
+}
+
+LOGOS_TEST(private_account_keys_json_matches_dom) {
+    uint8_t viewingKey[33];
+    memset(viewingKey, 0x5A, sizeof(viewingKey));
+    FfiPrivateAccountKeys keys{};
+    memset(keys.nullifier_public_key.data, 0xC3, 32);
+
+    for (const bool withViewingKey : {false, true}) {
+        keys.viewing_public_key = withViewingKey ? viewingKey : nullptr;
+        keys.viewing_public_key_len = withViewingKey ? sizeof(viewingKey) : 0;
+
+        nlohmann::json expected = nlohmann::json::object();
+        expected["nullifier_public_key"] = bytes32ToHex(keys.nullifier_public_key);
+        expected["viewing_public_key"] = withViewingKey ? bytesToHex(viewingKey, sizeof(viewingKey)) : "";
+        LOGOS_ASSERT_EQ(ffiPrivateAccountKeysToJson(keys), expected.dump());
+    }
+}
@@ -3,10 +3,23 @@
 
 #include <logos_test.h>
 #include "lez_core_module.h"
+#include "lez_codec.h"
+#include "mocks/mock_wallet_ffi_behavior.h"
 #include "mocks/mock_wallet_ffi_capture.h"
 
+#include <cctype>
+#include <chrono>
 #include <cstring>
+#include <random>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <nlohmann/json.hpp>
 
@@ -122,6 +135,53 @@ LOGOS_TEST(get_balance_zero) {
     LOGOS_ASSERT_EQ(module.get_balance(VALID_ID, false), std::string("0"));
 }
 
+LOGOS_TEST(get_balances_returns_entry_per_account) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("get_balance_value").returns(500);
+    LEZCoreModule module;
+
+    const LogosList balances = module.get_balances({VALID_ID, VALID_ID_2}, {true, false});
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_get_balance"));
+    LOGOS_ASSERT_EQ(static_cast<int>(balances.size()), 2);
+    LOGOS_ASSERT_EQ(balances[0]["account_id"].get<std::string>(), VALID_ID);
+    LOGOS_ASSERT_TRUE(balances[0]["is_public"].get<bool>());
+    LOGOS_ASSERT_EQ(balances[0]["balance"].get<std::string>(), std::string("500"));
+    LOGOS_ASSERT_TRUE(balances[0]["error"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(balances[1]["is_public"].get<bool>());
+    LOGOS_ASSERT_EQ(balances[1]["balance"].get<std::string>(), std::string("500"));
+}
+
+// A bad id fails only its own entry; the rest of the batch is still answered.
+LOGOS_TEST(get_balances_invalid_hex_fails_only_that_entry) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("get_balance_value").returns(9);
+    LEZCoreModule module;
+
+    const LogosList balances = module.get_balances({"not-hex", VALID_ID}, {true, true});
+    LOGOS_ASSERT_EQ(static_cast<int>(balances.size()), 2);
+    LOGOS_ASSERT_TRUE(balances[0]["balance"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(balances[0]["error"].get<std::string>().empty());
+    LOGOS_ASSERT_EQ(balances[1]["balance"].get<std::string>(), std::string("9"));
+}
+
+LOGOS_TEST(get_balances_ffi_error_reported_per_entry) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_get_balance").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    const LogosList balances = module.get_balances({VALID_ID}, {true});
+    LOGOS_ASSERT_EQ(static_cast<int>(balances.size()), 1);
+    LOGOS_ASSERT_CONTAINS(balances[0]["error"].get<std::string>(), std::string("wallet FFI error"));
+}
+
+LOGOS_TEST(get_balances_length_mismatch_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_balances({VALID_ID, VALID_ID_2}, {true}).size()), 0);
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_get_balance"));
+}
+
 LOGOS_TEST(get_account_public_returns_json) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
@@ -161,6 +221,85 @@ LOGOS_TEST(get_private_account_keys_returns_json) {
     LOGOS_ASSERT_EQ(obj["nullifier_public_key"].get<std::string>(), expected);
 }
 
+// ============================================================================
+// Read cache
+// ============================================================================
+
+LOGOS_TEST(get_balance_repeat_is_served_from_cache) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("get_balance_value").returns(77);
+    MockWalletFfiCapture::getBalanceCalls = 0;
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.get_balance(VALID_ID, true), std::string("77"));
+    // Same id in a different spelling (prefix / case) is the same cache key.
+    LOGOS_ASSERT_EQ(module.get_balance("0x" + std::string(64, 'A'), true), std::string("77"));
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 1);
+
+    // Privacy is part of the key.
+    module.get_balance(VALID_ID, false);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 2);
+}
+
+LOGOS_TEST(get_balance_failure_is_not_cached) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_get_balance").returns(static_cast<int>(INTERNAL_ERROR));
+    MockWalletFfiCapture::getBalanceCalls = 0;
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.get_balance(VALID_ID, true).empty());
+    LOGOS_ASSERT_TRUE(module.get_balance(VALID_ID, true).empty());
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 2);
+}
+
+LOGOS_TEST(read_cache_invalidated_by_transfer_touching_account) {
+    auto t = LogosTestContext("logos_execution_zone");
+    MockWalletFfiCapture::getBalanceCalls = 0;
+    MockWalletFfiCapture::getAccountPublicCalls = 0;
+    LEZCoreModule module;
+
+    module.get_balance(VALID_ID, true);
+    module.get_account_public(VALID_ID_2);
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+    module.get_balance(VALID_ID, true);
+    module.get_account_public(VALID_ID_2);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 2);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getAccountPublicCalls, 2);
+}
+
+LOGOS_TEST(read_cache_kept_for_untouched_account) {
+    auto t = LogosTestContext("logos_execution_zone");
+    MockWalletFfiCapture::getVaultBalanceCalls = 0;
+    LEZCoreModule module;
+
+    module.get_vault_balance(VALID_ID);
+    module.vault_claim(VALID_ID_2, VALID_U128);
+    module.get_vault_balance(VALID_ID);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getVaultBalanceCalls, 1);
+}
+
+LOGOS_TEST(read_cache_cleared_when_synced_block_moves) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("last_synced_block_value").returns(10);
+    MockWalletFfiCapture::getBalanceCalls = 0;
+    LEZCoreModule module;
+
+    module.get_last_synced_block();
+    module.get_balance(VALID_ID, true);
+    module.get_last_synced_block(); // unchanged -> still cached
+    module.get_balance(VALID_ID, true);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 1);
+
+    t.mockCFunction("last_synced_block_value").returns(11);
+    module.get_last_synced_block();
+    module.get_balance(VALID_ID, true);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 2);
+
+    module.sync_to_block(20);
+    module.get_balance(VALID_ID, true);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 3);
+}
+
 // ============================================================================
 // Account encoding
 // ============================================================================
@@ -461,247 +600,1723 @@ LOGOS_TEST(register_private_account_success_json) {
 }
 
 // ============================================================================
-// Bridge (L1 Bedrock <-> L2)
+// Built-in programs
 // ============================================================================
 
-LOGOS_TEST(bridge_withdraw_success_json) {
+LOGOS_TEST(builtin_elf_is_fetched_once_and_shared) {
     auto t = LogosTestContext("logos_execution_zone");
+    MockWalletFfiCapture::builtinElfFetchCalls = 0;
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.bridge_withdraw(VALID_ID, VALID_ID_2, 100));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_bridge_withdraw"));
-    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
-    LOGOS_ASSERT_EQ(obj["tx_hash"].get<std::string>(), std::string("0xmocktxhash"));
-    LOGOS_ASSERT_TRUE(obj["error"].get<std::string>().empty());
+    const std::vector<uint8_t> first = module.token_elf();
+    const std::vector<uint8_t> second = module.token_elf();
+
+    LOGOS_ASSERT_EQ(first.size(), static_cast<size_t>(100));
+    LOGOS_ASSERT(first == second);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::builtinElfFetchCalls, 1);
 }
 
-LOGOS_TEST(bridge_withdraw_invalid_hex_error_json) {
+LOGOS_TEST(builtin_elf_fetch_failure_is_retried) {
     auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_amm_elf").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.bridge_withdraw("bad", VALID_ID_2, 100));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_bridge_withdraw"));
+    LOGOS_ASSERT(module.amm_elf().empty());
+    t.mockCFunction("wallet_ffi_amm_elf").returns(static_cast<int>(SUCCESS));
+    LOGOS_ASSERT_EQ(module.amm_elf().size(), static_cast<size_t>(100));
 }
 
-LOGOS_TEST(bridge_withdraw_ffi_error_json) {
+#ifdef __linux__
+LOGOS_TEST(builtin_elf_fd_is_a_sealed_copy) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_bridge_withdraw").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.bridge_withdraw(VALID_ID, VALID_ID_2, 100));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
-}
+    const int fd = static_cast<int>(module.builtin_elf_fd("ata"));
+    LOGOS_ASSERT(fd >= 0);
+    struct stat st{};
+    LOGOS_ASSERT_EQ(fstat(fd, &st), 0);
+    LOGOS_ASSERT_EQ(st.st_size, static_cast<off_t>(100));
+    uint8_t byte = 0;
+    LOGOS_ASSERT_EQ(pread(fd, &byte, 1, 99), static_cast<ssize_t>(1));
+    LOGOS_ASSERT_EQ(byte, static_cast<uint8_t>(0xAA));
+    LOGOS_ASSERT_EQ(pwrite(fd, &byte, 1, 0), static_cast<ssize_t>(-1));
+    close(fd);
 
-// ============================================================================
-// Vault claiming
-// ============================================================================
+    LOGOS_ASSERT_EQ(module.builtin_elf_fd("no_such_program"), static_cast<int64_t>(-1));
+}
+#endif
 
-LOGOS_TEST(get_vault_balance_invalid_hex_returns_empty) {
+LOGOS_TEST(send_builtin_private_transaction_submits_shared_buffers) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    LOGOS_ASSERT_TRUE(module.get_vault_balance("not-hex").empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_get_vault_balance"));
+    const nlohmann::json first = parseObject(module.send_builtin_private_transaction({VALID_ID}, {1, 2}, "token", {"amm"}));
+    LOGOS_ASSERT_TRUE(first["success"].get<bool>());
+    const uint8_t* elf = MockWalletFfiCapture::lastPrivateProgramElf;
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastPrivateProgramDependencies, static_cast<uintptr_t>(1));
+
+    module.send_builtin_private_transaction({VALID_ID}, {1, 2}, "token", {});
+    LOGOS_ASSERT(MockWalletFfiCapture::lastPrivateProgramElf == elf);
 }
 
-LOGOS_TEST(get_vault_balance_returns_decimal_string) {
+LOGOS_TEST(send_builtin_private_transaction_unknown_program_error_json) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("get_vault_balance_value").returns(42);
     LEZCoreModule module;
 
-    const std::string balance = module.get_vault_balance(VALID_ID);
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_get_vault_balance"));
-    LOGOS_ASSERT_EQ(balance, std::string("42"));
+    const nlohmann::json obj = parseObject(module.send_builtin_private_transaction({VALID_ID}, {1}, "token", {"nope"}));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_send_generic_private_transaction"));
 }
 
-LOGOS_TEST(get_vault_balance_ffi_error_returns_empty) {
+// ============================================================================
+// Program registry
+// ============================================================================
+
+static std::vector<uint8_t> bytesOf(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+LOGOS_TEST(register_program_returns_sha256_handle) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_get_vault_balance").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    LOGOS_ASSERT_TRUE(module.get_vault_balance(VALID_ID).empty());
+    LOGOS_ASSERT_EQ(module.register_program(bytesOf("abc")),
+                    std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    // Two-block message (padding spills into a second block).
+    LOGOS_ASSERT_EQ(module.register_program(bytesOf("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+                    std::string("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    LOGOS_ASSERT_EQ(module.register_program(bytesOf("abc")), module.register_program(bytesOf("abc")));
+    LOGOS_ASSERT_EQ(module.register_program({}), std::string());
 }
 
-LOGOS_TEST(vault_claim_success_json) {
+LOGOS_TEST(send_registered_private_transaction_submits_by_handle) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, VALID_U128));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_vault_claim"));
-    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
-    LOGOS_ASSERT_EQ(obj["tx_hash"].get<std::string>(), std::string("0xmocktxhash"));
-    LOGOS_ASSERT_TRUE(obj["error"].get<std::string>().empty());
+    const std::string program = module.register_program(std::vector<uint8_t>(1000, 0x42));
+    const std::string dependency = module.register_builtin_program("authenticated_transfer");
+    LOGOS_ASSERT_FALSE(dependency.empty());
+
+    const nlohmann::json first = parseObject(module.send_registered_private_transaction({VALID_ID}, {7}, program, {dependency}));
+    LOGOS_ASSERT_TRUE(first["success"].get<bool>());
+    const uint8_t* elf = MockWalletFfiCapture::lastPrivateProgramElf;
+    LOGOS_ASSERT(elf != nullptr && elf[999] == 0x42);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastPrivateProgramDependencies, static_cast<uintptr_t>(1));
+
+    // Submitted in place: the same bytes every time, whatever case the handle is spelled in.
+    std::string upper = program;
+    for (char& c : upper)
+        c = static_cast<char>(toupper(c));
+    module.send_registered_private_transaction({VALID_ID}, {7}, upper, {dependency});
+    LOGOS_ASSERT(MockWalletFfiCapture::lastPrivateProgramElf == elf);
+
+    LOGOS_ASSERT(module.unregister_program(program));
+    LOGOS_ASSERT_FALSE(module.unregister_program(program));
+    const nlohmann::json gone = parseObject(module.send_registered_private_transaction({VALID_ID}, {7}, program, {dependency}));
+    LOGOS_ASSERT_FALSE(gone["success"].get<bool>());
 }
 
-LOGOS_TEST(vault_claim_invalid_hex_error_json) {
+LOGOS_TEST(send_registered_private_transaction_unknown_handle_error_json) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim("bad", VALID_U128));
+    const nlohmann::json obj = parseObject(module.send_registered_private_transaction({VALID_ID}, {1}, std::string(64, 'f'), {}));
     LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_vault_claim"));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_send_generic_private_transaction"));
 }
 
-LOGOS_TEST(vault_claim_invalid_amount_error_json) {
+// ============================================================================
+// Binary API
+// ============================================================================
+
+LOGOS_TEST(get_balance_bin_returns_le16_and_shares_cache_invalidation) {
     auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("get_balance_value").returns(0x01020304);
+    MockWalletFfiCapture::getBalanceCalls = 0;
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, "ff"));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), std::string("amount"));
+    const std::vector<uint8_t> id(32, 0x11);
+    const std::vector<uint8_t> balance = module.get_balance_bin(id, true);
+    LOGOS_ASSERT_EQ(balance.size(), static_cast<size_t>(16));
+    LOGOS_ASSERT_EQ(balance[0], static_cast<uint8_t>(0x04));
+    LOGOS_ASSERT_EQ(balance[3], static_cast<uint8_t>(0x01));
+    LOGOS_ASSERT_EQ(balance[15], static_cast<uint8_t>(0));
+
+    LOGOS_ASSERT(module.get_balance_bin(id, true) == balance);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 1);
+    // A transfer from the account drops the binary entry too.
+    module.transfer_public_bin(id, std::vector<uint8_t>(32, 0x22), std::vector<uint8_t>(16, 0));
+    module.get_balance_bin(id, true);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::getBalanceCalls, 2);
 }
 
-LOGOS_TEST(vault_claim_ffi_error_json) {
+LOGOS_TEST(get_balance_bin_wrong_size_id_fails_without_ffi) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_vault_claim").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, VALID_U128));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+    LOGOS_ASSERT(module.get_balance_bin(std::vector<uint8_t>(31, 0x11), true).empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_get_balance"));
 }
 
-LOGOS_TEST(vault_claim_private_success_json) {
+LOGOS_TEST(get_account_public_bin_record_layout) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, VALID_U128));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_vault_claim_private"));
-    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    const std::vector<uint8_t> record = module.get_account_public_bin(std::vector<uint8_t>(32, 0x11));
+    LOGOS_ASSERT_EQ(record.size(), static_cast<size_t>(68));
+    LOGOS_ASSERT_EQ(record[0], static_cast<uint8_t>(0xAA));  // program_owner
+    LOGOS_ASSERT_EQ(record[32], static_cast<uint8_t>(0x07)); // balance
+    LOGOS_ASSERT_EQ(record[48], static_cast<uint8_t>(0x01)); // nonce
+    LOGOS_ASSERT_EQ(record[64], static_cast<uint8_t>(0));    // data_len
 }
 
-LOGOS_TEST(vault_claim_private_invalid_hex_error_json) {
+LOGOS_TEST(transfer_public_bin_success_record) {
     auto t = LogosTestContext("logos_execution_zone");
+    static const std::string txHash = "0x" + std::string(62, '0') + "ab";
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim_private("bad", VALID_U128));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_vault_claim_private"));
+    const std::vector<uint8_t> record =
+        module.transfer_public_bin(std::vector<uint8_t>(32, 0x11), std::vector<uint8_t>(32, 0x22), std::vector<uint8_t>(16, 1));
+    LOGOS_ASSERT_EQ(record.size(), static_cast<size_t>(37));
+    LOGOS_ASSERT_EQ(record[0], static_cast<uint8_t>(1));
+    LOGOS_ASSERT_EQ(record[1], static_cast<uint8_t>(0));
+    LOGOS_ASSERT_EQ(record[36], static_cast<uint8_t>(0xAB));
 }
 
-LOGOS_TEST(vault_claim_private_invalid_amount_error_json) {
+LOGOS_TEST(transfer_bin_errors_are_reported_in_the_record) {
     auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_transfer_private").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, "ff"));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), std::string("amount"));
+    const std::vector<uint8_t> badAmount =
+        module.transfer_public_bin(std::vector<uint8_t>(32, 0x11), std::vector<uint8_t>(32, 0x22), std::vector<uint8_t>(15, 1));
+    LOGOS_ASSERT_EQ(badAmount[0], static_cast<uint8_t>(0));
+    LOGOS_ASSERT_EQ(badAmount[1], static_cast<uint8_t>(INVALID_INPUT));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_transfer_public"));
+
+    const std::vector<uint8_t> failed = module.transfer_private_bin(
+        std::vector<uint8_t>(32, 0x11), std::vector<uint8_t>(32, 0x33), std::vector<uint8_t>(33, 0x02), std::vector<uint8_t>(16, 1));
+    LOGOS_ASSERT_EQ(failed[0], static_cast<uint8_t>(0));
+    LOGOS_ASSERT_EQ(failed[1], static_cast<uint8_t>(INTERNAL_ERROR));
 }
 
-LOGOS_TEST(vault_claim_private_ffi_error_json) {
+LOGOS_TEST(poll_transaction_status_bin_checks_hash_size) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_vault_claim_private").returns(static_cast<int>(INTERNAL_ERROR));
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, VALID_U128));
-    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
-    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(module.poll_transaction_status_bin(std::vector<uint8_t>(16, 0x01)));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_poll_transaction_status"));
+    module.poll_transaction_status_bin(std::vector<uint8_t>(32, 0x01));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_poll_transaction_status"));
 }
 
 // ============================================================================
-// Pinata claiming
+// Recipient book
 // ============================================================================
 
-LOGOS_TEST(claim_pinata_invalid_hex_returns_empty) {
+LOGOS_TEST(register_recipient_returns_stable_handle) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    LOGOS_ASSERT_TRUE(module.claim_pinata("bad", VALID_ID_2, VALID_U128).empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata"));
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}, {"viewing_public_key", std::string(66, 'b')}}.dump();
+    const std::string handle = module.register_recipient(keysJson);
+    LOGOS_ASSERT_EQ(handle.size(), static_cast<size_t>(64));
+    LOGOS_ASSERT_EQ(module.register_recipient(keysJson), handle);
+
+    const std::string other = nlohmann::json{{"nullifier_public_key", VALID_ID_2}, {"viewing_public_key", std::string(66, 'b')}}.dump();
+    LOGOS_ASSERT_NE(module.register_recipient(other), handle);
+    LOGOS_ASSERT_EQ(module.register_recipient("{\"viewing_public_key\":\"bb\"}"), std::string());
 }
 
-LOGOS_TEST(claim_pinata_invalid_solution_returns_empty) {
+LOGOS_TEST(transfer_private_to_reuses_registered_keys) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    LOGOS_ASSERT_TRUE(module.claim_pinata(VALID_ID, VALID_ID_2, "ab").empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata"));
+    const std::string handle = module.register_recipient(
+        nlohmann::json{{"nullifier_public_key", VALID_ID}, {"viewing_public_key", std::string(66, 'b')}}.dump());
+
+    LOGOS_ASSERT_TRUE(parseObject(module.transfer_private_to(VALID_ID_2, handle, VALID_U128))["success"].get<bool>());
+    const FfiPrivateAccountKeys* first = MockWalletFfiCapture::lastTransferPrivateKeys;
+    uint8_t firstIdentifier[16];
+    memcpy(firstIdentifier, MockWalletFfiCapture::lastTransferPrivateIdentifier, sizeof(firstIdentifier));
+    LOGOS_ASSERT_EQ(first->viewing_public_key_len, static_cast<uintptr_t>(33));
+    LOGOS_ASSERT_EQ(first->viewing_public_key[0], static_cast<uint8_t>(0xbb));
+
+    LOGOS_ASSERT_TRUE(parseObject(module.transfer_private_to(VALID_ID_2, handle, VALID_U128))["success"].get<bool>());
+    LOGOS_ASSERT(MockWalletFfiCapture::lastTransferPrivateKeys == first);
+    // Without a registered identifier each transfer still gets a fresh one.
+    LOGOS_ASSERT_FALSE(memcmp(firstIdentifier, MockWalletFfiCapture::lastTransferPrivateIdentifier, 16) == 0);
 }
 
-LOGOS_TEST(claim_pinata_success_json) {
+LOGOS_TEST(transfer_shielded_to_forwards_registered_identifier) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    const nlohmann::json obj = parseObject(module.claim_pinata(VALID_ID, VALID_ID_2, VALID_U128));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_claim_pinata"));
-    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    const std::string handle = module.register_recipient(
+        nlohmann::json{{"nullifier_public_key", VALID_ID}, {"identifier", std::string(32, '5')}}.dump());
+    LOGOS_ASSERT_TRUE(parseObject(module.transfer_shielded_to(VALID_ID_2, handle, VALID_U128))["success"].get<bool>());
+
+    uint8_t expected[16];
+    memset(expected, 0x55, sizeof(expected));
+    LOGOS_ASSERT(memcmp(MockWalletFfiCapture::lastTransferShieldedIdentifier, expected, sizeof(expected)) == 0);
 }
 
-LOGOS_TEST(claim_pinata_already_initialized_invalid_siblings_returns_empty) {
+LOGOS_TEST(transfer_to_unknown_or_unregistered_recipient_fails_without_ffi) {
     auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    // siblings json is not an array -> parse failure.
-    const std::string result = module.claim_pinata_private_owned_already_initialized(
-        VALID_ID, VALID_ID_2, VALID_U128, 0, "not-an-array");
-    LOGOS_ASSERT_TRUE(result.empty());
-    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata_private_owned_already_initialized"));
+    const std::string handle = module.register_recipient(nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump());
+    LOGOS_ASSERT_TRUE(module.unregister_recipient(handle));
+    LOGOS_ASSERT_FALSE(module.unregister_recipient(handle));
+
+    LOGOS_ASSERT_FALSE(parseObject(module.transfer_private_to(VALID_ID_2, handle, VALID_U128))["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(parseObject(module.transfer_shielded_to(VALID_ID_2, std::string(64, 'f'), VALID_U128))["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_transfer_private"));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_transfer_shielded"));
 }
 
-LOGOS_TEST(claim_pinata_already_initialized_success_json) {
+// ============================================================================
+// Batched payouts
+// ============================================================================
+
+static const std::string PROGRAM_ID = std::string(64, 'e');
+
+LOGOS_TEST(payout_public_merges_recipients_and_reports_each_entry) {
     auto t = LogosTestContext("logos_execution_zone");
+    static const std::string txHash = std::string(64, '9');
+    t.mockCFunction("transaction_tx_hash").returns(txHash.c_str());
     LEZCoreModule module;
+    MockWalletFfiCapture::sendGenericPublicCalls = 0;
+    MockWalletFfiCapture::resolvePublicAccountCalls = 0;
+
+    const std::string third = txHash;
+    const nlohmann::json payouts = nlohmann::json::array({
+        {{"to", VALID_ID_2}, {"amount", "01000000000000000000000000000000"}},
+        {{"to", third}, {"amount", "05000000000000000000000000000000"}},
+        {{"to", VALID_ID_2}, {"amount", "02000000000000000000000000000000"}},
+    });
+    const nlohmann::json obj = parseObject(module.payout_public(VALID_ID, payouts.dump(), PROGRAM_ID));
 
-    const std::string siblings = std::string("[\"") + std::string(64, 'a') + std::string("\",\"") + std::string(64, 'b') + std::string("\"]");
-    const nlohmann::json obj = parseObject(module.claim_pinata_private_owned_already_initialized(
-        VALID_ID, VALID_ID_2, VALID_U128, 1, siblings));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_claim_pinata_private_owned_already_initialized"));
     LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT_EQ(obj["transactions"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::sendGenericPublicCalls.load(), 2);
+    // Sender once, then each distinct recipient.
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::resolvePublicAccountCalls.load(), 3);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastGenericPublicAccounts, static_cast<uintptr_t>(2));
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastGenericPublicInstruction[0], static_cast<uint32_t>(5));
+
+    const nlohmann::json& results = obj["results"];
+    LOGOS_ASSERT_EQ(results.size(), static_cast<size_t>(3));
+    LOGOS_ASSERT_EQ(results[0]["to"].get<std::string>(), VALID_ID_2);
+    LOGOS_ASSERT_EQ(results[1]["to"].get<std::string>(), third);
+    for (const auto& result : results) {
+        LOGOS_ASSERT_TRUE(result["success"].get<bool>());
+        LOGOS_ASSERT_EQ(result["tx_hash"].get<std::string>(), txHash);
+    }
+    // Both entries for VALID_ID_2 went out as one transfer of 3.
+    LOGOS_ASSERT_EQ(results[0]["amount"].get<std::string>(), std::string("01000000000000000000000000000000"));
+    LOGOS_ASSERT_EQ(results[0]["transfer_amount"].get<std::string>(), std::string("03000000000000000000000000000000"));
+    LOGOS_ASSERT_EQ(results[0]["merged_entries"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(results[2]["transfer_amount"].get<std::string>(), std::string("03000000000000000000000000000000"));
+    LOGOS_ASSERT_EQ(results[1]["transfer_amount"].get<std::string>(), std::string("05000000000000000000000000000000"));
+    LOGOS_ASSERT_EQ(results[1]["merged_entries"].get<int>(), 1);
+}
+
+LOGOS_TEST(payout_public_rejects_malformed_batch_without_sending) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const std::string good = nlohmann::json::array({{{"to", VALID_ID_2}, {"amount", VALID_U128}}}).dump();
+    const std::string badEntry = nlohmann::json::array({{{"to", VALID_ID_2}, {"amount", VALID_U128}}, {{"to", "zz"}, {"amount", VALID_U128}}}).dump();
+    const std::string overflow = nlohmann::json::array({{{"to", VALID_ID_2}, {"amount", std::string(32, 'f')}},
+                                                        {{"to", VALID_ID_2}, {"amount", VALID_U128}}}).dump();
+
+    for (const nlohmann::json& obj : {parseObject(module.payout_public(VALID_ID, badEntry, PROGRAM_ID)),
+                                      parseObject(module.payout_public(VALID_ID, overflow, PROGRAM_ID)),
+                                      parseObject(module.payout_public(VALID_ID, "[]", PROGRAM_ID)),
+                                      parseObject(module.payout_public(VALID_ID, good, "nope")),
+                                      parseObject(module.payout_public("bad", good, PROGRAM_ID))}) {
+        LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+        LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+        LOGOS_ASSERT_EQ(obj["transactions"].get<int>(), 0);
+    }
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_send_generic_public_transaction"));
+}
+
+LOGOS_TEST(payout_public_reports_failed_transfers) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_send_generic_public_transaction").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    const std::string payouts = nlohmann::json::array({{{"to", VALID_ID_2}, {"amount", VALID_U128}}}).dump();
+    const nlohmann::json obj = parseObject(module.payout_public(VALID_ID, payouts, PROGRAM_ID));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    // Rejected by wallet_ffi, so nothing was submitted.
+    LOGOS_ASSERT_EQ(obj["transactions"].get<int>(), 0);
+    LOGOS_ASSERT_FALSE(obj["results"][0]["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["results"][0]["error"].get<std::string>().empty());
 }
 
 // ============================================================================
-// Wallet lifecycle
+// Proving
 // ============================================================================
 
-LOGOS_TEST(create_new_success_then_double_open_fails) {
+LOGOS_TEST(get_proving_stats_reports_limits_and_admissions) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_create_new").returns(1); // non-null handle
     LEZCoreModule module;
 
-    LOGOS_ASSERT_TRUE(!module.create_new("/cfg", "/store", "/stats", "pw").empty());
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_create_new"));
-    // Second attempt: already open.
-    LOGOS_ASSERT_EQ(module.create_new("/cfg", "/store", "/stats", "pw"), "");
+    LOGOS_ASSERT_TRUE(module.set_proving_limits(3, 10));
+    LOGOS_ASSERT_FALSE(module.set_proving_limits(3, -1));
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump();
+    module.transfer_private(VALID_ID_2, keysJson, VALID_U128);
+    module.transfer_deshielded(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+
+    const nlohmann::json stats = parseObject(module.get_proving_stats());
+    LOGOS_ASSERT_EQ(stats["max_concurrent"].get<int>(), 3);
+    LOGOS_ASSERT_EQ(stats["max_queued"].get<int>(), 10);
+    // Public transfers prove nothing and bypass the scheduler.
+    LOGOS_ASSERT_EQ(stats["admitted"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(stats["running"].get<int>(), 0);
+    LOGOS_ASSERT_CONTAINS(module.get_metrics(), "proving_wait");
 }
 
-LOGOS_TEST(create_new_null_handle_returns_internal_error) {
+LOGOS_TEST(private_transfer_fails_fast_when_proving_queue_full) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_create_new").returns(0); // null handle
-    LEZCoreModule module;
+    MockWalletFfiBehavior::reset();
+    MockWalletFfiBehavior::FunctionBehavior slow;
+    slow.latency = MockWalletFfiBehavior::Latency::fixed(std::chrono::milliseconds(200));
+    MockWalletFfiBehavior::configure("wallet_ffi_transfer_private", slow);
+    LEZCoreModule module;
+    module.set_proving_limits(1, 1);
+
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump();
+    // The module's own wallet queues its proofs on its own scheduler.
+    const auto waitForStat = [&module](const char* key) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (parseObject(module.get_proving_stats())["own_wallet"][key].get<int>() < 1 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+    std::thread running([&] { module.transfer_private(VALID_ID_2, keysJson, VALID_U128); });
+    waitForStat("running");
+    std::thread queued([&] { module.transfer_private(VALID_ID_2, keysJson, VALID_U128); });
+    waitForStat("queued");
+
+    const nlohmann::json obj = parseObject(module.transfer_private(VALID_ID_2, keysJson, VALID_U128));
+    running.join();
+    queued.join();
+    MockWalletFfiBehavior::reset();
 
-    LOGOS_ASSERT_EQ(module.create_new("/cfg", "/store", "/stats", "pw"), "");
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), "proving queue full");
+    LOGOS_ASSERT_EQ(parseObject(module.get_proving_stats())["own_wallet"]["rejected"].get<int>(), 1);
 }
 
-LOGOS_TEST(open_success) {
+LOGOS_TEST(interactive_proof_overtakes_queued_async_jobs_by_default) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    const std::string txHash(64, 'c');
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
+    MockWalletFfiBehavior::reset();
+    MockWalletFfiBehavior::FunctionBehavior slow;
+    slow.latency = MockWalletFfiBehavior::Latency::fixed(std::chrono::milliseconds(100));
+    MockWalletFfiBehavior::configure("wallet_ffi_transfer_private", slow);
+    LEZCoreModule module;
+    module.set_account_history(true);
+    module.open("/cfg", "/store", "/stats");
+
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump();
+    const auto amount = [](const char digit) { return std::string(1, '0') + digit + std::string(30, '0'); };
+    std::vector<int64_t> tickets;
+    for (const char digit : {'1', '2', '3'})
+        tickets.push_back(module.transfer_private_async(VALID_ID_2, keysJson, amount(digit)));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (parseObject(module.get_proving_stats())["running"].get<int>() < 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // Only the first job proves; the caller goes next, ahead of the two still queued.
+    module.transfer_private(VALID_ID_2, keysJson, amount('9'));
+    for (const int64_t ticket : tickets)
+        module.await_async_result(ticket, 5000);
+    MockWalletFfiBehavior::reset();
+
+    const nlohmann::json page = parseObject(module.get_account_history(VALID_ID_2, 0, 10));
+    std::string order;
+    for (const nlohmann::json& record : page["records"])
+        order.insert(order.begin(), record["amount"].get<std::string>()[1]);
+    LOGOS_ASSERT_EQ(order, std::string("1923"));
+    const nlohmann::json stats = parseObject(module.get_proving_stats());
+    LOGOS_ASSERT_EQ(stats["max_concurrent"].get<size_t>(), std::max<size_t>(1, std::thread::hardware_concurrency()));
+    LOGOS_ASSERT_EQ(stats["own_wallet"]["max_concurrent"].get<int>(), 1);
+}
+
+LOGOS_TEST(managed_wallet_proofs_run_in_parallel) {
     auto t = LogosTestContext("logos_execution_zone");
     t.mockCFunction("wallet_ffi_open").returns(1);
+    MockWalletFfiBehavior::reset();
+    MockWalletFfiBehavior::FunctionBehavior slow;
+    slow.latency = MockWalletFfiBehavior::Latency::fixed(std::chrono::milliseconds(200));
+    MockWalletFfiBehavior::configure("wallet_ffi_transfer_deshielded", slow);
+    LEZCoreModule module;
+    // Two slots, whatever this machine's core count.
+    module.set_proving_limits(2, 0);
+    module.open_managed_wallet("alice", "/cfg", "/alice", "/stats");
+    module.open_managed_wallet("bob", "/cfg", "/bob", "/stats");
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread alice([&] { module.managed_transfer_deshielded("alice", VALID_ID, VALID_ID_2, VALID_U128); });
+    std::thread bob([&] { module.managed_transfer_deshielded("bob", VALID_ID, VALID_ID_2, VALID_U128); });
+    alice.join();
+    bob.join();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    MockWalletFfiBehavior::reset();
+
+    // Each wallet has its own lock, and the own wallet's one-slot queue is not in the way.
+    LOGOS_ASSERT(elapsed < std::chrono::milliseconds(380));
+    const nlohmann::json stats = parseObject(module.get_proving_stats());
+    LOGOS_ASSERT_EQ(stats["admitted"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(stats["own_wallet"]["admitted"].get<int>(), 0);
+}
+
+// ============================================================================
+// Recipient identifiers
+// ============================================================================
+
+LOGOS_TEST(random_identifiers_returns_distinct_hex_identifiers) {
+    auto t = LogosTestContext("logos_execution_zone");
     LEZCoreModule module;
 
-    LOGOS_ASSERT_EQ(module.open("/cfg", "/store", "/stats"), static_cast<int64_t>(SUCCESS));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_open"));
+    const nlohmann::json ids = nlohmann::json::parse(module.random_identifiers(1000));
+    LOGOS_ASSERT(ids.is_array());
+    LOGOS_ASSERT_EQ(ids.size(), static_cast<size_t>(1000));
+    std::set<std::string> distinct;
+    for (const auto& id : ids) {
+        const std::string hex = id.get<std::string>();
+        LOGOS_ASSERT_EQ(hex.size(), static_cast<size_t>(32));
+        FfiU128 parsed{};
+        LOGOS_ASSERT(LEZCodec::jsonExtractIdentifier(nlohmann::json{{"identifier", hex}}.dump(), &parsed));
+        distinct.insert(hex);
+    }
+    LOGOS_ASSERT_EQ(distinct.size(), ids.size());
 }
 
-LOGOS_TEST(save_forwards_return_code) {
+LOGOS_TEST(random_identifiers_rejects_bad_count) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_save").returns(static_cast<int>(SUCCESS));
     LEZCoreModule module;
 
-    LOGOS_ASSERT_EQ(module.save(), static_cast<int64_t>(SUCCESS));
-    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+    LOGOS_ASSERT_EQ(module.random_identifiers(0), std::string("[]"));
+    LOGOS_ASSERT_EQ(module.random_identifiers(-5), std::string("[]"));
+    LOGOS_ASSERT_EQ(module.random_identifiers((int64_t{1} << 20) + 1), std::string("[]"));
+    LOGOS_ASSERT(module.random_identifiers_bin(0).empty());
+}
+
+LOGOS_TEST(random_identifiers_bin_returns_raw_identifiers) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const std::vector<uint8_t> a = module.random_identifiers_bin(20000);
+    const std::vector<uint8_t> b = module.random_identifiers_bin(20000);
+    LOGOS_ASSERT_EQ(a.size(), static_cast<size_t>(20000 * 16));
+    LOGOS_ASSERT_NE(a, b);
 }
 
 // ============================================================================
-// Configuration
+// Decimal amounts
 // ============================================================================
 
-LOGOS_TEST(get_sequencer_addr_returns_string) {
+static std::string referenceDecimal(__uint128_t v) {
+    if (v == 0)
+        return "0";
+    std::string digits;
+    while (v) {
+        digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(v % 10)));
+        v /= 10;
+    }
+    return digits;
+}
+
+static std::string formatU128(const __uint128_t v) {
+    uint8_t le[16];
+    for (int i = 0; i < 16; ++i)
+        le[i] = static_cast<uint8_t>(v >> (i * 8));
+    return LEZCodec::balanceLe16ToDecimalString(le);
+}
+
+LOGOS_TEST(decimal_format_and_parse_round_trip) {
+    const __uint128_t ten19 = 10000000000000000000ull;
+    const __uint128_t max = ~static_cast<__uint128_t>(0);
+    std::vector<__uint128_t> values = {0, 9, 10, 99, 100, ten19 - 1, ten19, ten19 + 1,
+                                       static_cast<__uint128_t>(UINT64_MAX), static_cast<__uint128_t>(UINT64_MAX) + 1,
+                                       ten19 * ten19 - 1, ten19 * ten19, ten19 * ten19 * 10 - 1, ten19 * ten19 * 10, max - 1, max};
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 1000; ++i) {
+        const __uint128_t v = (static_cast<__uint128_t>(rng()) << 64) | rng();
+        values.push_back(v >> (rng() % 128));
+    }
+
+    for (const __uint128_t v : values) {
+        const std::string decimal = formatU128(v);
+        LOGOS_ASSERT_EQ(decimal, referenceDecimal(v));
+        uint8_t parsed[16];
+        LOGOS_ASSERT(LEZCodec::decimalToU128(decimal, &parsed));
+        __uint128_t back = 0;
+        for (int i = 15; i >= 0; --i)
+            back = (back << 8) | parsed[i];
+        LOGOS_ASSERT(back == v);
+    }
+}
+
+LOGOS_TEST(decimal_parse_is_strict) {
+    uint8_t out[16];
+    for (const char* bad : {"", "  ", "-1", "+1", "1.0", "1_000", "1e3", "0x10", "12a",
+                            "340282366920938463463374607431768211456", "999999999999999999999999999999999999999"}) {
+        LOGOS_ASSERT_FALSE(LEZCodec::decimalToU128(bad, &out));
+    }
+    LOGOS_ASSERT(LEZCodec::decimalToU128(" 0000000000000000000000000000000000000000042\n", &out));
+    LOGOS_ASSERT_EQ(out[0], static_cast<uint8_t>(42));
+    LOGOS_ASSERT(LEZCodec::decimalToU128("340282366920938463463374607431768211455", &out));
+    LOGOS_ASSERT_EQ(out[15], static_cast<uint8_t>(0xFF));
+}
+
+LOGOS_TEST(transfer_public_decimal_submits) {
     auto t = LogosTestContext("logos_execution_zone");
-    t.mockCFunction("wallet_ffi_get_sequencer_addr").returns("10.0.0.1:9000");
     LEZCoreModule module;
 
-    LOGOS_ASSERT_EQ(module.get_sequencer_addr(), std::string("10.0.0.1:9000"));
+    const nlohmann::json obj = parseObject(module.transfer_public_decimal(VALID_ID, VALID_ID_2, "1500000"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_transfer_public"));
+    // Counted once, under its own name: the hex method is not entered on the way.
+    const nlohmann::json metrics = parseObject(module.get_metrics());
+    LOGOS_ASSERT_EQ(static_cast<int>(metrics["methods"].size()), 1);
+    LOGOS_ASSERT_EQ(metrics["methods"][0]["method"].get<std::string>(), std::string("transfer_public_decimal"));
+}
+
+LOGOS_TEST(vault_claim_decimal_overflow_rejected_without_ffi) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim_decimal(VALID_ID, "340282366920938463463374607431768211456"));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_vault_claim"));
+}
+
+// ============================================================================
+// Bridge (L1 Bedrock <-> L2)
+// ============================================================================
+
+LOGOS_TEST(bridge_withdraw_success_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.bridge_withdraw(VALID_ID, VALID_ID_2, 100));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_bridge_withdraw"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT_EQ(obj["tx_hash"].get<std::string>(), std::string("0xmocktxhash"));
+    LOGOS_ASSERT_TRUE(obj["error"].get<std::string>().empty());
+}
+
+LOGOS_TEST(bridge_withdraw_invalid_hex_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.bridge_withdraw("bad", VALID_ID_2, 100));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_bridge_withdraw"));
+}
+
+LOGOS_TEST(bridge_withdraw_ffi_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_bridge_withdraw").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.bridge_withdraw(VALID_ID, VALID_ID_2, 100));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+}
+
+// ============================================================================
+// Asynchronous submission
+// ============================================================================
+
+LOGOS_TEST(transfer_public_async_delivers_result_through_await) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const int64_t ticket = module.transfer_public_async(VALID_ID, VALID_ID_2, VALID_U128);
+    LOGOS_ASSERT_TRUE(ticket > 0);
+
+    const nlohmann::json status = parseObject(module.await_async_result(ticket, 5000));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("done"));
+    LOGOS_ASSERT_EQ(status["method"].get<std::string>(), std::string("transfer_public"));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_transfer_public"));
+
+    // The payload is exactly what the blocking call returns.
+    const nlohmann::json result = parseObject(status["result"].get<std::string>());
+    LOGOS_ASSERT_TRUE(result["success"].get<bool>());
+    LOGOS_ASSERT_EQ(result["tx_hash"].get<std::string>(), std::string("0xmocktxhash"));
+}
+
+LOGOS_TEST(async_result_is_reported_once) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const int64_t ticket = module.vault_claim_async(VALID_ID, VALID_U128);
+    LOGOS_ASSERT_EQ(parseObject(module.await_async_result(ticket, 5000))["status"].get<std::string>(), std::string("done"));
+    LOGOS_ASSERT_EQ(parseObject(module.poll_async_result(ticket))["status"].get<std::string>(), std::string("unknown"));
+}
+
+LOGOS_TEST(async_validation_error_is_delivered_as_result) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const int64_t ticket = module.transfer_private_async(VALID_ID, "not-json", VALID_U128);
+    const nlohmann::json status = parseObject(module.await_async_result(ticket, 5000));
+    const nlohmann::json result = parseObject(status["result"].get<std::string>());
+    LOGOS_ASSERT_FALSE(result["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(result["error"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_transfer_private"));
+}
+
+LOGOS_TEST(poll_async_result_unknown_ticket) {
+    LEZCoreModule module;
+
+    const nlohmann::json status = parseObject(module.poll_async_result(12345));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("unknown"));
+    LOGOS_ASSERT_TRUE(status["result"].get<std::string>().empty());
+}
+
+// ============================================================================
+// Transaction tracking
+// ============================================================================
+
+LOGOS_TEST(wait_for_transaction_reports_confirmation) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json status = parseObject(module.wait_for_transaction("0x" + VALID_ID, 5000));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_poll_transaction_status"));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("confirmed"));
+    LOGOS_ASSERT_EQ(status["tx_hash"].get<std::string>(), VALID_ID);
+
+    const LogosList events = module.get_transaction_events(0);
+    LOGOS_ASSERT_EQ(static_cast<int>(events.size()), 1);
+    LOGOS_ASSERT_EQ(events[0]["tx_hash"].get<std::string>(), VALID_ID);
+    LOGOS_ASSERT_EQ(events[0]["status"].get<std::string>(), std::string("confirmed"));
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_transaction_events(events[0]["sequence"].get<int64_t>()).size()), 0);
+}
+
+LOGOS_TEST(wait_for_transaction_times_out_while_pending) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("poll_transaction_pending").returns(1);
+    LEZCoreModule module;
+
+    const nlohmann::json status = parseObject(module.wait_for_transaction(VALID_ID, 100));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("timed_out"));
+
+    const LogosList events = module.get_transaction_events(0);
+    LOGOS_ASSERT_EQ(static_cast<int>(events.size()), 1);
+    LOGOS_ASSERT_EQ(events[0]["status"].get<std::string>(), std::string("timed_out"));
+}
+
+// FFI errors are retried with backoff rather than resolving the hash.
+LOGOS_TEST(watch_transaction_retries_after_ffi_error) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_poll_transaction_status").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.watch_transaction(VALID_ID, 10000));
+    const nlohmann::json status = parseObject(module.wait_for_transaction(VALID_ID, 50));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("pending"));
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_transaction_events(0).size()), 0);
+}
+
+LOGOS_TEST(watch_transaction_invalid_hash) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_FALSE(module.watch_transaction("0xmocktxhash", 1000));
+    const nlohmann::json status = parseObject(module.wait_for_transaction("0xmocktxhash", 1000));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("invalid"));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_poll_transaction_status"));
+}
+
+// ============================================================================
+// Vault claiming
+// ============================================================================
+
+LOGOS_TEST(get_vault_balance_invalid_hex_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.get_vault_balance("not-hex").empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_get_vault_balance"));
+}
+
+LOGOS_TEST(get_vault_balance_returns_decimal_string) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("get_vault_balance_value").returns(42);
+    LEZCoreModule module;
+
+    const std::string balance = module.get_vault_balance(VALID_ID);
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_get_vault_balance"));
+    LOGOS_ASSERT_EQ(balance, std::string("42"));
+}
+
+LOGOS_TEST(get_vault_balance_ffi_error_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_get_vault_balance").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.get_vault_balance(VALID_ID).empty());
+}
+
+LOGOS_TEST(vault_claim_success_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, VALID_U128));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_vault_claim"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT_EQ(obj["tx_hash"].get<std::string>(), std::string("0xmocktxhash"));
+    LOGOS_ASSERT_TRUE(obj["error"].get<std::string>().empty());
+}
+
+LOGOS_TEST(vault_claim_invalid_hex_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim("bad", VALID_U128));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_vault_claim"));
+}
+
+LOGOS_TEST(vault_claim_invalid_amount_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, "ff"));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), std::string("amount"));
+}
+
+LOGOS_TEST(vault_claim_ffi_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_vault_claim").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim(VALID_ID, VALID_U128));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+}
+
+LOGOS_TEST(vault_claim_private_success_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, VALID_U128));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_vault_claim_private"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+}
+
+LOGOS_TEST(vault_claim_private_invalid_hex_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim_private("bad", VALID_U128));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_vault_claim_private"));
+}
+
+LOGOS_TEST(vault_claim_private_invalid_amount_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, "ff"));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), std::string("amount"));
+}
+
+LOGOS_TEST(vault_claim_private_ffi_error_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_vault_claim_private").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.vault_claim_private(VALID_ID, VALID_U128));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_FALSE(obj["error"].get<std::string>().empty());
+}
+
+// ============================================================================
+// Pinata claiming
+// ============================================================================
+
+LOGOS_TEST(claim_pinata_invalid_hex_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.claim_pinata("bad", VALID_ID_2, VALID_U128).empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata"));
+}
+
+LOGOS_TEST(claim_pinata_invalid_solution_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(module.claim_pinata(VALID_ID, VALID_ID_2, "ab").empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata"));
+}
+
+LOGOS_TEST(claim_pinata_success_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json obj = parseObject(module.claim_pinata(VALID_ID, VALID_ID_2, VALID_U128));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_claim_pinata"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+}
+
+LOGOS_TEST(claim_pinata_already_initialized_invalid_siblings_returns_empty) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    // siblings json is not an array -> parse failure.
+    const std::string result = module.claim_pinata_private_owned_already_initialized(
+        VALID_ID, VALID_ID_2, VALID_U128, 0, "not-an-array");
+    LOGOS_ASSERT_TRUE(result.empty());
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_claim_pinata_private_owned_already_initialized"));
+}
+
+LOGOS_TEST(claim_pinata_already_initialized_success_json) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const std::string siblings = std::string("[\"") + std::string(64, 'a') + std::string("\",\"") + std::string(64, 'b') + std::string("\"]");
+    const nlohmann::json obj = parseObject(module.claim_pinata_private_owned_already_initialized(
+        VALID_ID, VALID_ID_2, VALID_U128, 1, siblings));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_claim_pinata_private_owned_already_initialized"));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+}
+
+// ============================================================================
+// Prover warm-up
+// ============================================================================
+
+static nlohmann::json awaitProverReadiness(LEZCoreModule& module) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    nlohmann::json readiness = parseObject(module.get_prover_readiness());
+    while (readiness["state"] == "warming" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        readiness = parseObject(module.get_prover_readiness());
+    }
+    return readiness;
+}
+
+LOGOS_TEST(prover_warmup_on_open_caches_private_identities) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(4);
+    MockWalletFfiCapture::resolvePrivateAccountCalls = 0;
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(parseObject(module.get_prover_readiness())["state"].get<std::string>(), "cold");
+    LOGOS_ASSERT_TRUE(module.set_prover_warmup(true));
+    LOGOS_ASSERT_EQ(module.open("/cfg", "/store", "/stats"), static_cast<int64_t>(SUCCESS));
+
+    const nlohmann::json readiness = awaitProverReadiness(module);
+    LOGOS_ASSERT_EQ(readiness["state"].get<std::string>(), "ready");
+    LOGOS_ASSERT_EQ(readiness["elfs_loaded"].get<int>(), 4);
+    // Odd list entries are private in the mock.
+    LOGOS_ASSERT_EQ(readiness["identities_resolved"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::resolvePrivateAccountCalls.load(), 2);
+
+    // The first private call reuses the warmed identity instead of resolving it again.
+    const nlohmann::json obj = parseObject(module.send_generic_private_transaction({std::string(64, '1')}, {1}, {0xAA}, {}));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::resolvePrivateAccountCalls.load(), 2);
+}
+
+LOGOS_TEST(prover_warmup_is_off_by_default) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_FALSE(module.start_prover_warmup()); // no wallet yet
+    module.open("/cfg", "/store", "/stats");
+    LOGOS_ASSERT_EQ(parseObject(module.get_prover_readiness())["state"].get<std::string>(), "cold");
+    LOGOS_ASSERT_TRUE(module.start_prover_warmup());
+    LOGOS_ASSERT_EQ(awaitProverReadiness(module)["state"].get<std::string>(), "ready");
+}
+
+LOGOS_TEST(prover_warmup_reports_elf_fetch_failure) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("wallet_ffi_token_elf").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    module.open("/cfg", "/store", "/stats");
+    LOGOS_ASSERT_TRUE(module.start_prover_warmup());
+    const nlohmann::json readiness = awaitProverReadiness(module);
+    LOGOS_ASSERT_EQ(readiness["state"].get<std::string>(), "failed");
+    LOGOS_ASSERT_CONTAINS(readiness["error"].get<std::string>(), "builtin ELF fetch");
+}
+
+// Private identities are resolved once per open wallet, warm-up or not.
+LOGOS_TEST(private_identity_is_resolved_once) {
+    auto t = LogosTestContext("logos_execution_zone");
+    MockWalletFfiCapture::resolvePrivateAccountCalls = 0;
+    LEZCoreModule module;
+
+    module.send_generic_private_transaction({VALID_ID, VALID_ID_2}, {1}, {0xAA}, {});
+    module.send_generic_private_transaction({VALID_ID}, {1}, {0xAA}, {});
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::resolvePrivateAccountCalls.load(), 2);
+}
+
+// Managed wallets
+// ============================================================================
+
+LOGOS_TEST(managed_wallets_route_calls_by_id) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("get_balance_value").returns(7);
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.open_managed_wallet("alice", "/cfg", "/alice", "/stats"), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_EQ(module.open_managed_wallet("bob", "/cfg", "/bob", "/stats"), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_EQ(module.open_managed_wallet("bob", "/cfg", "/bob", "/stats"), static_cast<int64_t>(INTERNAL_ERROR));
+
+    LOGOS_ASSERT_EQ(module.managed_create_account_public("alice").size(), static_cast<size_t>(64));
+    LOGOS_ASSERT_EQ(module.managed_get_balance("bob", VALID_ID, true), "7");
+    const nlohmann::json obj = parseObject(module.managed_transfer_public("alice", VALID_ID, VALID_ID_2, VALID_U128));
+    LOGOS_ASSERT_TRUE(obj["success"].get<bool>());
+    LOGOS_ASSERT_EQ(module.managed_sync_to_block("bob", 10), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_EQ(module.managed_save("alice"), static_cast<int64_t>(SUCCESS));
+
+    const int64_t ticket = module.managed_transfer_public_async("bob", VALID_ID, VALID_ID_2, VALID_U128);
+    const nlohmann::json async = parseObject(module.await_async_result(ticket, 5000));
+    LOGOS_ASSERT_EQ(async["status"].get<std::string>(), "done");
+    LOGOS_ASSERT_TRUE(parseObject(async["result"].get<std::string>())["success"].get<bool>());
+
+    // The module's own wallet is untouched by all of this.
+    LOGOS_ASSERT_EQ(module.open("/cfg", "/store", "/stats"), static_cast<int64_t>(SUCCESS));
+}
+
+LOGOS_TEST(managed_wallets_cover_accounts_and_private_transfers) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(3);
+    const std::string txHash(64, 'c');
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
+    LEZCoreModule module;
+    module.set_account_history(true);
+    LOGOS_ASSERT_EQ(module.open_managed_wallet("alice", "/cfg", "/alice", "/stats"), static_cast<int64_t>(SUCCESS));
+
+    LOGOS_ASSERT_EQ(static_cast<int>(module.managed_list_accounts("alice").size()), 3);
+    LOGOS_ASSERT_TRUE(parseObject(module.managed_get_account_public("alice", VALID_ID)).contains("balance"));
+    LOGOS_ASSERT_TRUE(parseObject(module.managed_get_account_private("alice", VALID_ID)).contains("balance"));
+
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump();
+    LOGOS_ASSERT_TRUE(parseObject(module.managed_transfer_shielded("alice", VALID_ID, keysJson, VALID_U128))["success"].get<bool>());
+    LOGOS_ASSERT_TRUE(parseObject(module.managed_transfer_deshielded("alice", VALID_ID, VALID_ID_2, VALID_U128))["success"].get<bool>());
+    LOGOS_ASSERT_TRUE(parseObject(module.managed_transfer_private("alice", VALID_ID, keysJson, VALID_U128))["success"].get<bool>());
+    for (const int64_t ticket : {module.managed_transfer_shielded_async("alice", VALID_ID, keysJson, VALID_U128),
+                                 module.managed_transfer_deshielded_async("alice", VALID_ID, VALID_ID_2, VALID_U128),
+                                 module.managed_transfer_private_async("alice", VALID_ID, keysJson, VALID_U128)}) {
+        const nlohmann::json async = parseObject(module.await_async_result(ticket, 5000));
+        LOGOS_ASSERT_EQ(async["status"].get<std::string>(), "done");
+        LOGOS_ASSERT_TRUE(parseObject(async["result"].get<std::string>())["success"].get<bool>());
+    }
+
+    // Every proof went through the scheduler, and every submission into the history.
+    LOGOS_ASSERT_EQ(parseObject(module.get_proving_stats())["admitted"].get<int>(), 6);
+    const nlohmann::json page = parseObject(module.get_account_history(VALID_ID, 0, 10));
+    LOGOS_ASSERT_EQ(static_cast<int>(page["records"].size()), 6);
+    LOGOS_ASSERT_EQ(page["records"][5]["method"].get<std::string>(), std::string("managed_transfer_shielded"));
+    LOGOS_ASSERT_EQ(module.managed_list_accounts("nobody").size(), size_t{0});
+    LOGOS_ASSERT_EQ(module.managed_get_account_public("nobody", VALID_ID), "");
+}
+
+LOGOS_TEST(managed_wallet_unknown_id_fails) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.managed_get_balance("nobody", VALID_ID, true), "");
+    const nlohmann::json obj = parseObject(module.managed_transfer_public("nobody", VALID_ID, VALID_ID_2, VALID_U128));
+    LOGOS_ASSERT_FALSE(obj["success"].get<bool>());
+    LOGOS_ASSERT_CONTAINS(obj["error"].get<std::string>(), "unknown wallet");
+    LOGOS_ASSERT_EQ(module.managed_save("nobody"), static_cast<int64_t>(INTERNAL_ERROR));
+    LOGOS_ASSERT_EQ(module.close_managed_wallet("nobody"), static_cast<int64_t>(INTERNAL_ERROR));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_get_balance"));
+}
+
+LOGOS_TEST(managed_wallet_limit_evicts_idle_wallets) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("get_balance_value").returns(7);
+    LEZCoreModule module;
+
+    module.set_managed_wallet_limit(1);
+    module.open_managed_wallet("alice", "/cfg", "/alice", "/stats");
+    module.open_managed_wallet("bob", "/cfg", "/bob", "/stats");
+    // Evicted, then reopened transparently.
+    LOGOS_ASSERT_EQ(module.managed_get_balance("alice", VALID_ID, true), "7");
+
+    const nlohmann::json stats = parseObject(module.get_managed_wallets());
+    LOGOS_ASSERT_EQ(stats["registered"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(stats["open"].get<int>(), 1);
+    LOGOS_ASSERT_EQ(stats["max_open"].get<int>(), 1);
+    LOGOS_ASSERT_EQ(stats["evictions"].get<int>(), 2);
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+
+    LOGOS_ASSERT_EQ(module.close_managed_wallet("alice"), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_EQ(parseObject(module.get_managed_wallets())["registered"].get<int>(), 1);
+}
+
+// Autosave
+// ============================================================================
+
+LOGOS_TEST(autosave_coalesces_account_creation_saves) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+    module.set_autosave(10, 0);
+
+    for (int i = 0; i < 25; ++i)
+        module.create_account_public();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (parseObject(module.get_autosave_stats())["saves"].get<int>() < 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // How the 25 changes split across saves depends on scheduling, but they are batched.
+    LOGOS_ASSERT_EQ(module.flush(), static_cast<int64_t>(SUCCESS));
+    const nlohmann::json stats = parseObject(module.get_autosave_stats());
+    LOGOS_ASSERT_EQ(stats["mutations"].get<int>(), 25);
+    LOGOS_ASSERT_EQ(stats["pending_mutations"].get<int>(), 0);
+    LOGOS_ASSERT_GT(stats["saves"].get<int>(), 0);
+    LOGOS_ASSERT(stats["saves"].get<int>() <= 3);
+}
+
+LOGOS_TEST(flush_saves_only_pending_changes) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+
+    LOGOS_ASSERT_EQ(module.flush(), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_save"));
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+    module.add_label("savings", VALID_ID, false);
+    // Reads leave nothing to save.
+    module.get_balance(VALID_ID, true);
+    LOGOS_ASSERT_EQ(parseObject(module.get_autosave_stats())["pending_mutations"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(module.flush(), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+    LOGOS_ASSERT_EQ(parseObject(module.get_autosave_stats())["pending_mutations"].get<int>(), 0);
+}
+
+LOGOS_TEST(failed_changes_leave_nothing_to_save) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("wallet_ffi_transfer_public").returns(static_cast<int>(INTERNAL_ERROR));
+    t.mockCFunction("wallet_ffi_sync_to_block").returns(static_cast<int>(INTERNAL_ERROR));
+    t.mockCFunction("wallet_ffi_add_label").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+    module.sync_to_block(5);
+    LOGOS_ASSERT_EQ(module.add_label("savings", VALID_ID, false), static_cast<int64_t>(INTERNAL_ERROR));
+    const nlohmann::json stats = parseObject(module.get_autosave_stats());
+    LOGOS_ASSERT_EQ(stats["mutations"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(stats["pending_mutations"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(module.flush(), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_save"));
+}
+
+LOGOS_TEST(autosave_saves_on_destruction) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    {
+        LEZCoreModule module;
+        module.open("/cfg", "/store", "/stats");
+        module.set_autosave(1000, 60000);
+        module.sync_to_block(5);
+        LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_save"));
+    }
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+}
+
+// Transaction journal
+// ============================================================================
+
+LOGOS_TEST(tx_journal_survives_restart_and_follows_status) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    const std::string txHash(64, 'c');
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
+    t.mockCFunction("poll_transaction_pending").returns(1);
+    char storage[] = "/tmp/lez_journal_store_XXXXXX";
+    const int fd = mkstemp(storage);
+    LOGOS_ASSERT(fd >= 0);
+    close(fd);
+    const std::string journalPath = std::string(storage) + ".txjournal";
+
+    {
+        LEZCoreModule module;
+        LOGOS_ASSERT_TRUE(module.set_tx_journal(true));
+        module.open("/cfg", storage, "/stats");
+        module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+
+        const nlohmann::json entries = parseObject(module.get_journal_transactions(VALID_ID_2, "", 10));
+        LOGOS_ASSERT_EQ(static_cast<int>(entries.size()), 1);
+        LOGOS_ASSERT_EQ(entries[0]["method"].get<std::string>(), std::string("transfer_public"));
+        LOGOS_ASSERT_EQ(entries[0]["tx_hash"].get<std::string>(), txHash);
+        LOGOS_ASSERT_EQ(entries[0]["accounts"][0].get<std::string>(), VALID_ID);
+        LOGOS_ASSERT_EQ(entries[0]["amount"].get<std::string>(), VALID_U128);
+        LOGOS_ASSERT_EQ(entries[0]["status"].get<std::string>(), std::string("pending"));
+        LOGOS_ASSERT_EQ(static_cast<int>(parseObject(module.get_journal_transactions("", "confirmed", 10)).size()), 0);
+    }
+
+    // After a restart the pending transaction is watched again and its confirmation lands.
+    t.mockCFunction("poll_transaction_pending").returns(0);
+    LEZCoreModule module;
+    module.set_tx_journal(true);
+    module.open("/cfg", storage, "/stats");
+    const nlohmann::json status = parseObject(module.wait_for_transaction(txHash, 5000));
+    LOGOS_ASSERT_EQ(status["status"].get<std::string>(), std::string("confirmed"));
+    const nlohmann::json confirmed = parseObject(module.get_journal_transactions("", "confirmed", 10));
+    LOGOS_ASSERT_EQ(static_cast<int>(confirmed.size()), 1);
+    LOGOS_ASSERT_EQ(confirmed[0]["sequence"].get<int>(), 1);
+
+    unlink(journalPath.c_str());
+    unlink(storage);
+}
+
+LOGOS_TEST(tx_journal_is_off_by_default_and_validates_arguments) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    const std::string txHash(64, 'c');
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+
+    LOGOS_ASSERT_EQ(module.get_journal_transactions("", "", 10), std::string("[]"));
+    LOGOS_ASSERT_EQ(module.get_journal_transactions("", "", 0), std::string("[]"));
+    LOGOS_ASSERT_EQ(module.get_journal_transactions("zz", "", 10), std::string("[]"));
+    LOGOS_ASSERT_EQ(module.get_journal_transactions("", "lost", 10), std::string("[]"));
+}
+
+// Account history
+// ============================================================================
+
+LOGOS_TEST(account_history_records_submissions_and_sync_changes) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(2);
+    const std::string txHash(64, 'c');
+    t.mockCFunction("transfer_tx_hash").returns(txHash.c_str());
+    const std::string account(64, '1');
+    LEZCoreModule module;
+    LOGOS_ASSERT_TRUE(module.set_account_history(true));
+    module.open("/cfg", "/store", "/stats");
+
+    module.transfer_public(VALID_ID, account, VALID_U128);
+    // The first sync only sets the baseline; nothing moved.
+    LOGOS_ASSERT_EQ(module.sync_to_block(5), static_cast<int64_t>(SUCCESS));
+    t.mockCFunction("account_balance_value").returns(9);
+    LOGOS_ASSERT_EQ(module.sync_to_block(6), static_cast<int64_t>(SUCCESS));
+
+    const nlohmann::json first = parseObject(module.get_account_history(account, 0, 1));
+    LOGOS_ASSERT_EQ(static_cast<int>(first["records"].size()), 1);
+    const nlohmann::json& change = first["records"][0];
+    LOGOS_ASSERT_EQ(change["kind"].get<std::string>(), std::string("balance"));
+    LOGOS_ASSERT_EQ(change["block"].get<int>(), 6);
+    LOGOS_ASSERT_EQ(change["previous_balance"].get<std::string>().substr(0, 2), std::string("07"));
+    LOGOS_ASSERT_EQ(change["balance"].get<std::string>().substr(0, 2), std::string("09"));
+    LOGOS_ASSERT_GT(first["next_cursor"].get<int64_t>(), int64_t{0});
+
+    const nlohmann::json second = parseObject(module.get_account_history(account, first["next_cursor"].get<int64_t>(), 10));
+    LOGOS_ASSERT_EQ(static_cast<int>(second["records"].size()), 1);
+    LOGOS_ASSERT_EQ(second["records"][0]["kind"].get<std::string>(), std::string("submission"));
+    LOGOS_ASSERT_EQ(second["records"][0]["method"].get<std::string>(), std::string("transfer_public"));
+    LOGOS_ASSERT_EQ(second["records"][0]["tx_hash"].get<std::string>(), txHash);
+    LOGOS_ASSERT_EQ(second["records"][0]["amount"].get<std::string>(), VALID_U128);
+    LOGOS_ASSERT_EQ(second["next_cursor"].get<int64_t>(), int64_t{0});
+}
+
+LOGOS_TEST(account_history_is_off_by_default) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(2);
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+    module.sync_to_block(5);
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_list_accounts"));
+
+    const nlohmann::json page = parseObject(module.get_account_history(std::string(64, '1'), 0, 10));
+    LOGOS_ASSERT_EQ(static_cast<int>(page["records"].size()), 0);
+    LOGOS_ASSERT_EQ(page["next_cursor"].get<int64_t>(), int64_t{0});
+    LOGOS_ASSERT_EQ(static_cast<int>(parseObject(module.get_account_history("zz", 0, 10))["records"].size()), 0);
+    LOGOS_ASSERT_EQ(static_cast<int>(parseObject(module.get_account_history(VALID_ID, -1, 10))["records"].size()), 0);
+}
+
+// Balance change events
+// ============================================================================
+
+LOGOS_TEST(balance_events_list_only_changed_accounts_per_sync) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(3);
+    LEZCoreModule module;
+    LOGOS_ASSERT_TRUE(module.set_balance_events(true));
+    module.open("/cfg", "/store", "/stats");
+
+    LOGOS_ASSERT_EQ(module.sync_to_block(5), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_list_accounts"));
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_changes_since(0).size()), 0);
+
+    t.mockCFunction("account_nonce_value").returns(2);
+    LOGOS_ASSERT_EQ(module.sync_to_block(6), static_cast<int64_t>(SUCCESS));
+    const LogosList events = module.get_changes_since(0);
+    LOGOS_ASSERT_EQ(static_cast<int>(events.size()), 1);
+    LOGOS_ASSERT_EQ(events[0]["block"].get<int>(), 6);
+    const nlohmann::json& changes = events[0]["changes"];
+    LOGOS_ASSERT_EQ(static_cast<int>(changes.size()), 3);
+    // list_accounts' first entry: id bytes 0x10, public.
+    LOGOS_ASSERT_EQ(changes[0]["account_id"].get<std::string>().substr(0, 4), std::string("1010"));
+    LOGOS_ASSERT_TRUE(changes[0]["is_public"].get<bool>());
+    LOGOS_ASSERT_EQ(changes[0]["previous_balance"].get<std::string>(), changes[0]["balance"].get<std::string>());
+    LOGOS_ASSERT_EQ(changes[0]["nonce"].get<std::string>().substr(0, 2), std::string("02"));
+
+    // Nothing moved: no event, and the cursor stays put.
+    module.sync_to_block(7);
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_changes_since(events[0]["sequence"].get<int64_t>()).size()), 0);
+}
+
+LOGOS_TEST(balance_events_are_off_by_default) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("list_accounts_count").returns(2);
+    LEZCoreModule module;
+    module.open("/cfg", "/store", "/stats");
+    module.sync_to_block(5);
+    t.mockCFunction("account_balance_value").returns(9);
+    module.sync_to_block(6);
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_list_accounts"));
+    LOGOS_ASSERT_EQ(static_cast<int>(module.get_changes_since(0).size()), 0);
+}
+
+// Wallet lifecycle
+// ============================================================================
+
+LOGOS_TEST(create_new_success_then_double_open_fails) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_create_new").returns(1); // non-null handle
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_TRUE(!module.create_new("/cfg", "/store", "/stats", "pw").empty());
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_create_new"));
+    // Second attempt: already open.
+    LOGOS_ASSERT_EQ(module.create_new("/cfg", "/store", "/stats", "pw"), "");
+}
+
+LOGOS_TEST(create_new_null_handle_returns_internal_error) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_create_new").returns(0); // null handle
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.create_new("/cfg", "/store", "/stats", "pw"), "");
+}
+
+LOGOS_TEST(open_success) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.open("/cfg", "/store", "/stats"), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_open"));
+}
+
+LOGOS_TEST(save_forwards_return_code) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_save").returns(static_cast<int>(SUCCESS));
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.save(), static_cast<int64_t>(SUCCESS));
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+LOGOS_TEST(get_sequencer_addr_returns_string) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_get_sequencer_addr").returns("10.0.0.1:9000");
+    LEZCoreModule module;
+
+    LOGOS_ASSERT_EQ(module.get_sequencer_addr(), std::string("10.0.0.1:9000"));
+}
+
+// ============================================================================
+// Diagnostics
+// ============================================================================
+
+static nlohmann::json methodMetrics(LEZCoreModule& module, const std::string& method) {
+    const nlohmann::json metrics = parseObject(module.get_metrics());
+    for (const nlohmann::json& entry : metrics["methods"]) {
+        if (entry["method"] == method)
+            return entry;
+    }
+    return nlohmann::json();
+}
+
+LOGOS_TEST(get_metrics_is_empty_before_any_call) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    const nlohmann::json metrics = parseObject(module.get_metrics());
+    LOGOS_ASSERT_TRUE(metrics["methods"].is_array());
+    LOGOS_ASSERT_EQ(static_cast<int>(metrics["methods"].size()), 0);
+}
+
+LOGOS_TEST(get_metrics_counts_calls_and_ffi_time) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    module.create_account_public();
+    module.create_account_public();
+
+    const nlohmann::json entry = methodMetrics(module, "create_account_public");
+    LOGOS_ASSERT_EQ(entry["calls"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(entry["failed_calls"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(static_cast<int>(entry["ffi_errors"].size()), 0);
+    LOGOS_ASSERT_EQ(entry["latency"]["count"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(entry["ffi_latency"]["count"].get<int>(), 2);
+    LOGOS_ASSERT(entry["ffi_latency"]["sum_us"].get<int64_t>() <= entry["latency"]["sum_us"].get<int64_t>());
+}
+
+LOGOS_TEST(get_metrics_breaks_errors_down_by_code) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_transfer_public").returns(static_cast<int>(INVALID_ACCOUNT_ID));
+    LEZCoreModule module;
+
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+
+    const nlohmann::json entry = methodMetrics(module, "transfer_public");
+    LOGOS_ASSERT_EQ(entry["calls"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(entry["failed_calls"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(entry["ffi_errors"][std::to_string(INVALID_ACCOUNT_ID)].get<int>(), 2);
+}
+
+LOGOS_TEST(get_metrics_records_calls_rejected_before_the_ffi) {
+    auto t = LogosTestContext("logos_execution_zone");
+    LEZCoreModule module;
+
+    module.get_balance("not hex", true);
+
+    const nlohmann::json entry = methodMetrics(module, "get_balance");
+    LOGOS_ASSERT_EQ(entry["calls"].get<int>(), 1);
+    LOGOS_ASSERT_EQ(entry["ffi_latency"]["count"].get<int>(), 0);
+    LOGOS_ASSERT(!t.cFunctionCalled("wallet_ffi_get_balance"));
+}
+
+// Calls every public method once (most with arguments they reject, which still records the
+// call), so a method added without room in the metrics table shows up as dropped calls.
+LOGOS_TEST(get_metrics_has_room_for_every_method) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    LEZCoreModule module;
+    const std::string keysJson = nlohmann::json{{"nullifier_public_key", VALID_ID}}.dump();
+    const std::vector<uint8_t> id32(32, 0xaa), amount16(16, 0x01);
+
+    module.name();
+    module.version();
+    module.create_new("/cfg", "/store", "/stats", "password");
+    module.open("/cfg", "/store", "/stats");
+    module.save();
+    module.set_autosave(0, 0);
+    module.flush();
+    module.get_autosave_stats();
+    module.restore_storage("mnemonic", "password", 1);
+    module.create_account_public();
+    module.create_account_private();
+    module.list_accounts();
+    module.get_balance(VALID_ID, true);
+    module.get_balances({VALID_ID}, {true});
+    module.get_account_public(VALID_ID);
+    module.get_account_private(VALID_ID);
+    module.get_public_account_key(VALID_ID);
+    module.get_private_account_keys(VALID_ID);
+    module.account_id_to_base58(VALID_ID);
+    module.account_id_from_base58("1");
+    module.sync_to_block(1);
+    module.get_last_synced_block();
+    module.get_current_block_height();
+    module.start_background_sync(1, 1);
+    module.get_sync_progress();
+    module.cancel_background_sync();
+    module.claim_pinata(VALID_ID, VALID_ID_2, VALID_U128);
+    module.claim_pinata_private_owned_already_initialized(VALID_ID, VALID_ID_2, VALID_U128, 0, "[]");
+    module.claim_pinata_private_owned_not_initialized(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_shielded(VALID_ID, keysJson, VALID_U128);
+    module.transfer_deshielded(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_private(VALID_ID, keysJson, VALID_U128);
+    module.transfer_shielded_owned(VALID_ID, VALID_ID_2, VALID_U128);
+    module.transfer_private_owned(VALID_ID, VALID_ID_2, VALID_U128);
+    module.register_public_account(VALID_ID);
+    module.register_private_account(VALID_ID);
+    module.authenticated_transfer_elf();
+    module.token_elf();
+    module.amm_elf();
+    module.ata_elf();
+    module.builtin_elf_fd("no_such_program");
+    module.send_generic_public_transaction({VALID_ID}, {true}, {1}, PROGRAM_ID);
+    module.send_generic_private_transaction({VALID_ID}, {1}, {0xAA}, {});
+    module.send_builtin_private_transaction({VALID_ID}, {1}, "token", {});
+    module.send_program_deployment_transaction({0xAA});
+    module.poll_transaction_status(VALID_ID);
+    const std::string program = module.register_program({0xAA});
+    module.register_builtin_program("token");
+    module.send_registered_private_transaction({VALID_ID}, {1}, program, {});
+    module.unregister_program(program);
+    const std::string recipient = module.register_recipient(keysJson);
+    module.transfer_shielded_to(VALID_ID, recipient, VALID_U128);
+    module.transfer_private_to(VALID_ID, recipient, VALID_U128);
+    module.unregister_recipient(recipient);
+    module.payout_public(VALID_ID, "[]", PROGRAM_ID);
+    module.watch_transaction(VALID_ID, 1);
+    module.wait_for_transaction("not hex", 1);
+    module.get_transaction_events(0);
+    module.set_tx_journal(false);
+    module.get_journal_transactions(VALID_ID, "", 1);
+    module.set_account_history(false);
+    module.get_account_history(VALID_ID, 0, 1);
+    module.set_balance_events(false);
+    module.get_changes_since(0);
+    module.bridge_withdraw(VALID_ID, VALID_ID_2, 1);
+    module.get_vault_balance(VALID_ID);
+    module.vault_claim(VALID_ID, VALID_U128);
+    module.vault_claim_private(VALID_ID, VALID_U128);
+    module.random_identifiers(1);
+    module.random_identifiers_bin(1);
+    module.transfer_public_decimal(VALID_ID, VALID_ID_2, "1");
+    module.transfer_shielded_decimal(VALID_ID, keysJson, "1");
+    module.transfer_deshielded_decimal(VALID_ID, VALID_ID_2, "1");
+    module.transfer_private_decimal(VALID_ID, keysJson, "1");
+    module.transfer_shielded_owned_decimal(VALID_ID, VALID_ID_2, "1");
+    module.transfer_private_owned_decimal(VALID_ID, VALID_ID_2, "1");
+    module.vault_claim_decimal(VALID_ID, "1");
+    module.vault_claim_private_decimal(VALID_ID, "1");
+    module.get_balance_bin(id32, true);
+    module.get_account_public_bin(id32);
+    module.get_account_private_bin(id32);
+    module.transfer_public_bin(id32, id32, amount16);
+    module.transfer_shielded_bin(id32, id32, id32, amount16);
+    module.transfer_deshielded_bin(id32, id32, amount16);
+    module.transfer_private_bin(id32, id32, id32, amount16);
+    module.poll_transaction_status_bin(id32);
+    const std::vector<int64_t> tickets = {
+        module.claim_pinata_async("", "", ""),
+        module.claim_pinata_private_owned_already_initialized_async("", "", "", 0, "[]"),
+        module.claim_pinata_private_owned_not_initialized_async("", "", ""),
+        module.transfer_public_async("", "", ""),
+        module.transfer_shielded_async("", "", ""),
+        module.transfer_deshielded_async("", "", ""),
+        module.transfer_private_async("", "", ""),
+        module.transfer_shielded_owned_async("", "", ""),
+        module.transfer_private_owned_async("", "", ""),
+        module.bridge_withdraw_async("", "", 1),
+        module.vault_claim_async("", ""),
+        module.vault_claim_private_async("", ""),
+        module.managed_transfer_public_async("", "", "", ""),
+        module.managed_transfer_shielded_async("", "", "", ""),
+        module.managed_transfer_deshielded_async("", "", "", ""),
+        module.managed_transfer_private_async("", "", "", ""),
+    };
+    for (const int64_t ticket : tickets)
+        module.await_async_result(ticket, 5000);
+    module.poll_async_result(tickets[0]);
+    module.get_sequencer_addr();
+    module.set_proving_limits(0, 0);
+    module.get_proving_stats();
+    module.set_prover_warmup(false);
+    module.start_prover_warmup();
+    module.get_prover_readiness();
+    module.open_managed_wallet("alice", "/cfg", "/alice", "/stats");
+    module.set_managed_wallet_limit(0);
+    module.get_managed_wallets();
+    module.managed_create_account_public("alice");
+    module.managed_list_accounts("alice");
+    module.managed_get_balance("alice", VALID_ID, true);
+    module.managed_get_account_public("alice", VALID_ID);
+    module.managed_get_account_private("alice", VALID_ID);
+    module.managed_transfer_public("alice", VALID_ID, VALID_ID_2, VALID_U128);
+    module.managed_transfer_shielded("alice", VALID_ID, keysJson, VALID_U128);
+    module.managed_transfer_deshielded("alice", VALID_ID, VALID_ID_2, VALID_U128);
+    module.managed_transfer_private("alice", VALID_ID, keysJson, VALID_U128);
+    module.managed_sync_to_block("alice", 1);
+    module.managed_save("alice");
+    module.close_managed_wallet("alice");
+    module.check_label_available("savings");
+    module.add_label("savings", VALID_ID, false);
+    module.resolve_label("savings");
+    module.get_all_labels_for_account(VALID_ID, false);
+
+    const nlohmann::json metrics = parseObject(module.get_metrics());
+    LOGOS_ASSERT_EQ(metrics["dropped_calls"].get<int>(), 0);
+    LOGOS_ASSERT_GT(metrics["methods"].size(), size_t{120});
+    LOGOS_ASSERT(metrics["methods"].size() <= MethodMetrics::MaxMethods / 2);
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+// Injects latency into the mock for one test; MockWalletFfiBehavior is global state.
+struct ScopedMockLatency {
+    explicit ScopedMockLatency(const std::vector<std::string>& functions) {
+        MockWalletFfiBehavior::FunctionBehavior slow;
+        slow.latency = MockWalletFfiBehavior::Latency::fixed(std::chrono::milliseconds(30));
+        for (const std::string& function : functions)
+            MockWalletFfiBehavior::configure(function, slow);
+    }
+    ~ScopedMockLatency() { MockWalletFfiBehavior::reset(); }
+};
+
+LOGOS_TEST(read_queries_run_concurrently) {
+    auto t = LogosTestContext("logos_execution_zone");
+    const ScopedMockLatency latency({"wallet_ffi_get_balance"});
+    LEZCoreModule module;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        // Distinct ids so every read reaches the FFI instead of the read cache.
+        readers.emplace_back([&module, i] { module.get_balance(std::string(63, 'a') + std::to_string(i), true); });
+    }
+    for (std::thread& reader : readers)
+        reader.join();
+
+    LOGOS_ASSERT_EQ(MockWalletFfiBehavior::overlapViolations(), 0);
+    LOGOS_ASSERT_GT(MockWalletFfiBehavior::peakConcurrentReads(), 1);
+}
+
+LOGOS_TEST(mutations_are_serialised_against_reads_and_each_other) {
+    auto t = LogosTestContext("logos_execution_zone");
+    const ScopedMockLatency latency({"wallet_ffi_get_balance", "wallet_ffi_transfer_public", "wallet_ffi_add_label"});
+    LEZCoreModule module;
+
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 3; ++i) {
+        const std::string id = std::string(63, 'a') + std::to_string(i);
+        callers.emplace_back([&module, id] { module.get_balance(id, true); });
+        callers.emplace_back([&module, id] { module.transfer_public(id, VALID_ID_2, VALID_U128); });
+        callers.emplace_back([&module, id] { module.add_label("label" + id.substr(63), id, false); });
+    }
+    for (std::thread& caller : callers)
+        caller.join();
+
+    LOGOS_ASSERT_EQ(MockWalletFfiBehavior::overlapViolations(), 0);
+}
+
+// ============================================================================
+// Background sync
+// ============================================================================
+
+static nlohmann::json waitForSyncToSettle(LEZCoreModule& module) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    nlohmann::json progress = parseObject(module.get_sync_progress());
+    while (progress["state"] == "running" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        progress = parseObject(module.get_sync_progress());
+    }
+    return progress;
+}
+
+LOGOS_TEST(background_sync_reaches_target_in_chunks) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("last_synced_block_value").returns(100);
+    MockWalletFfiCapture::syncToBlockCalls = 0;
+    LEZCoreModule module;
+
+    LOGOS_ASSERT(module.start_background_sync(1000, 250));
+    const nlohmann::json progress = waitForSyncToSettle(module);
+
+    LOGOS_ASSERT_EQ(progress["state"].get<std::string>(), std::string("done"));
+    LOGOS_ASSERT_EQ(progress["start_block"].get<int>(), 100);
+    LOGOS_ASSERT_EQ(progress["current_block"].get<int>(), 1000);
+    LOGOS_ASSERT_EQ(progress["target_block"].get<int>(), 1000);
+    // 350, 600, 850, 1000
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::syncToBlockCalls, 4);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastSyncToBlock.load(), static_cast<uint64_t>(1000));
+}
+
+LOGOS_TEST(background_sync_without_target_follows_chain_head) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("last_synced_block_value").returns(0);
+    t.mockCFunction("current_block_height_value").returns(300);
+    MockWalletFfiCapture::syncToBlockCalls = 0;
+    LEZCoreModule module;
+
+    LOGOS_ASSERT(module.start_background_sync(0, 0));
+    const nlohmann::json progress = waitForSyncToSettle(module);
+
+    LOGOS_ASSERT_EQ(progress["state"].get<std::string>(), std::string("done"));
+    LOGOS_ASSERT_EQ(progress["target_block"].get<int>(), 300);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::syncToBlockCalls, 1);
+    LOGOS_ASSERT_EQ(MockWalletFfiCapture::lastSyncToBlock.load(), static_cast<uint64_t>(300));
+}
+
+LOGOS_TEST(background_sync_can_be_cancelled_and_restarted) {
+    auto t = LogosTestContext("logos_execution_zone");
+    const ScopedMockLatency latency({"wallet_ffi_sync_to_block"});
+    LEZCoreModule module;
+
+    LOGOS_ASSERT(module.start_background_sync(1000, 1));
+    LOGOS_ASSERT(!module.start_background_sync(1000, 1));
+    LOGOS_ASSERT(module.cancel_background_sync());
+    const nlohmann::json progress = waitForSyncToSettle(module);
+
+    LOGOS_ASSERT_EQ(progress["state"].get<std::string>(), std::string("cancelled"));
+    LOGOS_ASSERT_GT(1000, progress["current_block"].get<int>());
+    LOGOS_ASSERT(!module.cancel_background_sync());
+
+    LOGOS_ASSERT(module.start_background_sync(1, 1));
+    LOGOS_ASSERT_EQ(waitForSyncToSettle(module)["state"].get<std::string>(), std::string("done"));
+}
+
+LOGOS_TEST(background_sync_reports_ffi_failure) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("last_synced_block_value").returns(5);
+    t.mockCFunction("wallet_ffi_sync_to_block").returns(static_cast<int>(INTERNAL_ERROR));
+    LEZCoreModule module;
+
+    LOGOS_ASSERT(module.start_background_sync(100, 10));
+    const nlohmann::json progress = waitForSyncToSettle(module);
+
+    LOGOS_ASSERT_EQ(progress["state"].get<std::string>(), std::string("failed"));
+    LOGOS_ASSERT_EQ(progress["current_block"].get<int>(), 5);
+    LOGOS_ASSERT(!progress["error"].get<std::string>().empty());
+}
+
+LOGOS_TEST(queries_and_transfers_interleave_with_background_sync) {
+    auto t = LogosTestContext("logos_execution_zone");
+    const ScopedMockLatency latency({"wallet_ffi_sync_to_block"});
+    LEZCoreModule module;
+
+    // 1000 chunks of 30 ms: far longer than the test, so the calls below must get in between.
+    LOGOS_ASSERT(module.start_background_sync(1000, 1));
+    module.get_balance(VALID_ID, true);
+    module.transfer_public(VALID_ID, VALID_ID_2, VALID_U128);
+
+    const nlohmann::json progress = parseObject(module.get_sync_progress());
+    LOGOS_ASSERT_EQ(progress["state"].get<std::string>(), std::string("running"));
+    LOGOS_ASSERT_EQ(MockWalletFfiBehavior::overlapViolations(), 0);
+    // Destruction cancels the sync after its current chunk.
 }
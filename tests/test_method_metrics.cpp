@@ -0,0 +1,24 @@
+// Unit tests for MethodMetrics: the slot table's capacity. That the module's own method names
+// leave it plenty of room is checked in test_lez_core.cpp, by calling every method.
+
+#include <logos_test.h>
+#include "method_metrics.h"
+
+#include <string>
+#include <vector>
+
+LOGOS_TEST(method_metrics_counts_calls_that_find_the_table_full) {
+    MethodMetrics metrics;
+    std::vector<std::string> names;
+    for (size_t i = 0; i <= MethodMetrics::MaxMethods; ++i)
+        names.push_back("method_" + std::to_string(i));
+    for (const std::string& name : names)
+        MethodMetrics::Call call(metrics, name.c_str());
+
+    const nlohmann::json snapshot = metrics.snapshot();
+    LOGOS_ASSERT_EQ(snapshot["methods"].size(), MethodMetrics::MaxMethods);
+    LOGOS_ASSERT_EQ(snapshot["dropped_calls"].get<int>(), 1);
+}
+
+// Every name the sources record must fit with at least 2x headroom, so probes stay short
+// and new methods are not silently dropped from get_metrics.
@@ -0,0 +1,121 @@
+// Unit tests for ProvingScheduler: the concurrency cap, priority order, queue limit, parent
+// schedulers and the counters it reports.
+
+#include <logos_test.h>
+#include "proving_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Priority = ProvingScheduler::Priority;
+
+static void waitUntilQueued(const ProvingScheduler& scheduler, const size_t queued) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (scheduler.snapshot()["queued"].get<size_t>() < queued && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+LOGOS_TEST(proving_scheduler_caps_concurrent_calls) {
+    ProvingScheduler scheduler(2);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            const ProvingScheduler::Slot slot = scheduler.acquire(Priority::Interactive);
+            const int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            --running;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    LOGOS_ASSERT_EQ(peak.load(), 2);
+    const nlohmann::json stats = scheduler.snapshot();
+    LOGOS_ASSERT_EQ(stats["admitted"].get<int>(), 8);
+    LOGOS_ASSERT_EQ(stats["running"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(stats["queued"].get<int>(), 0);
+    LOGOS_ASSERT_GT(stats["peak_queued"].get<int>(), 0);
+}
+
+LOGOS_TEST(proving_scheduler_admits_interactive_before_background) {
+    ProvingScheduler scheduler(1);
+    std::mutex orderMutex;
+    std::vector<char> order;
+    auto holder = std::make_unique<ProvingScheduler::Slot>(scheduler.acquire(Priority::Interactive));
+
+    std::thread background([&] {
+        const ProvingScheduler::Slot slot = scheduler.acquire(Priority::Background);
+        std::lock_guard lock(orderMutex);
+        order.push_back('b');
+    });
+    waitUntilQueued(scheduler, 1);
+    std::thread interactive([&] {
+        const ProvingScheduler::Slot slot = scheduler.acquire(Priority::Interactive);
+        std::lock_guard lock(orderMutex);
+        order.push_back('i');
+    });
+    waitUntilQueued(scheduler, 2);
+
+    holder.reset();
+    background.join();
+    interactive.join();
+    LOGOS_ASSERT_EQ(order.size(), static_cast<size_t>(2));
+    LOGOS_ASSERT_EQ(order[0], 'i');
+    LOGOS_ASSERT_EQ(order[1], 'b');
+}
+
+LOGOS_TEST(proving_scheduler_rejects_past_queue_limit) {
+    ProvingScheduler scheduler(1, 1);
+    auto holder = std::make_unique<ProvingScheduler::Slot>(scheduler.acquire(Priority::Interactive));
+    std::thread waiter([&] { const ProvingScheduler::Slot slot = scheduler.acquire(Priority::Interactive); });
+    waitUntilQueued(scheduler, 1);
+
+    const ProvingScheduler::Slot rejected = scheduler.acquire(Priority::Interactive);
+    LOGOS_ASSERT_FALSE(static_cast<bool>(rejected));
+    LOGOS_ASSERT_EQ(scheduler.snapshot()["rejected"].get<int>(), 1);
+
+    holder.reset();
+    waiter.join();
+    LOGOS_ASSERT_EQ(scheduler.snapshot()["admitted"].get<int>(), 2);
+}
+
+LOGOS_TEST(proving_scheduler_raised_limit_admits_waiters) {
+    ProvingScheduler scheduler(1);
+    const ProvingScheduler::Slot holder = scheduler.acquire(Priority::Interactive);
+    std::thread waiter([&] { const ProvingScheduler::Slot slot = scheduler.acquire(Priority::Background); });
+    waitUntilQueued(scheduler, 1);
+
+    scheduler.configure(2, 0);
+    waiter.join();
+    LOGOS_ASSERT_EQ(scheduler.snapshot()["max_concurrent"].get<int>(), 2);
+    LOGOS_ASSERT_EQ(scheduler.snapshot()["running"].get<int>(), 1);
+}
+
+LOGOS_TEST(proving_scheduler_child_also_holds_a_parent_slot) {
+    ProvingScheduler parent(1, 1);
+    ProvingScheduler child(2, 0, &parent);
+    ProvingScheduler::Slot slot = child.acquire(Priority::Interactive);
+    LOGOS_ASSERT_TRUE(static_cast<bool>(slot));
+    LOGOS_ASSERT_EQ(parent.snapshot()["running"].get<int>(), 1);
+
+    // The parent's only slot is taken and another caller fills its queue of one.
+    std::thread waiter([&] { const ProvingScheduler::Slot other = parent.acquire(Priority::Interactive); });
+    waitUntilQueued(parent, 1);
+    LOGOS_ASSERT_FALSE(static_cast<bool>(child.acquire(Priority::Interactive)));
+    LOGOS_ASSERT_EQ(child.snapshot()["running"].get<int>(), 1);
+    LOGOS_ASSERT_EQ(child.snapshot()["rejected"].get<int>(), 1);
+
+    // Releasing the child's slot hands the parent's one on to the waiter.
+    slot = ProvingScheduler::Slot();
+    waiter.join();
+    LOGOS_ASSERT_EQ(parent.snapshot()["running"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(child.snapshot()["running"].get<int>(), 0);
+    LOGOS_ASSERT_EQ(parent.snapshot()["admitted"].get<int>(), 2);
+}
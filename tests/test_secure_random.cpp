@@ -0,0 +1,102 @@
+// Unit tests for SecureRandom: the ChaCha20 block function against RFC 8439, and the
+// per-thread generator's independence across draws, threads and fork().
+
+#include <logos_test.h>
+#include "secure_random.h"
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+static std::string toHex(const uint8_t* data, const size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < length; ++i) {
+        out.push_back(digits[data[i] >> 4]);
+        out.push_back(digits[data[i] & 0xF]);
+    }
+    return out;
+}
+
+static std::string draw(const size_t length) {
+    std::vector<uint8_t> bytes(length);
+    SecureRandom::fill(bytes.data(), bytes.size());
+    return std::string(bytes.begin(), bytes.end());
+}
+
+// RFC 8439 section 2.3.2.
+LOGOS_TEST(chacha20_block_matches_rfc8439) {
+    uint8_t key[32];
+    for (int i = 0; i < 32; ++i)
+        key[i] = static_cast<uint8_t>(i);
+    const uint8_t nonce[12] = {0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0};
+    uint8_t out[64];
+    SecureRandom::chacha20Block(key, 1, nonce, out);
+    LOGOS_ASSERT_EQ(toHex(out, sizeof(out)),
+                    std::string("10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+                                "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e"));
+}
+
+LOGOS_TEST(secure_random_draws_do_not_repeat) {
+    std::set<std::string> seen;
+    for (int i = 0; i < 10000; ++i)
+        LOGOS_ASSERT(seen.insert(draw(16)).second);
+}
+
+LOGOS_TEST(secure_random_large_fill_crosses_refills) {
+    // Several internal blocks' worth, starting at an odd offset.
+    draw(7);
+    const std::string bytes = draw(5000);
+    std::set<std::string> chunks;
+    for (size_t i = 0; i + 16 <= bytes.size(); i += 16)
+        LOGOS_ASSERT(chunks.insert(bytes.substr(i, 16)).second);
+    LOGOS_ASSERT_NE(bytes.find_first_not_of('\0'), std::string::npos);
+}
+
+LOGOS_TEST(secure_random_threads_get_independent_streams) {
+    constexpr int Threads = 8;
+    std::vector<std::string> results(Threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < Threads; ++i)
+        threads.emplace_back([&results, i] { results[i] = draw(64); });
+    for (std::thread& thread : threads)
+        thread.join();
+    const std::set<std::string> distinct(results.begin(), results.end());
+    LOGOS_ASSERT_EQ(distinct.size(), static_cast<size_t>(Threads));
+}
+
+LOGOS_TEST(secure_random_forked_child_reseeds) {
+    draw(16); // make sure this thread's generator is seeded before the fork
+
+    int fds[2];
+    LOGOS_ASSERT_EQ(pipe(fds), 0);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        const std::string child = draw(32);
+        const ssize_t written = write(fds[1], child.data(), child.size());
+        _exit(written == static_cast<ssize_t>(child.size()) ? 0 : 1);
+    }
+    LOGOS_ASSERT_GT(pid, 0);
+    close(fds[1]);
+    const std::string parent = draw(32);
+
+    char buffer[32];
+    size_t received = 0;
+    while (received < sizeof(buffer)) {
+        const ssize_t n = read(fds[0], buffer + received, sizeof(buffer) - received);
+        if (n <= 0)
+            break;
+        received += static_cast<size_t>(n);
+    }
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    LOGOS_ASSERT_EQ(received, sizeof(buffer));
+    LOGOS_ASSERT_NE(std::string(buffer, sizeof(buffer)), parent);
+}
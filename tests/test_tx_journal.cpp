@@ -0,0 +1,156 @@
+// Unit tests for TxJournal: appending, replay across reopen, the torn-record cut-off, the
+// account / status queries and resumed tracking. Each test works on its own temp file.
+
+#include <logos_test.h>
+#include "tx_journal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+FfiBytes32 filled(const uint8_t byte) {
+    FfiBytes32 id{};
+    for (uint8_t& b : id.data)
+        b = byte;
+    return id;
+}
+
+struct TempJournalPath {
+    std::string path;
+
+    TempJournalPath() {
+        char name[] = "/tmp/lez_tx_journal_XXXXXX";
+        const int fd = mkstemp(name);
+        if (fd >= 0)
+            close(fd);
+        path = name;
+    }
+    ~TempJournalPath() { unlink(path.c_str()); }
+};
+
+} // namespace
+
+LOGOS_TEST(tx_journal_records_and_replays) {
+    TempJournalPath file;
+    const uint8_t amount[16] = {5};
+    {
+        std::vector<FfiBytes32> tracked;
+        TxJournal journal([&](const FfiBytes32& hash) { tracked.push_back(hash); });
+        LOGOS_ASSERT_TRUE(journal.open(file.path));
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(0xa1), filled(0xa2)}, amount, filled(0x01), 42));
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("vault_claim", {filled(0xa1)}, nullptr, filled(0x02), 43));
+        // The same hash is journaled once.
+        LOGOS_ASSERT_FALSE(journal.recordSubmission("vault_claim", {filled(0xa1)}, nullptr, filled(0x02), 43));
+        LOGOS_ASSERT_TRUE(journal.recordStatus(filled(0x01), TxJournal::Status::Confirmed));
+        LOGOS_ASSERT_FALSE(journal.recordStatus(filled(0x01), TxJournal::Status::Confirmed));
+        LOGOS_ASSERT_FALSE(journal.recordStatus(filled(0x03), TxJournal::Status::Confirmed));
+        LOGOS_ASSERT_EQ(tracked.size(), size_t{2});
+    }
+
+    std::vector<FfiBytes32> tracked;
+    TxJournal journal([&](const FfiBytes32& hash) { tracked.push_back(hash); });
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    LOGOS_ASSERT_EQ(journal.size(), size_t{2});
+    // Only the transaction still pending is tracked again.
+    LOGOS_ASSERT_EQ(tracked.size(), size_t{1});
+    LOGOS_ASSERT_EQ(tracked[0].data[0], 0x02);
+
+    const std::vector<TxJournal::Entry> all = journal.query(nullptr, std::nullopt, 10);
+    LOGOS_ASSERT_EQ(all.size(), size_t{2});
+    LOGOS_ASSERT_EQ(all[0].sequence, uint64_t{2});
+    LOGOS_ASSERT_EQ(all[0].method, std::string("vault_claim"));
+    LOGOS_ASSERT_FALSE(all[0].hasAmount);
+    LOGOS_ASSERT_TRUE(all[0].status == TxJournal::Status::Pending);
+    LOGOS_ASSERT_EQ(all[1].method, std::string("transfer_public"));
+    LOGOS_ASSERT_EQ(all[1].accounts.size(), size_t{2});
+    LOGOS_ASSERT_EQ(all[1].accounts[1].data[0], 0xa2);
+    LOGOS_ASSERT_TRUE(all[1].hasAmount);
+    LOGOS_ASSERT_EQ(all[1].amount[0], 5);
+    LOGOS_ASSERT_EQ(all[1].submitBlock, uint64_t{42});
+    LOGOS_ASSERT_TRUE(all[1].status == TxJournal::Status::Confirmed);
+    LOGOS_ASSERT_GT(all[1].submittedAtMs, int64_t{0});
+}
+
+LOGOS_TEST(tx_journal_queries_by_account_and_status) {
+    TempJournalPath file;
+    TxJournal journal([](const FfiBytes32&) {});
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    for (uint8_t i = 1; i <= 6; ++i)
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(i % 2 ? 0xa1 : 0xb1)}, nullptr, filled(i), i));
+    LOGOS_ASSERT_TRUE(journal.recordStatus(filled(5), TxJournal::Status::TimedOut));
+
+    const FfiBytes32 odd = filled(0xa1);
+    const std::vector<TxJournal::Entry> byAccount = journal.query(&odd, std::nullopt, 2);
+    LOGOS_ASSERT_EQ(byAccount.size(), size_t{2});
+    LOGOS_ASSERT_EQ(byAccount[0].txHash.data[0], 5);
+    LOGOS_ASSERT_EQ(byAccount[1].txHash.data[0], 3);
+
+    const std::vector<TxJournal::Entry> pendingOdd = journal.query(&odd, TxJournal::Status::Pending, 10);
+    LOGOS_ASSERT_EQ(pendingOdd.size(), size_t{2});
+    LOGOS_ASSERT_EQ(pendingOdd[0].txHash.data[0], 3);
+
+    LOGOS_ASSERT_EQ(journal.query(nullptr, TxJournal::Status::TimedOut, 10).size(), size_t{1});
+    LOGOS_ASSERT_EQ(journal.query(nullptr, TxJournal::Status::Pending, 10).size(), size_t{5});
+    const FfiBytes32 unknown = filled(0xcc);
+    LOGOS_ASSERT_TRUE(journal.query(&unknown, std::nullopt, 10).empty());
+}
+
+LOGOS_TEST(tx_journal_replay_stops_at_a_torn_record) {
+    TempJournalPath file;
+    {
+        TxJournal journal([](const FfiBytes32&) {});
+        LOGOS_ASSERT_TRUE(journal.open(file.path));
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x01), 1));
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x02), 2));
+    }
+
+    // Corrupt the second record as a crash mid-append would.
+    FILE* f = fopen(file.path.c_str(), "r+b");
+    LOGOS_ASSERT_TRUE(f != nullptr);
+    fseek(f, static_cast<long>(2 * TxJournal::RecordSize + 100), SEEK_SET);
+    fputc(0xff, f);
+    fclose(f);
+
+    TxJournal journal([](const FfiBytes32&) {});
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    LOGOS_ASSERT_EQ(journal.size(), size_t{1});
+    // The torn slot is reused by the next append.
+    LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, filled(0x03), 3));
+    journal.close();
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    LOGOS_ASSERT_EQ(journal.size(), size_t{2});
+}
+
+LOGOS_TEST(tx_journal_rejects_foreign_files_and_closed_appends) {
+    TempJournalPath file;
+    FILE* f = fopen(file.path.c_str(), "wb");
+    LOGOS_ASSERT_TRUE(f != nullptr);
+    fputs("definitely not a journal", f);
+    fclose(f);
+
+    TxJournal journal([](const FfiBytes32&) {});
+    LOGOS_ASSERT_FALSE(journal.open(file.path));
+    LOGOS_ASSERT_FALSE(journal.isOpen());
+    LOGOS_ASSERT_FALSE(journal.recordSubmission("transfer_public", {}, nullptr, filled(0x01), 1));
+}
+
+LOGOS_TEST(tx_journal_grows_past_the_initial_mapping) {
+    TempJournalPath file;
+    TxJournal journal([](const FfiBytes32&) {});
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    const size_t count = TxJournal::GrowRecords + 10;
+    for (size_t i = 0; i < count; ++i) {
+        FfiBytes32 hash{};
+        for (size_t b = 0; b < 8; ++b)
+            hash.data[b] = static_cast<uint8_t>(i >> (8 * b));
+        hash.data[31] = 1;
+        LOGOS_ASSERT_TRUE(journal.recordSubmission("transfer_public", {filled(0xa1)}, nullptr, hash, i));
+    }
+    journal.close();
+    LOGOS_ASSERT_TRUE(journal.open(file.path));
+    LOGOS_ASSERT_EQ(journal.size(), count);
+}
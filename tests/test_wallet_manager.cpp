@@ -0,0 +1,111 @@
+// Unit tests for WalletManager: LRU eviction with a save first, pinning by leases, save
+// failures and the lifecycle of a wallet id. wallet_ffi is the mock; every wallet it
+// opens shares one fake handle, so the tests count calls rather than compare handles.
+
+#include <logos_test.h>
+#include "wallet_manager.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+static int snapshotInt(const WalletManager& manager, const char* key) {
+    return manager.snapshot()[key].get<int>();
+}
+
+LOGOS_TEST(wallet_manager_evicts_least_recently_used) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    WalletManager manager(2);
+
+    LOGOS_ASSERT_EQ(manager.add("a", "/cfg", "/a", "/stats"), SUCCESS);
+    LOGOS_ASSERT_EQ(manager.add("b", "/cfg", "/b", "/stats"), SUCCESS);
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_save"));
+    LOGOS_ASSERT_EQ(manager.add("c", "/cfg", "/c", "/stats"), SUCCESS);
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_save"));
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "open"), 2);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "evictions"), 1);
+
+    // "a" was evicted and comes back; "b" is now the least recently used.
+    LOGOS_ASSERT_TRUE(static_cast<bool>(manager.acquire("a")));
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "opens"), 4);
+    LOGOS_ASSERT_TRUE(static_cast<bool>(manager.acquire("c")));
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "opens"), 4);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "evictions"), 2);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "registered"), 3);
+}
+
+LOGOS_TEST(wallet_manager_never_evicts_leased_wallet) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    WalletManager manager(1);
+
+    manager.add("a", "/cfg", "/a", "/stats");
+    auto lease = std::make_unique<WalletManager::Lease>(manager.acquire("a"));
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "leased"), 1);
+    manager.add("b", "/cfg", "/b", "/stats");
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "open"), 2);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "evictions"), 0);
+
+    lease.reset();
+    manager.setMaxOpen(1);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "open"), 1);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "evictions"), 1);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "leased"), 0);
+}
+
+LOGOS_TEST(wallet_manager_keeps_wallet_open_when_save_fails) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    t.mockCFunction("wallet_ffi_save").returns(static_cast<int>(INTERNAL_ERROR));
+    WalletManager manager(1);
+
+    manager.add("a", "/cfg", "/a", "/stats");
+    manager.add("b", "/cfg", "/b", "/stats");
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "open"), 2);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "save_failures"), 1);
+    LOGOS_ASSERT_FALSE(t.cFunctionCalled("wallet_ffi_destroy"));
+
+    LOGOS_ASSERT_EQ(manager.remove("a"), INTERNAL_ERROR);
+    LOGOS_ASSERT_TRUE(static_cast<bool>(manager.acquire("a")));
+
+    t.mockCFunction("wallet_ffi_save").returns(static_cast<int>(SUCCESS));
+    LOGOS_ASSERT_EQ(manager.remove("a"), SUCCESS);
+    LOGOS_ASSERT(t.cFunctionCalled("wallet_ffi_destroy"));
+    LOGOS_ASSERT_FALSE(static_cast<bool>(manager.acquire("a")));
+}
+
+LOGOS_TEST(wallet_manager_rejects_duplicate_unknown_and_unopenable_ids) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    WalletManager manager;
+
+    LOGOS_ASSERT_EQ(manager.add("a", "/cfg", "/a", "/stats"), SUCCESS);
+    LOGOS_ASSERT_EQ(manager.add("a", "/cfg", "/a", "/stats"), INTERNAL_ERROR);
+    LOGOS_ASSERT_FALSE(static_cast<bool>(manager.acquire("nope")));
+    LOGOS_ASSERT_EQ(manager.remove("nope"), INTERNAL_ERROR);
+
+    t.mockCFunction("wallet_ffi_open").returns(0);
+    LOGOS_ASSERT_EQ(manager.add("b", "/cfg", "/b", "/stats"), INTERNAL_ERROR);
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "registered"), 1);
+}
+
+LOGOS_TEST(wallet_manager_remove_waits_for_running_calls) {
+    auto t = LogosTestContext("logos_execution_zone");
+    t.mockCFunction("wallet_ffi_open").returns(1);
+    WalletManager manager;
+    manager.add("a", "/cfg", "/a", "/stats");
+
+    auto lease = std::make_unique<WalletManager::Lease>(manager.acquire("a"));
+    std::thread remover([&] { LOGOS_ASSERT_EQ(manager.remove("a"), SUCCESS); });
+    // Once the removal is waiting, new calls are turned away.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (manager.acquire("a") && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    LOGOS_ASSERT_FALSE(static_cast<bool>(manager.acquire("a")));
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "registered"), 1);
+
+    lease.reset();
+    remover.join();
+    LOGOS_ASSERT_EQ(snapshotInt(manager, "registered"), 0);
+}